@@ -0,0 +1,368 @@
+#include "ArmatureFile.h"
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		const char magic[8] = { 'A', 'J', 'A', 'R', 'M', 'A', 'T', 'R' };
+		const uint32_t version = 1;
+
+		struct Header {
+			char magic[8];
+			uint32_t version;
+			uint32_t count;
+			uint32_t recordSize;
+			uint32_t cellSize;
+			uint32_t cellCount;
+			uint32_t cellsOffset;
+			uint32_t byNameOffset;
+			uint32_t namesOffset;
+			uint32_t namesSize;
+			uint32_t reserved;
+			uint64_t hash;
+		};
+
+		const char* const cellTypes[] = { ARMATURE_JOINT_OPTION_NONE, ARMATURE_JOINT_OPTION_BALL, ARMATURE_JOINT_OPTION_NUT };
+		const uint32_t cellTypeCount = sizeof(cellTypes) / sizeof(cellTypes[0]);
+
+		const uint64_t fnvOffset = 14695981039346656037ull;
+		const uint64_t fnvPrime = 1099511628211ull;
+		const double quantum = 1e-7;
+
+		void hashBytes(uint64_t& hash, const void* data, size_t size) {
+			auto bytes = (const unsigned char*)data;
+			for (size_t i = 0; i < size; i++) {
+				hash ^= bytes[i];
+				hash *= fnvPrime;
+			}
+		}
+
+		void hashInteger(uint64_t& hash, int64_t value) {
+			unsigned char bytes[8];
+			for (auto i = 0; i < 8; i++)
+				bytes[i] = (unsigned char)((uint64_t)value >> (i * 8));
+			hashBytes(hash, bytes, sizeof(bytes));
+		}
+
+		// Values llround cannot take, not numbers or too large for 64 bits, are hashed by their bits instead.
+		void hashValue(uint64_t& hash, double value) {
+			auto quantised = value / quantum;
+			if (fabs(quantised) < 9e18)
+				hashInteger(hash, llround(quantised));
+			else
+				hashBytes(hash, &value, sizeof(value));
+		}
+
+		bool cellType(const std::string& type, uint32_t& index) {
+			for (index = 0; index < cellTypeCount; index++) {
+				if (type == cellTypes[index])
+					return true;
+			}
+			return false;
+		}
+	}
+
+	ArmatureFile::ArmatureFile() : records(nullptr), cellData(nullptr), byName(nullptr), names(nullptr), namesSize(0), cellCount(0), count(0), _hash(0) {
+	}
+
+	std::shared_ptr<ArmatureFile> ArmatureFile::open(const std::string& path) {
+		auto armature = std::shared_ptr<ArmatureFile>(new ArmatureFile());
+		armature->file = MappedFile::open(path);
+		if (!armature->file || armature->file->size() < sizeof(Header))
+			return nullptr;
+
+		auto data = armature->file->data();
+
+		// The header, the section bounds and the name index are checked here; each record's cells are checked when it
+		// is read.
+		auto header = (const Header*)data;
+		if (memcmp(header->magic, magic, sizeof(magic)) != 0 || header->version != version)
+			return nullptr;
+
+		if (header->recordSize != sizeof(ArmatureRecord) || header->cellSize != sizeof(ArmatureCell))
+			return nullptr;
+
+		auto recordsEnd = sizeof(Header) + ((size_t)header->count * sizeof(ArmatureRecord));
+		if (header->cellsOffset < recordsEnd || header->cellsOffset % sizeof(double) != 0)
+			return nullptr;
+
+		if (header->cellsOffset + ((size_t)header->cellCount * sizeof(ArmatureCell)) > header->byNameOffset)
+			return nullptr;
+
+		if (header->byNameOffset + ((size_t)header->count * sizeof(uint32_t)) > header->namesOffset)
+			return nullptr;
+
+		if ((size_t)header->namesOffset + header->namesSize > armature->file->size())
+			return nullptr;
+
+		// diff() walks the name index without rechecking it, so an entry past the records rejects the whole file.
+		auto byName = (const uint32_t*)(data + header->byNameOffset);
+		for (size_t i = 0; i < header->count; i++) {
+			if (byName[i] >= header->count)
+				return nullptr;
+		}
+
+		armature->count = header->count;
+		armature->cellCount = header->cellCount;
+		armature->records = (const ArmatureRecord*)(data + sizeof(Header));
+		armature->cellData = (const ArmatureCell*)(data + header->cellsOffset);
+		armature->byName = byName;
+		armature->names = data + header->namesOffset;
+		armature->namesSize = header->namesSize;
+		armature->_hash = header->hash;
+
+		return armature;
+	}
+
+	bool ArmatureFile::write(const std::string& path, const std::vector<JointSpec>& specs, std::string& error) {
+		std::vector<uint32_t> byName(specs.size());
+		for (size_t i = 0; i < byName.size(); i++)
+			byName[i] = (uint32_t)i;
+		std::sort(byName.begin(), byName.end(), [&](uint32_t a, uint32_t b) { return specs[a].name < specs[b].name; });
+
+		for (size_t i = 1; i < byName.size(); i++) {
+			if (specs[byName[i]].name == specs[byName[i - 1]].name) {
+				error = "more than one joint is named '" + specs[byName[i]].name + "'";
+				return false;
+			}
+		}
+
+		std::vector<ArmatureRecord> records(specs.size());
+		std::vector<ArmatureCell> cells;
+		std::string names;
+
+		for (size_t i = 0; i < specs.size(); i++) {
+			auto& spec = specs[i];
+			auto& record = records[i];
+			memset(&record, 0, sizeof(record));
+
+			if (spec.rows < 1 || spec.cols < 1 || spec.cells.size() != (size_t)spec.rows * spec.cols) {
+				error = spec.name + ": the cell grid does not match its rows and cols";
+				return false;
+			}
+
+			record.nameOffset = (uint32_t)names.size();
+			record.nameLength = (uint32_t)spec.name.size();
+			record.rows = spec.rows;
+			record.cols = spec.cols;
+			record.firstCell = (uint32_t)cells.size();
+			record.length = spec.length;
+			record.width = spec.width;
+			record.thickness = spec.thickness;
+			record.ballDiameter = spec.ballDiameter;
+			record.boltHoleDiameter = spec.boltHoleDiameter;
+			std::copy(spec.transform.begin(), spec.transform.end(), record.transform);
+			record.parametersHash = parametersHash(spec);
+			record.placementHash = placementHash(spec);
+			names += spec.name;
+
+			for (auto& cell : spec.cells) {
+				ArmatureCell stored;
+				memset(&stored, 0, sizeof(stored));
+				if (!cellType(cell.type, stored.type)) {
+					error = spec.name + ": unknown joint type '" + cell.type + "'";
+					return false;
+				}
+
+				stored.holeDiameter = cell.holeDiameter;
+				cells.push_back(stored);
+			}
+		}
+
+		// Joints are hashed in name order, so files listing the same joints in a different order are equal.
+		auto hash = fnvOffset;
+		for (auto i : byName) {
+			hashBytes(hash, specs[i].name.c_str(), specs[i].name.size() + 1);
+			hashInteger(hash, (int64_t)records[i].parametersHash);
+			hashInteger(hash, (int64_t)records[i].placementHash);
+		}
+
+		Header header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, magic, sizeof(magic));
+		header.version = version;
+		header.count = (uint32_t)records.size();
+		header.recordSize = sizeof(ArmatureRecord);
+		header.cellSize = sizeof(ArmatureCell);
+		header.cellCount = (uint32_t)cells.size();
+		header.cellsOffset = (uint32_t)(sizeof(Header) + (records.size() * sizeof(ArmatureRecord)));
+		header.byNameOffset = (uint32_t)(header.cellsOffset + (cells.size() * sizeof(ArmatureCell)));
+		header.namesOffset = (uint32_t)(header.byNameOffset + (byName.size() * sizeof(uint32_t)));
+		header.namesSize = (uint32_t)names.size();
+		header.hash = hash;
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			error = "could not open " + path;
+			return false;
+		}
+
+		file.write((const char*)&header, sizeof(header));
+		file.write((const char*)records.data(), records.size() * sizeof(ArmatureRecord));
+		file.write((const char*)cells.data(), cells.size() * sizeof(ArmatureCell));
+		file.write((const char*)byName.data(), byName.size() * sizeof(uint32_t));
+		file.write(names.data(), names.size());
+		file.close();
+
+		if (file.fail()) {
+			error = "could not write " + path;
+			return false;
+		}
+
+		return true;
+	}
+
+	uint64_t ArmatureFile::parametersHash(const JointSpec& spec) {
+		auto hash = fnvOffset;
+		hashValue(hash, spec.length);
+		hashValue(hash, spec.width);
+		hashValue(hash, spec.thickness);
+		hashValue(hash, spec.ballDiameter);
+		hashValue(hash, spec.boltHoleDiameter);
+		hashInteger(hash, spec.rows);
+		hashInteger(hash, spec.cols);
+		for (auto& cell : spec.cells) {
+			hashBytes(hash, cell.type.c_str(), cell.type.size() + 1);
+			hashValue(hash, cell.holeDiameter);
+		}
+		return hash;
+	}
+
+	uint64_t ArmatureFile::placementHash(const JointSpec& spec) {
+		auto hash = fnvOffset;
+		for (auto v : spec.transform)
+			hashValue(hash, v);
+		return hash;
+	}
+
+	std::vector<ArmatureChange> ArmatureFile::diff(const ArmatureFile& from, const ArmatureFile& to) {
+		std::vector<ArmatureChange> changes;
+		if (from.hash() == to.hash() && from.size() == to.size())
+			return changes;
+
+		size_t i = 0;
+		size_t j = 0;
+		while (i < from.count || j < to.count) {
+			auto order = i == from.count ? 1 : j == to.count ? -1 : from.compareNames(from.byName[i], to, to.byName[j]);
+			if (order < 0) {
+				changes.push_back({ ArmatureChange::Removed, from.name(from.byName[i++]) });
+				continue;
+			}
+			if (order > 0) {
+				changes.push_back({ ArmatureChange::Added, to.name(to.byName[j++]) });
+				continue;
+			}
+
+			auto& before = from.record(from.byName[i]);
+			auto& after = to.record(to.byName[j]);
+			if (before.parametersHash != after.parametersHash)
+				changes.push_back({ ArmatureChange::Resized, to.name(to.byName[j]) });
+			if (before.placementHash != after.placementHash)
+				changes.push_back({ ArmatureChange::Moved, to.name(to.byName[j]) });
+			i++;
+			j++;
+		}
+
+		return changes;
+	}
+
+	size_t ArmatureFile::size() const {
+		return count;
+	}
+
+	uint64_t ArmatureFile::hash() const {
+		return _hash;
+	}
+
+	std::string ArmatureFile::name(size_t index) const {
+		auto& record = records[index];
+		if ((size_t)record.nameOffset + record.nameLength > namesSize)
+			return "";
+
+		return std::string(names + record.nameOffset, record.nameLength);
+	}
+
+	// Compares names in place, in the same byte order std::string sorts them in when the file is written.
+	int ArmatureFile::compareNames(uint32_t a, const ArmatureFile& other, uint32_t b) const {
+		auto& left = records[a];
+		auto& right = other.records[b];
+		auto leftLength = (size_t)left.nameOffset + left.nameLength <= namesSize ? left.nameLength : 0;
+		auto rightLength = (size_t)right.nameOffset + right.nameLength <= other.namesSize ? right.nameLength : 0;
+
+		auto order = memcmp(names + left.nameOffset, other.names + right.nameOffset, std::min(leftLength, rightLength));
+		if (order != 0)
+			return order;
+
+		return leftLength < rightLength ? -1 : leftLength > rightLength ? 1 : 0;
+	}
+
+	const ArmatureRecord& ArmatureFile::record(size_t index) const {
+		return records[index];
+	}
+
+	const ArmatureCell* ArmatureFile::cells(size_t index) const {
+		auto& record = records[index];
+		if (record.rows < 1 || record.cols < 1 || (size_t)record.firstCell + ((size_t)record.rows * record.cols) > cellCount)
+			return nullptr;
+
+		return cellData + record.firstCell;
+	}
+
+	bool ArmatureFile::spec(size_t index, JointSpec& spec) const {
+		auto& record = records[index];
+		auto grid = cells(index);
+		if (!grid)
+			return false;
+
+		spec = JointSpec();
+		spec.name = name(index);
+		spec.length = record.length;
+		spec.width = record.width;
+		spec.thickness = record.thickness;
+		spec.ballDiameter = record.ballDiameter;
+		spec.boltHoleDiameter = record.boltHoleDiameter;
+		std::copy(record.transform, record.transform + 16, spec.transform.begin());
+
+		JointCell none = { ARMATURE_JOINT_OPTION_NONE, 0 };
+		spec.resize(record.rows, record.cols, none);
+		for (size_t i = 0; i < spec.cells.size(); i++) {
+			if (grid[i].type >= cellTypeCount)
+				return false;
+
+			spec.cells[i].type = cellTypes[grid[i].type];
+			spec.cells[i].holeDiameter = grid[i].holeDiameter;
+		}
+
+		return true;
+	}
+
+	bool ArmatureFile::specs(std::vector<JointSpec>& specs, std::string& error) const {
+		for (size_t i = 0; i < count; i++) {
+			JointSpec spec;
+			if (!this->spec(i, spec)) {
+				error = "joint " + std::to_string(i + 1) + " is damaged";
+				return false;
+			}
+			specs.push_back(spec);
+		}
+		return true;
+	}
+
+	bool ArmatureFile::find(const std::string& name, size_t& index) const {
+		auto compare = [&](uint32_t i, const std::string& key) {
+			return i < count && this->name(i) < key;
+		};
+
+		auto found = std::lower_bound(byName, byName + count, name, compare);
+		if (found == byName + count || *found >= count || this->name(*found) != name)
+			return false;
+
+		index = *found;
+		return true;
+	}
+}
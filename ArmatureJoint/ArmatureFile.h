@@ -0,0 +1,85 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "JointSpec.h"
+#include "MappedFile.h"
+
+namespace ArmatureJoint {
+	// One joint as stored in the file, in centimetres. Its cells are cellCount consecutive entries from firstCell, row
+	// major. The hashes cover the spec without its name and the placement separately, so a diff tells a resized joint
+	// from one that was only moved.
+	struct ArmatureRecord {
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		int32_t rows;
+		int32_t cols;
+		uint32_t firstCell;
+		uint32_t reserved;
+		double length;
+		double width;
+		double thickness;
+		double ballDiameter;
+		double boltHoleDiameter;
+		double transform[16];
+		uint64_t parametersHash;
+		uint64_t placementHash;
+	};
+
+	struct ArmatureCell {
+		uint32_t type; // 0 None, 1 Ball, 2 Nut
+		uint32_t reserved;
+		double holeDiameter;
+	};
+
+	struct ArmatureChange {
+		enum Kind { Added, Removed, Resized, Moved };
+
+		Kind kind;
+		std::string name;
+	};
+
+	// A whole armature in one flat file: a header, the joint records, every cell grid back to back, the record indices
+	// sorted by name, then the names. Open only checks the name index; records are read in place from the mapped file.
+	// Joint names are unique within a file, which is what diffs match joints by. Values are little endian.
+	class ArmatureFile {
+	public:
+		static std::shared_ptr<ArmatureFile> open(const std::string& path);
+		static bool write(const std::string& path, const std::vector<JointSpec>& specs, std::string& error);
+
+		// FNV-1a over values rounded to the nanometre, so a round trip through text does not show up as a change.
+		static uint64_t parametersHash(const JointSpec& spec);
+		static uint64_t placementHash(const JointSpec& spec);
+
+		// Joints added, removed, resized or moved going from one file to the other, in name order. Files with the same
+		// hash are equal without looking at their joints, and otherwise only the two hashes of each joint are compared.
+		static std::vector<ArmatureChange> diff(const ArmatureFile& from, const ArmatureFile& to);
+
+		size_t size() const;
+		uint64_t hash() const;
+		std::string name(size_t index) const;
+		const ArmatureRecord& record(size_t index) const;
+		const ArmatureCell* cells(size_t index) const;
+		bool spec(size_t index, JointSpec& spec) const;
+		bool specs(std::vector<JointSpec>& specs, std::string& error) const;
+		bool find(const std::string& name, size_t& index) const;
+
+	private:
+		ArmatureFile();
+
+		int compareNames(uint32_t a, const ArmatureFile& other, uint32_t b) const;
+
+		std::unique_ptr<MappedFile> file;
+		const ArmatureRecord* records;
+		const ArmatureCell* cellData;
+		const uint32_t* byName;
+		const char* names;
+		size_t namesSize;
+		size_t cellCount;
+		size_t count;
+		uint64_t _hash;
+	};
+}
@@ -0,0 +1,54 @@
+#include "BatchCommandCreated.h"
+
+#include "UI.h"
+#include "Values.h"
+
+namespace ArmatureJoint {
+	void BatchCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto ui = app->userInterface();
+		if (!ui)
+			return;
+
+		_onExecute->specs.clear();
+
+		// The whole file is generated in a single execute, so there is no dialog to show.
+		cmd->isAutoExecute(true);
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+
+		auto fileDialog = ui->createFileDialog();
+		if (!fileDialog)
+			return;
+
+		fileDialog->title("Select Joint Specification File");
+		fileDialog->filter(ARMATURE_JOINT_BATCH_FILE_FILTER);
+		fileDialog->isMultiSelectEnabled(false);
+
+		if (fileDialog->showOpen() != DialogResults::DialogOK)
+			return;
+
+		std::string error;
+		if (!JointSpecFile::read(fileDialog->filename(), Values::defaultSpec(), Values::defaultCell(), _onExecute->specs, error)) {
+			_onExecute->specs.clear();
+			ui->messageBox(error, "Armature Joints From File");
+		}
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "BatchCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class BatchCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<BatchCommandExecuted> _onExecute;
+
+	public:
+		BatchCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<BatchCommandExecuted>(new BatchCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
@@ -0,0 +1,34 @@
+#include "BatchCommandExecuted.h"
+
+#include "JointBuilder.h"
+
+namespace ArmatureJoint {
+	void BatchCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		if (specs.empty())
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto builder = JointBuilder::create(design);
+		if (!builder)
+			return;
+
+		auto failed = builder->build(specs);
+		specs.clear();
+
+		if (!failed.empty()) {
+			auto ui = app->userInterface();
+			if (ui)
+				ui->messageBox("These joints could not be generated:" + failed, "Armature Joints From File");
+		}
+	}
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+#include <vector>
+
+#include "JointSpec.h"
+
+using namespace std;
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace ArmatureJoint {
+	class BatchCommandExecuted : public CommandEventHandler {
+	private:
+		Ptr<Application> app;
+	public:
+		BatchCommandExecuted(Ptr<Application> _app) {
+			app = _app;
+		}
+
+		vector<JointSpec> specs;
+
+		void notify(const Ptr<CommandEventArgs>& eventArgs) override;
+	};
+}
@@ -0,0 +1,74 @@
+#include "BulkCommandCreated.h"
+
+#include "JointAttributes.h"
+#include "UI.h"
+#include "Values.h"
+
+namespace ArmatureJoint {
+	namespace {
+		bool addChange(Ptr<CommandInputs> inputs, const char* checkID, const char* checkName, const char* valueID, const char* valueName, double value) {
+			auto check = inputs->addBoolValueInput(checkID, checkName, true, "", false);
+			if (!check)
+				return false;
+
+			auto distance = inputs->addDistanceValueCommandInput(valueID, valueName, ValueInput::createByReal(value));
+			if (!distance)
+				return false;
+
+			return true;
+		}
+	}
+
+	void BulkCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto inputs = cmd->commandInputs();
+		if (!inputs)
+			return;
+
+		auto joints = JointAttributes::joints(design);
+
+		auto summary = inputs->addTextBoxCommandInput(
+			ARMATURE_JOINT_BULK_SUMMARY_INPUT_ID,
+			"Joints",
+			std::to_string(joints.size()) + " armature joints in this design",
+			1,
+			true
+		);
+		if (!summary)
+			return;
+
+		if (!addChange(inputs, ARMATURE_JOINT_BULK_MATCH_BALL_INPUT_ID, "Only Joints With Ball", ARMATURE_JOINT_BULK_MATCH_BALL_DIAMETER_INPUT_ID, "Current Ball Diameter", Values::defaultBallDiameter()))
+			return;
+
+		if (!addChange(inputs, ARMATURE_JOINT_BULK_CHANGE_BALL_INPUT_ID, "Change Ball Diameter", ARMATURE_JOINT_BULK_BALL_DIAMETER_INPUT_ID, "Ball Diameter", Values::defaultBallDiameter()))
+			return;
+
+		if (!addChange(inputs, ARMATURE_JOINT_BULK_CHANGE_THICKNESS_INPUT_ID, "Change Plate Thickness", ARMATURE_JOINT_BULK_THICKNESS_INPUT_ID, "Plate Thickness", Values::defaultThickness()))
+			return;
+
+		if (!addChange(inputs, ARMATURE_JOINT_BULK_CHANGE_BOLT_HOLE_INPUT_ID, "Change Bolt Hole", ARMATURE_JOINT_BULK_BOLT_HOLE_DIAMETER_INPUT_ID, "Bolt Hole Diameter", Values::defaultBoltHoleDiameter()))
+			return;
+
+		if (!addChange(inputs, ARMATURE_JOINT_BULK_CHANGE_HOLE_INPUT_ID, "Change Ball Hole", ARMATURE_JOINT_BULK_HOLE_DIAMETER_INPUT_ID, "Hole Diameter", Values::defaultHoleDiameter()))
+			return;
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "BulkCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class BulkCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<BulkCommandExecuted> _onExecute;
+
+	public:
+		BulkCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<BulkCommandExecuted>(new BulkCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
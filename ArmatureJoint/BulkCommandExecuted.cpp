@@ -0,0 +1,89 @@
+#include "BulkCommandExecuted.h"
+
+#include "DeferredCompute.h"
+#include "JointAttributes.h"
+#include "JointEditor.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		void readChange(Ptr<CommandInputs> inputs, const char* checkID, const char* valueID, bool& enabled, double& value) {
+			auto check = static_cast<Ptr<BoolValueCommandInput>>(inputs->itemById(checkID));
+			auto distance = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(valueID));
+
+			enabled = check && distance && check->value();
+			value = distance ? distance->value() : 0;
+		}
+	}
+
+	JointChange BulkCommandExecuted::change(Ptr<CommandInputs> inputs) {
+		JointChange change;
+		if (!inputs)
+			return change;
+
+		readChange(inputs, ARMATURE_JOINT_BULK_MATCH_BALL_INPUT_ID, ARMATURE_JOINT_BULK_MATCH_BALL_DIAMETER_INPUT_ID, change.matchBallDiameter, change.matchedBallDiameter);
+		readChange(inputs, ARMATURE_JOINT_BULK_CHANGE_BALL_INPUT_ID, ARMATURE_JOINT_BULK_BALL_DIAMETER_INPUT_ID, change.changeBallDiameter, change.ballDiameter);
+		readChange(inputs, ARMATURE_JOINT_BULK_CHANGE_THICKNESS_INPUT_ID, ARMATURE_JOINT_BULK_THICKNESS_INPUT_ID, change.changeThickness, change.thickness);
+		readChange(inputs, ARMATURE_JOINT_BULK_CHANGE_BOLT_HOLE_INPUT_ID, ARMATURE_JOINT_BULK_BOLT_HOLE_DIAMETER_INPUT_ID, change.changeBoltHoleDiameter, change.boltHoleDiameter);
+		readChange(inputs, ARMATURE_JOINT_BULK_CHANGE_HOLE_INPUT_ID, ARMATURE_JOINT_BULK_HOLE_DIAMETER_INPUT_ID, change.changeHoleDiameter, change.holeDiameter);
+
+		return change;
+	}
+
+	void BulkCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto command = eventArgs->command();
+		if (!command)
+			return;
+
+		auto jointChange = change(command->commandInputs());
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto editor = JointEditor::create(design);
+		if (!editor)
+			return;
+
+		// Collect the affected joints first so nothing is touched unless there is work to do.
+		vector<pair<Ptr<Component>, shared_ptr<Values>>> affected;
+		for (auto& component : JointAttributes::joints(design)) {
+			JointSpec spec;
+			if (!JointAttributes::readSpec(component, spec))
+				continue;
+
+			if (!jointChange.apply(spec))
+				continue;
+
+			auto values = Values::create(spec);
+			if (values)
+				affected.push_back(make_pair(component, values));
+		}
+
+		if (affected.empty())
+			return;
+
+		// Every joint is edited with compute deferred, so the design recomputes once at the end.
+		std::string failed;
+		{
+			DeferredDesignCompute deferred(design);
+			for (auto& joint : affected) {
+				if (!editor->update(joint.first, joint.second))
+					failed += "\n" + joint.second->name() + (editor->rejection().empty() ? "" : ": " + editor->rejection());
+			}
+		}
+
+		if (!failed.empty()) {
+			auto ui = app->userInterface();
+			if (ui)
+				ui->messageBox("These joints could not be updated:" + failed, "Resize Armature Joints");
+		}
+	}
+}
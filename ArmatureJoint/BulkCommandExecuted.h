@@ -0,0 +1,25 @@
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+#include "JointSpec.h"
+
+using namespace std;
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace ArmatureJoint {
+	class BulkCommandExecuted : public CommandEventHandler {
+	private:
+		Ptr<Application> app;
+	public:
+		BulkCommandExecuted(Ptr<Application> _app) {
+			app = _app;
+		}
+
+		static JointChange change(Ptr<CommandInputs> inputs);
+
+		void notify(const Ptr<CommandEventArgs>& eventArgs) override;
+	};
+}
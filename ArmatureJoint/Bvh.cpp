@@ -0,0 +1,136 @@
+#include "Bvh.h"
+
+#include <algorithm>
+
+namespace ArmatureJoint {
+	void Bvh::build(const std::vector<Aabb>& bounds) {
+		nodes.clear();
+		leaves.assign(bounds.size(), -1);
+		if (bounds.empty())
+			return;
+
+		nodes.reserve((bounds.size() * 2) - 1);
+
+		std::vector<int> items(bounds.size());
+		for (size_t i = 0; i < items.size(); i++)
+			items[i] = (int)i;
+
+		build(bounds, items, 0, (int)items.size(), -1);
+	}
+
+	// Splits at the median of the widest axis of the item centres, which keeps the tree balanced for any layout.
+	int Bvh::build(const std::vector<Aabb>& bounds, std::vector<int>& items, int begin, int end, int parent) {
+		auto index = (int)nodes.size();
+		nodes.push_back(Node());
+		nodes[index].parent = parent;
+		nodes[index].left = -1;
+		nodes[index].right = -1;
+		nodes[index].item = -1;
+
+		if (end - begin == 1) {
+			nodes[index].bounds = bounds[items[begin]];
+			nodes[index].item = items[begin];
+			leaves[items[begin]] = index;
+			return index;
+		}
+
+		Aabb centres;
+		for (auto i = begin; i < end; i++)
+			centres.add(bounds[items[i]].centre());
+
+		auto size = centres.size();
+		auto axis = size.x > size.y ? (size.x > size.z ? 0 : 2) : (size.y > size.z ? 1 : 2);
+
+		auto middle = begin + ((end - begin) / 2);
+		std::nth_element(items.begin() + begin, items.begin() + middle, items.begin() + end, [&bounds, axis](int a, int b) {
+			return bounds[a].centre()[axis] < bounds[b].centre()[axis];
+		});
+
+		auto left = build(bounds, items, begin, middle, index);
+		auto right = build(bounds, items, middle, end, index);
+
+		nodes[index].left = left;
+		nodes[index].right = right;
+		nodes[index].bounds = nodes[left].bounds;
+		nodes[index].bounds.add(nodes[right].bounds);
+		return index;
+	}
+
+	void Bvh::refit(int item, const Aabb& bounds) {
+		auto node = leaves[item];
+		nodes[node].bounds = bounds;
+
+		for (node = nodes[node].parent; node >= 0; node = nodes[node].parent) {
+			auto& current = nodes[node];
+			current.bounds = nodes[current.left].bounds;
+			current.bounds.add(nodes[current.right].bounds);
+		}
+	}
+
+	bool Bvh::empty() const {
+		return nodes.empty();
+	}
+
+	void Bvh::query(const Aabb& bounds, double range, std::vector<int>& items) const {
+		if (nodes.empty())
+			return;
+
+		std::vector<int> stack(1, 0);
+		while (!stack.empty()) {
+			auto& node = nodes[stack.back()];
+			stack.pop_back();
+
+			if (node.bounds.distance(bounds) > range)
+				continue;
+
+			if (node.item >= 0) {
+				items.push_back(node.item);
+				continue;
+			}
+
+			stack.push_back(node.left);
+			stack.push_back(node.right);
+		}
+	}
+
+	void Bvh::pairs(double range, std::vector<std::pair<int, int>>& items) const {
+		if (!nodes.empty())
+			pairs(0, 0, range, items);
+	}
+
+	// Simultaneous descent of the tree against itself. a == b visits a subtree against itself.
+	void Bvh::pairs(int a, int b, double range, std::vector<std::pair<int, int>>& items) const {
+		auto& nodeA = nodes[a];
+		auto& nodeB = nodes[b];
+
+		if (a == b) {
+			if (nodeA.item >= 0)
+				return;
+
+			pairs(nodeA.left, nodeA.left, range, items);
+			pairs(nodeA.right, nodeA.right, range, items);
+			pairs(nodeA.left, nodeA.right, range, items);
+			return;
+		}
+
+		if (nodeA.bounds.distance(nodeB.bounds) > range)
+			return;
+
+		if (nodeA.item >= 0 && nodeB.item >= 0) {
+			items.push_back(std::make_pair(nodeA.item, nodeB.item));
+			return;
+		}
+
+		// Descend the larger box first so the boxes being compared stay similar in size.
+		auto sizeA = nodeA.bounds.size();
+		auto sizeB = nodeB.bounds.size();
+		if (nodeB.item >= 0 || (nodeA.item < 0 && sizeA.lengthSquared() >= sizeB.lengthSquared())) {
+			pairs(nodeA.left, b, range, items);
+			pairs(nodeA.right, b, range, items);
+		}
+		else {
+			pairs(a, nodeB.left, range, items);
+			pairs(a, nodeB.right, range, items);
+		}
+	}
+}
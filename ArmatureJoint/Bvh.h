@@ -0,0 +1,39 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "Geometry.h"
+
+namespace ArmatureJoint {
+	// Bounding volume hierarchy over a fixed set of items, one item per leaf. Moving items are handled by refitting
+	// the boxes on the path from their leaf to the root rather than rebuilding.
+	class Bvh {
+	public:
+		void build(const std::vector<Aabb>& bounds);
+		void refit(int item, const Aabb& bounds);
+
+		// Items whose box is within range of the given box.
+		void query(const Aabb& bounds, double range, std::vector<int>& items) const;
+
+		// Pairs of items whose boxes are within range of each other, each pair reported once.
+		void pairs(double range, std::vector<std::pair<int, int>>& items) const;
+
+		bool empty() const;
+
+	private:
+		struct Node {
+			Aabb bounds;
+			int parent;
+			int left;
+			int right;
+			int item; // -1 for inner nodes
+		};
+
+		std::vector<Node> nodes;
+		std::vector<int> leaves; // leaf node of each item
+
+		int build(const std::vector<Aabb>& bounds, std::vector<int>& items, int begin, int end, int parent);
+		void pairs(int a, int b, double range, std::vector<std::pair<int, int>>& items) const;
+	};
+}
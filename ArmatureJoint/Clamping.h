@@ -0,0 +1,74 @@
+#pragma once
+
+#include <stddef.h>
+#include <vector>
+
+#include "JointSpec.h"
+
+namespace ArmatureJoint {
+	// How the bolt is done up, and what it and the seats are made of. Torque in newton metres, modulus in newtons per
+	// square millimetre.
+	struct ClampingSpec {
+		double boltTorque;
+		double nutFactor;
+		double friction;
+		double boltModulus;
+
+		static ClampingSpec defaults();
+	};
+
+	// What one joint holds. The bolt preload is shared evenly between the balls, and each ball is pinched between the
+	// chamfered seats of both plates. Tilt is the torque to swing a ball about an axis across its seats, as posing a
+	// limb does; twist is about the bolt's axis. Settlement is how much tilt torque is lost for every micrometre the
+	// seats bed in, through the bolt's stiffness with the plates taken as rigid, so it is the worst case. Forces in
+	// newtons, torques in newton metres.
+	struct ClampingReport {
+		double preload;
+		double ballLoad;
+		double contactRadius; // cm
+		double contactAngle; // from the bolt's axis
+		double tiltTorque; // per ball
+		double twistTorque; // per ball
+		double boltStiffness; // N/mm
+		double settlementTorque;
+		bool edgeContact; // the ball bears on a seat edge rather than the chamfer
+	};
+
+	// Inputs and outputs of up to batchSize joints, a field per array. Seat radius is the one Layout::circleRadiusOfSphere
+	// gives, the chamfer's angle from the bolt's axis is given by its sine, and grip is the distance between the plates'
+	// outer faces. Flags are 1 or 0 as doubles, so the math loop works in one vector width throughout.
+	struct ClampingBatch {
+		static const size_t batchSize = 4096;
+
+		double ballRadius[batchSize];
+		double seatRadius[batchSize];
+		double chamferLength[batchSize];
+		double chamferSine[batchSize];
+		double balls[batchSize];
+		double boltDiameter[batchSize];
+		double grip[batchSize];
+
+		double preload[batchSize];
+		double ballLoad[batchSize];
+		double contactRadius[batchSize];
+		double tiltTorque[batchSize];
+		double twistTorque[batchSize];
+		double boltStiffness[batchSize];
+		double settlementTorque[batchSize];
+		double edgeContact[batchSize];
+
+		void fill(size_t i, const JointSpec& spec);
+		ClampingReport report(size_t i) const;
+	};
+
+	// Predicted holding torque and clamping stiffness. Joints are worked out in structure-of-arrays batches, and whole
+	// armatures spread their batches over all cores. The math loop is branch free and needs only square roots, so it
+	// vectorises when sqrt need not set errno and selects may evaluate both sides (-fno-math-errno -fno-trapping-math).
+	class Clamping {
+	public:
+		static void evaluate(ClampingBatch& batch, size_t count, const ClampingSpec& spec);
+
+		static ClampingReport evaluate(const JointSpec& joint, const ClampingSpec& spec);
+		static std::vector<ClampingReport> evaluate(const std::vector<JointSpec>& joints, const ClampingSpec& spec, int workers = 0);
+	};
+}
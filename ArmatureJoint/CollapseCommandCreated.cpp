@@ -0,0 +1,28 @@
+#include "CollapseCommandCreated.h"
+
+namespace ArmatureJoint {
+	void CollapseCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		// Every joint is collapsed, so there is nothing to ask.
+		cmd->isAutoExecute(true);
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "CollapseCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class CollapseCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<CollapseCommandExecuted> _onExecute;
+
+	public:
+		CollapseCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<CollapseCommandExecuted>(new CollapseCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
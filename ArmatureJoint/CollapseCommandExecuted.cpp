@@ -0,0 +1,62 @@
+#include "CollapseCommandExecuted.h"
+
+#include "JointAttributes.h"
+#include "JointBuilder.h"
+
+namespace ArmatureJoint {
+	void CollapseCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto ui = app->userInterface();
+		if (!ui)
+			return;
+
+		auto builder = JointBuilder::create(design);
+		if (!builder)
+			return;
+
+		auto timeline = design->timeline();
+		auto before = timeline ? timeline->count() : 0;
+
+		auto collapsed = 0;
+		auto bound = 0;
+		std::string failed;
+		for (auto& component : JointAttributes::joints(design)) {
+			auto attributes = component->attributes();
+			if (attributes && attributes->itemByName(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_LEAN))
+				continue;
+
+			// Parameters drive the history, so it has to stay.
+			if (JointParameters::bound(component)) {
+				bound++;
+				continue;
+			}
+
+			if (builder->collapse(component) < 0)
+				failed += "\n" + component->name();
+			else
+				collapsed++;
+		}
+
+		auto message = "Collapsed " + std::to_string(collapsed) + " joints, leaving out " + std::to_string(builder->collapsed()) + " history items.";
+		if (timeline)
+			message += " The timeline went from " + std::to_string(before) + " to " + std::to_string(timeline->count()) + " items.";
+
+		if (bound > 0)
+			message += "\n\n" + std::to_string(bound) + " joints driven by user parameters were left as they are.";
+
+		if (!failed.empty())
+			message += "\n\nThese joints could not be collapsed:" + failed;
+
+		ui->messageBox(message, "Collapse Joint History");
+	}
+}
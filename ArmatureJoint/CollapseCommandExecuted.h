@@ -0,0 +1,21 @@
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+using namespace std;
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace ArmatureJoint {
+	class CollapseCommandExecuted : public CommandEventHandler {
+	private:
+		Ptr<Application> app;
+	public:
+		CollapseCommandExecuted(Ptr<Application> _app) {
+			app = _app;
+		}
+
+		void notify(const Ptr<CommandEventArgs>& eventArgs) override;
+	};
+}
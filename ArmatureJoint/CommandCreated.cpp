@@ -1,131 +1,92 @@
-#include "CommandCreated.h"
-
-#include "UI.h"
-
-namespace ArmatureJoint {
-	void CommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
-		if (!eventArgs)
-			return;
-
-		auto cmd = eventArgs->command();
-		if (!cmd)
-			return;
-
-		auto prod = app->activeProduct();
-		if (!prod)
-			return;
-
-		auto design = static_cast<Ptr<Design>>(prod);
-		if (!design)
-			return;
-
-		auto unitsManager = design->unitsManager();
-		if (!unitsManager)
-			return;
-
-		Values::unitsManager = unitsManager;
-
-		auto inputs = cmd->commandInputs();
-		if (!inputs)
-			return;
-
-		auto nameInput = inputs->addStringValueInput(
-			ARMATURE_JOINT_COMMAND_NAME_INPUT_ID,
-			"Name",
-			"Joint"
-		);
-		if (!nameInput)
-			return;
-
-		auto lengthInput = inputs->addDistanceValueCommandInput(
-			ARMATURE_JOINT_COMMAND_LENGTH_INPUT_ID,
-			"Joint Length",
-			ValueInput::createByReal(Values::defaultLength())
-		);
-		if (!lengthInput)
-			return;
-
-		auto widthInput = inputs->addDistanceValueCommandInput(
-			ARMATURE_JOINT_COMMAND_WIDTH_INPUT_ID,
-			"Joint Width",
-			ValueInput::createByReal(Values::defaultWidth())
-		);
-		if (!widthInput)
-			return;
-
-		auto plateThicknessInput = inputs->addDistanceValueCommandInput(
-			ARMATURE_JOINT_COMMAND_PLATE_THICKNESS_INPUT_ID,
-			"Plate Thickness",
-			ValueInput::createByReal(Values::defaultThickness())
-		);
-		if (!plateThicknessInput)
-			return;
-
-		auto boltHoleDiameterInput = inputs->addDistanceValueCommandInput(
-			ARMATURE_JOINT_COMMAND_BOLT_HOLE_DIAMETER_INPUT_ID,
-			"Bolt Hole Diameter",
-			ValueInput::createByReal(Values::defaultBoltHoleDiameter())
-		);
-		if (!boltHoleDiameterInput)
-			return;
-
-		auto ballDiameterInput = inputs->addDistanceValueCommandInput(
-			ARMATURE_JOINT_COMMAND_BALL_DIAMETER_INPUT_ID,
-			"Ball Diameter",
-			ValueInput::createByReal(Values::defaultBallDiameter())
-		);
-		if (!ballDiameterInput)
-			return;
-
-		auto ballRowsInput = inputs->addIntegerSpinnerCommandInput(
-			ARMATURE_JOINT_COMMAND_ROWS_INPUT_ID,
-			"Rows",
-			1,
-			10,
-			1,
-			ValueInput::createByReal(Values::defaultRows())
-		);
-		if (!ballRowsInput)
-			return;
-		
-		auto ballColsInput = inputs->addIntegerSpinnerCommandInput(
-			ARMATURE_JOINT_COMMAND_COLS_INPUT_ID,
-			"Cols",
-			1,
-			2,
-			1,
-			ValueInput::createByReal(Values::defaultCols())
-		);
-		if (!ballColsInput)
-			return;
-
-		auto tableInput = inputs->addTableCommandInput(
-			ARMATURE_JOINT_COMMAND_TABLE_INPUT_ID,
-			"Specifications",
-			2,
-			"1:1"
-		);
-		if (!tableInput)
-			return;
-
-		auto values = Values::create(inputs);
-		if (!values)
-			return;
-
-		values->setExtents();
-
-		auto inputChangedEvent = cmd->inputChanged();
-		if (!inputChangedEvent->add(_onInputChanged.get()))
-			return;
-
-		auto onPreview = cmd->executePreview();
-		if (!onPreview)
-			return;
-		onPreview->add(_onExecute.get());
-
-		auto onExec = cmd->execute();
-		if (!onExec)
-			return;
-		onExec->add(_onExecute.get());
-	}
+#include "CommandCreated.h"
+
+#include "JointParameters.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	void CommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto inputs = cmd->commandInputs();
+		if (!inputs)
+			return;
+
+		// Presets come first so picking one fills in the rest of the dialog. They are listed a ball size at a time.
+		if (presets && !presets->groups().empty()) {
+			auto groupInput = inputs->addDropDownCommandInput(ARMATURE_JOINT_COMMAND_PRESET_GROUP_INPUT_ID, "Preset Ball", DropDownStyles::TextListDropDownStyle);
+			if (!groupInput)
+				return;
+
+			auto groupItems = groupInput->listItems();
+			if (!groupItems)
+				return;
+
+			auto& groups = presets->groups();
+			for (size_t i = 0; i < groups.size(); i++) {
+				if (!groupItems->add(groups[i].name, i == 0))
+					return;
+			}
+
+			groupInput->maxVisibleItems(20);
+
+			auto presetInput = inputs->addDropDownCommandInput(ARMATURE_JOINT_COMMAND_PRESET_INPUT_ID, "Preset", DropDownStyles::TextListDropDownStyle);
+			if (!presetInput)
+				return;
+
+			if (!CommandInputChanged::listPresets(presetInput, presets->groups().front(), presets))
+				return;
+
+			presetInput->maxVisibleItems(20);
+		}
+
+		auto values = Values::addInputs(inputs, Values::defaultSpec());
+		if (!values)
+			return;
+
+		values->setExtents();
+
+		if (!JointParameters::addInput(inputs, ARMATURE_JOINT_COMMAND_PARAMETERS_INPUT_ID))
+			return;
+
+		auto leanInput = inputs->addBoolValueInput(ARMATURE_JOINT_COMMAND_LEAN_INPUT_ID, "Lean Output", true, "", false);
+		if (!leanInput)
+			return;
+
+		leanInput->tooltip("Keeps only the joint's bodies, without its planes, sketches and features, so large designs open and recompute faster");
+
+		_onInputChanged->values = values;
+		_onExecute->values = values;
+		_onValidateInputs->values = values;
+
+		auto inputChangedEvent = cmd->inputChanged();
+		if (!inputChangedEvent->add(_onInputChanged.get()))
+			return;
+
+		auto validateInputsEvent = cmd->validateInputs();
+		if (!validateInputsEvent->add(_onValidateInputs.get()))
+			return;
+
+		auto onPreview = cmd->executePreview();
+		if (!onPreview)
+			return;
+		onPreview->add(_onExecute.get());
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
 }
\ No newline at end of file
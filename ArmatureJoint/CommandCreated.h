@@ -1,22 +1,28 @@
-#pragma once
-
-#include "CommandExecuted.h"
-#include "CommandInputChanged.h"
-
-namespace ArmatureJoint {
-	class CommandCreated : public CommandCreatedEventHandler {
-	private:
-		Ptr<Application> app;
-		unique_ptr<CommandExecuted> _onExecute;
-		unique_ptr<CommandInputChanged> _onInputChanged;
-
-	public:
-		CommandCreated(Ptr<Application> _app) {
-			app = _app;
-			_onExecute = unique_ptr<CommandExecuted>(new CommandExecuted(app));
-			_onInputChanged = unique_ptr<CommandInputChanged>(new CommandInputChanged());
-		}
-
-		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
-	};
+#pragma once
+
+#include "CommandExecuted.h"
+#include "CommandInputChanged.h"
+#include "CommandValidateInputs.h"
+
+namespace ArmatureJoint {
+	class CommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<CommandExecuted> _onExecute;
+		unique_ptr<CommandInputChanged> _onInputChanged;
+		unique_ptr<CommandValidateInputs> _onValidateInputs;
+		shared_ptr<PresetLibrary> presets;
+
+	public:
+		CommandCreated(Ptr<Application> _app, shared_ptr<PresetLibrary> _presets) {
+			app = _app;
+			presets = _presets;
+			_onExecute = unique_ptr<CommandExecuted>(new CommandExecuted(app));
+			_onInputChanged = unique_ptr<CommandInputChanged>(new CommandInputChanged());
+			_onInputChanged->presets = presets;
+			_onValidateInputs = unique_ptr<CommandValidateInputs>(new CommandValidateInputs());
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
 }
\ No newline at end of file
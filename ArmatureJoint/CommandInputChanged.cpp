@@ -1,19 +1,75 @@
-#include "CommandInputChanged.h"
-#include "Values.h"
-
-namespace ArmatureJoint {
-	void CommandInputChanged::notify(const Ptr<InputChangedEventArgs>& eventArgs) {
-		if (!eventArgs)
-			return;
-
-		auto inputs = eventArgs->inputs();
-		if (!inputs)
-			return;
-
-		auto values = Values::create(eventArgs->inputs());
-		if (!values)
-			return;
-
-		values->setExtents();
-	}
+#include "CommandInputChanged.h"
+#include "UI.h"
+#include "Values.h"
+
+namespace ArmatureJoint {
+	void CommandInputChanged::notify(const Ptr<InputChangedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto inputs = eventArgs->inputs();
+		if (!inputs)
+			return;
+
+		// Choosing a ball size lists its presets, leaving the inputs as they are until one is picked.
+		auto input = eventArgs->input();
+		if (presets && input && input->id() == ARMATURE_JOINT_COMMAND_PRESET_GROUP_INPUT_ID) {
+			auto dropDown = static_cast<Ptr<DropDownCommandInput>>(input);
+			auto selected = dropDown ? dropDown->selectedItem() : nullptr;
+			if (!selected || selected->index() < 0 || (size_t)selected->index() >= presets->groups().size())
+				return;
+
+			auto presetInput = static_cast<Ptr<DropDownCommandInput>>(inputs->itemById(ARMATURE_JOINT_COMMAND_PRESET_INPUT_ID));
+			if (presetInput)
+				listPresets(presetInput, presets->groups()[selected->index()], presets);
+			return;
+		}
+
+		// Choosing a preset fills in every input at once. Custom leaves them as they are.
+		if (values && presets && input && input->id() == ARMATURE_JOINT_COMMAND_PRESET_INPUT_ID) {
+			auto groupInput = static_cast<Ptr<DropDownCommandInput>>(inputs->itemById(ARMATURE_JOINT_COMMAND_PRESET_GROUP_INPUT_ID));
+			auto group = groupInput ? groupInput->selectedItem() : nullptr;
+			if (!group || group->index() < 0 || (size_t)group->index() >= presets->groups().size())
+				return;
+
+			auto& members = presets->groups()[group->index()].presets;
+			auto dropDown = static_cast<Ptr<DropDownCommandInput>>(input);
+			auto selected = dropDown ? dropDown->selectedItem() : nullptr;
+			if (!selected || selected->index() < 1 || (size_t)selected->index() > members.size())
+				return;
+
+			auto index = members[selected->index() - 1];
+			if (!values->load(presets->spec(index), presets->record(index).layout))
+				return;
+
+			values->setExtents();
+			return;
+		}
+
+		if (!values)
+			values = Values::create(inputs);
+		else if (!values->update(eventArgs->input()))
+			return;
+
+		if (!values)
+			return;
+
+		values->setExtents();
+	}
+
+	bool CommandInputChanged::listPresets(Ptr<DropDownCommandInput> dropDown, const PresetGroup& group, shared_ptr<PresetLibrary> presets) {
+		auto items = dropDown->listItems();
+		if (!items || !items->clear())
+			return false;
+
+		if (!items->add("Custom", true))
+			return false;
+
+		for (auto index : group.presets) {
+			if (!items->add(presets->name(index), false))
+				return false;
+		}
+
+		return true;
+	}
 }
\ No newline at end of file
@@ -1,13 +1,24 @@
-#pragma once
-
-#include <Core/CoreAll.h>
-#include <Fusion/FusionAll.h>
-
-using namespace adsk::core;
-using namespace adsk::fusion;
-
-namespace ArmatureJoint {
-	class CommandInputChanged : public InputChangedEventHandler {
-		void notify(const Ptr<InputChangedEventArgs>& eventArgs) override;
-	};
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+#include "Presets.h"
+#include "Values.h"
+
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace ArmatureJoint {
+	class CommandInputChanged : public InputChangedEventHandler {
+	public:
+		// The values of the current command session, kept across input changes.
+		shared_ptr<Values> values;
+		shared_ptr<PresetLibrary> presets;
+
+		void notify(const Ptr<InputChangedEventArgs>& eventArgs) override;
+
+		// Replaces a preset list with Custom, selected, then the group's presets.
+		static bool listPresets(Ptr<DropDownCommandInput> dropDown, const PresetGroup& group, shared_ptr<PresetLibrary> presets);
+	};
 }
\ No newline at end of file
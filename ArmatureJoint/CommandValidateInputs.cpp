@@ -0,0 +1,11 @@
+#include "CommandValidateInputs.h"
+
+namespace ArmatureJoint {
+	// Runs before every preview, so infeasible inputs disable OK without any features being built.
+	void CommandValidateInputs::notify(const Ptr<ValidateInputsEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		eventArgs->areInputsValid(values && values->validate());
+	}
+}
\ No newline at end of file
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+#include "Values.h"
+
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace ArmatureJoint {
+	class CommandValidateInputs : public ValidateInputsEventHandler {
+	public:
+		shared_ptr<Values> values;
+
+		void notify(const Ptr<ValidateInputsEventArgs>& eventArgs) override;
+	};
+}
\ No newline at end of file
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace ArmatureJoint {
+	// Defers a sketch's or design's compute while it is changed. finish() puts compute back the way it was found and says
+	// whether that worked; leaving the scope any other way, such as returning early or throwing, still puts it back.
+	template <class T> class ComputeDeferral {
+	private:
+		Ptr<T> owner;
+		bool _deferred;
+		bool previous;
+
+	public:
+		explicit ComputeDeferral(Ptr<T> _owner) : owner(_owner), _deferred(false), previous(false) {
+			if (!owner)
+				return;
+
+			previous = owner->isComputeDeferred();
+			_deferred = owner->isComputeDeferred(true);
+		}
+		~ComputeDeferral() { finish(); }
+
+		ComputeDeferral(const ComputeDeferral&) = delete;
+		ComputeDeferral& operator=(const ComputeDeferral&) = delete;
+
+		bool deferred() const { return _deferred; }
+
+		bool finish() {
+			if (!_deferred)
+				return false;
+
+			_deferred = false;
+			return owner->isComputeDeferred(previous);
+		}
+	};
+
+	typedef ComputeDeferral<Sketch> DeferredCompute;
+	typedef ComputeDeferral<Design> DeferredDesignCompute;
+}
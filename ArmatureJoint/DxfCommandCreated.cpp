@@ -0,0 +1,68 @@
+#include "DxfCommandCreated.h"
+
+#include "UI.h"
+#include "Units.h"
+
+namespace ArmatureJoint {
+	void DxfCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto inputs = cmd->commandInputs();
+		if (!inputs)
+			return;
+
+		auto sheetWidthInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_DXF_SHEET_WIDTH_INPUT_ID,
+			"Sheet Width",
+			ValueInput::createByReal((300_mm).centimetres())
+		);
+		if (!sheetWidthInput)
+			return;
+
+		sheetWidthInput->tooltip("Width of the stock sheets the plates are nested on");
+
+		auto sheetHeightInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_DXF_SHEET_HEIGHT_INPUT_ID,
+			"Sheet Height",
+			ValueInput::createByReal((300_mm).centimetres())
+		);
+		if (!sheetHeightInput)
+			return;
+
+		sheetHeightInput->tooltip("Height of the stock sheets the plates are nested on");
+
+		auto spacingInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_DXF_SPACING_INPUT_ID,
+			"Spacing",
+			ValueInput::createByReal((3_mm).centimetres())
+		);
+		if (!spacingInput)
+			return;
+
+		spacingInput->tooltip("Gap left between neighbouring plates for the kerf");
+
+		auto rotateInput = inputs->addBoolValueInput(ARMATURE_JOINT_DXF_ROTATE_INPUT_ID, "Allow Rotation", true, "", true);
+		if (!rotateInput)
+			return;
+
+		rotateInput->tooltip("Lets plates turn a quarter to fit the sheets better");
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
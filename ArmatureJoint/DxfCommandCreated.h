@@ -0,0 +1,19 @@
+#pragma once
+
+#include "DxfCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class DxfCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<DxfCommandExecuted> _onExecute;
+
+	public:
+		DxfCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<DxfCommandExecuted>(new DxfCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
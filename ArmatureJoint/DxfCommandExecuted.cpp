@@ -0,0 +1,129 @@
+#include "DxfCommandExecuted.h"
+
+#include "JointAttributes.h"
+#include "Nesting.h"
+#include "PlateDxf.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	void DxfCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto command = eventArgs->command();
+		if (!command)
+			return;
+
+		auto inputs = command->commandInputs();
+		if (!inputs)
+			return;
+
+		auto sheetWidthInput = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_DXF_SHEET_WIDTH_INPUT_ID));
+		if (!sheetWidthInput)
+			return;
+
+		auto sheetHeightInput = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_DXF_SHEET_HEIGHT_INPUT_ID));
+		if (!sheetHeightInput)
+			return;
+
+		auto spacingInput = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_DXF_SPACING_INPUT_ID));
+		if (!spacingInput)
+			return;
+
+		auto rotateInput = static_cast<Ptr<BoolValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_DXF_ROTATE_INPUT_ID));
+		if (!rotateInput)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto root = design->rootComponent();
+		if (!root)
+			return;
+
+		auto ui = app->userInterface();
+		if (!ui)
+			return;
+
+		// Every occurrence needs its own pair of plates, bottom then top.
+		std::vector<Layout> layouts;
+		std::vector<std::pair<size_t, bool>> plates;
+		std::vector<NestPart> parts;
+		for (auto& component : JointAttributes::joints(design)) {
+			JointSpec spec;
+			if (!JointAttributes::readSpec(component, spec))
+				continue;
+
+			auto occurrences = root->allOccurrencesByComponent(component);
+			if (!occurrences || occurrences->count() == 0)
+				continue;
+
+			layouts.push_back(Layout(spec));
+			NestPart part = { PlateDxf::width(layouts.back()), PlateDxf::height(layouts.back()) };
+			for (size_t i = 0; i < 2 * occurrences->count(); i++) {
+				plates.push_back(std::make_pair(layouts.size() - 1, i % 2 == 1));
+				parts.push_back(part);
+			}
+		}
+
+		if (layouts.empty()) {
+			ui->messageBox("There are no armature joints in the design.", "Export Plate Profiles");
+			return;
+		}
+
+		auto fileDialog = ui->createFileDialog();
+		if (!fileDialog)
+			return;
+
+		fileDialog->title("Export Plate Profiles");
+		fileDialog->filter(ARMATURE_JOINT_DXF_FILE_FILTER);
+
+		if (fileDialog->showSave() != DialogResults::DialogOK)
+			return;
+
+		auto sheetWidth = Length::fromCentimetres(sheetWidthInput->value()).millimetres();
+		auto sheetHeight = Length::fromCentimetres(sheetHeightInput->value()).millimetres();
+		auto spacing = Length::fromCentimetres(spacingInput->value()).millimetres();
+		auto nest = Nesting::pack(parts, sheetWidth, sheetHeight, spacing, rotateInput->value());
+
+		auto path = fileDialog->filename();
+		auto dxf = PlateDxf::create(path);
+		if (!dxf) {
+			ui->messageBox("Could not write " + path, "Export Plate Profiles");
+			return;
+		}
+
+		// Sheets sit side by side, a tenth of a sheet apart.
+		auto pitch = sheetWidth * 1.1;
+		auto written = true;
+		for (auto sheet = 0; sheet < nest.sheets; sheet++)
+			written = written && dxf->sheet(sheet * pitch, 0, sheetWidth, sheetHeight);
+
+		for (size_t i = 0; i < plates.size(); i++) {
+			auto& placement = nest.placements[i];
+			if (placement.sheet < 0)
+				continue;
+
+			written = written && dxf->add(layouts[plates[i].first], plates[i].second, (placement.sheet * pitch) + placement.x, placement.y, placement.rotated);
+		}
+
+		if (!written || !dxf->close()) {
+			ui->messageBox("Could not write " + path, "Export Plate Profiles");
+			return;
+		}
+
+		char yield[32];
+		snprintf(yield, sizeof(yield), "%.0f%%", nest.yield * 100);
+
+		auto message = "Nested " + std::to_string(plates.size() - nest.unplaced) + " plates on " + std::to_string(nest.sheets) + " sheets with " + yield + " material yield.";
+		if (nest.unplaced > 0)
+			message += " " + std::to_string(nest.unplaced) + " plates are larger than a sheet and were left out.";
+
+		ui->messageBox(message, "Export Plate Profiles");
+	}
+}
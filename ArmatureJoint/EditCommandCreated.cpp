@@ -0,0 +1,80 @@
+#include "EditCommandCreated.h"
+
+#include "JointAttributes.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	void EditCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto inputs = cmd->commandInputs();
+		if (!inputs)
+			return;
+
+		auto selectionInput = inputs->addSelectionInput(
+			ARMATURE_JOINT_EDIT_SELECTION_INPUT_ID,
+			"Joint",
+			"Select an armature joint to edit"
+		);
+		if (!selectionInput)
+			return;
+
+		selectionInput->addSelectionFilter("Occurrences");
+		selectionInput->setSelectionLimits(1, 1);
+
+		auto values = Values::addInputs(inputs, Values::defaultSpec());
+		if (!values)
+			return;
+
+		// Start from the joint that was selected before the command was run, if there is one.
+		auto ui = app->userInterface();
+		auto selections = ui ? ui->activeSelections() : nullptr;
+		if (selections && selections->count() == 1) {
+			auto occurrence = static_cast<Ptr<Occurrence>>(selections->item(0)->entity());
+
+			JointSpec spec;
+			if (occurrence && JointAttributes::readSpec(occurrence->component(), spec)) {
+				selectionInput->addSelection(occurrence);
+				if (!values->load(spec))
+					return;
+			}
+		}
+
+		values->setExtents();
+
+		_onInputChanged->values = values;
+		_onExecute->values = values;
+		_onValidateInputs->values = values;
+
+		auto inputChangedEvent = cmd->inputChanged();
+		if (!inputChangedEvent->add(_onInputChanged.get()))
+			return;
+
+		auto validateInputsEvent = cmd->validateInputs();
+		if (!validateInputsEvent->add(_onValidateInputs.get()))
+			return;
+
+		auto onPreview = cmd->executePreview();
+		if (!onPreview)
+			return;
+		onPreview->add(_onExecute.get());
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "EditCommandExecuted.h"
+#include "EditCommandInputChanged.h"
+#include "CommandValidateInputs.h"
+
+namespace ArmatureJoint {
+	class EditCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<EditCommandExecuted> _onExecute;
+		unique_ptr<EditCommandInputChanged> _onInputChanged;
+		unique_ptr<CommandValidateInputs> _onValidateInputs;
+
+	public:
+		EditCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<EditCommandExecuted>(new EditCommandExecuted(app));
+			_onInputChanged = unique_ptr<EditCommandInputChanged>(new EditCommandInputChanged());
+			_onValidateInputs = unique_ptr<CommandValidateInputs>(new CommandValidateInputs());
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
@@ -0,0 +1,63 @@
+#include "EditCommandExecuted.h"
+
+#include "JointAttributes.h"
+#include "JointEditor.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	Ptr<Component> EditCommandExecuted::selectedJoint(Ptr<CommandInputs> inputs) {
+		if (!inputs)
+			return nullptr;
+
+		auto selectionInput = static_cast<Ptr<SelectionCommandInput>>(inputs->itemById(ARMATURE_JOINT_EDIT_SELECTION_INPUT_ID));
+		if (!selectionInput || selectionInput->selectionCount() != 1)
+			return nullptr;
+
+		auto selection = selectionInput->selection(0);
+		if (!selection)
+			return nullptr;
+
+		auto occurrence = static_cast<Ptr<Occurrence>>(selection->entity());
+		if (!occurrence)
+			return nullptr;
+
+		auto component = occurrence->component();
+
+		JointSpec spec;
+		if (!JointAttributes::readSpec(component, spec))
+			return nullptr;
+
+		return component;
+	}
+
+	void EditCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto command = eventArgs->command();
+		if (!command)
+			return;
+
+		auto component = selectedJoint(command->commandInputs());
+		if (!component)
+			return;
+
+		auto current = values ? values : Values::create(command->commandInputs());
+		if (!current)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto editor = JointEditor::create(design);
+		if (!editor)
+			return;
+
+		editor->update(component, current);
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+#include "Values.h"
+
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace ArmatureJoint {
+	class EditCommandExecuted : public CommandEventHandler {
+	private:
+		Ptr<Application> app;
+	public:
+		EditCommandExecuted(Ptr<Application> _app) {
+			app = _app;
+		}
+
+		shared_ptr<Values> values;
+
+		static Ptr<Component> selectedJoint(Ptr<CommandInputs> inputs);
+
+		void notify(const Ptr<CommandEventArgs>& eventArgs) override;
+	};
+}
@@ -0,0 +1,38 @@
+#include "EditCommandInputChanged.h"
+
+#include "EditCommandExecuted.h"
+#include "JointAttributes.h"
+#include "UI.h"
+#include "Values.h"
+
+namespace ArmatureJoint {
+	void EditCommandInputChanged::notify(const Ptr<InputChangedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto inputs = eventArgs->inputs();
+		if (!inputs)
+			return;
+
+		if (!values)
+			values = Values::create(inputs);
+
+		if (!values)
+			return;
+
+		auto input = eventArgs->input();
+		if (input && input->id() == ARMATURE_JOINT_EDIT_SELECTION_INPUT_ID) {
+			JointSpec spec;
+			if (!JointAttributes::readSpec(EditCommandExecuted::selectedJoint(inputs), spec))
+				return;
+
+			if (!values->load(spec))
+				return;
+		}
+		else if (!values->update(input)) {
+			return;
+		}
+
+		values->setExtents();
+	}
+}
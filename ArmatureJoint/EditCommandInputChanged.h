@@ -0,0 +1,19 @@
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+#include "Values.h"
+
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace ArmatureJoint {
+	class EditCommandInputChanged : public InputChangedEventHandler {
+	public:
+		// The values of the current command session, kept across input changes.
+		shared_ptr<Values> values;
+
+		void notify(const Ptr<InputChangedEventArgs>& eventArgs) override;
+	};
+}
@@ -0,0 +1,42 @@
+#include "ExportCommandCreated.h"
+
+#include "UI.h"
+#include "Units.h"
+
+namespace ArmatureJoint {
+	void ExportCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto inputs = cmd->commandInputs();
+		if (!inputs)
+			return;
+
+		auto toleranceInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_EXPORT_TOLERANCE_INPUT_ID,
+			"Chord Tolerance",
+			ValueInput::createByReal((0.01_mm).centimetres())
+		);
+		if (!toleranceInput)
+			return;
+
+		toleranceInput->tooltip("How far a facet may stray from the true curved surface");
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
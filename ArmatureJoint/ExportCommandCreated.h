@@ -0,0 +1,19 @@
+#pragma once
+
+#include "ExportCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class ExportCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<ExportCommandExecuted> _onExecute;
+
+	public:
+		ExportCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<ExportCommandExecuted>(new ExportCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
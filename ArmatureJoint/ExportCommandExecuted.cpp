@@ -0,0 +1,112 @@
+#include "ExportCommandExecuted.h"
+
+#include <chrono>
+
+#include "JointAttributes.h"
+#include "MeshWriter.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	void ExportCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto command = eventArgs->command();
+		if (!command)
+			return;
+
+		auto inputs = command->commandInputs();
+		if (!inputs)
+			return;
+
+		auto toleranceInput = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_EXPORT_TOLERANCE_INPUT_ID));
+		if (!toleranceInput)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto root = design->rootComponent();
+		if (!root)
+			return;
+
+		auto ui = app->userInterface();
+		if (!ui)
+			return;
+
+		// Each joint component is tessellated once, then written at every occurrence's placement.
+		std::vector<Layout> layouts;
+		std::vector<std::vector<Transform>> placements;
+		size_t occurrenceCount = 0;
+		for (auto& component : JointAttributes::joints(design)) {
+			JointSpec spec;
+			if (!JointAttributes::readSpec(component, spec))
+				continue;
+
+			std::vector<Transform> placed;
+			auto occurrences = root->allOccurrencesByComponent(component);
+			for (size_t i = 0; occurrences && i < occurrences->count(); i++) {
+				auto occurrence = occurrences->item(i);
+				if (!occurrence || !occurrence->transform2())
+					continue;
+
+				auto matrix = occurrence->transform2()->asArray();
+				if (matrix.size() != 16)
+					continue;
+
+				std::array<double, 16> placement;
+				std::copy(matrix.begin(), matrix.end(), placement.begin());
+				placed.push_back(Transform(placement));
+			}
+
+			if (placed.empty())
+				continue;
+
+			occurrenceCount += placed.size();
+			layouts.push_back(Layout(spec));
+			placements.push_back(placed);
+		}
+
+		if (layouts.empty()) {
+			ui->messageBox("There are no armature joints in the design.", "Export Armature Meshes");
+			return;
+		}
+
+		auto fileDialog = ui->createFileDialog();
+		if (!fileDialog)
+			return;
+
+		fileDialog->title("Export Armature Meshes");
+		fileDialog->filter(ARMATURE_JOINT_EXPORT_FILE_FILTER);
+
+		if (fileDialog->showSave() != DialogResults::DialogOK)
+			return;
+
+		auto path = fileDialog->filename();
+		auto writer = MeshWriter::create(path);
+		if (!writer) {
+			ui->messageBox("Could not write " + path + ". Use a .stl or .3mf file.", "Export Armature Meshes");
+			return;
+		}
+
+		auto start = std::chrono::steady_clock::now();
+		if (!writer->write(layouts, placements, toleranceInput->value()) || !writer->close()) {
+			ui->messageBox("Could not write " + path, "Export Armature Meshes");
+			return;
+		}
+		auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		char elapsed[32];
+		snprintf(elapsed, sizeof(elapsed), "%.2f", seconds);
+
+		ui->messageBox(
+			"Wrote " + std::to_string(writer->triangles()) + " triangles for " + std::to_string(occurrenceCount) + " joints in " + elapsed + " s.",
+			"Export Armature Meshes"
+		);
+	}
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <algorithm>
+#include <math.h>
+
+namespace ArmatureJoint {
+	struct Vector3 {
+		double x;
+		double y;
+		double z;
+
+		Vector3() : x(0), y(0), z(0) {}
+		Vector3(double _x, double _y, double _z) : x(_x), y(_y), z(_z) {}
+
+		Vector3 operator+(const Vector3& v) const { return Vector3(x + v.x, y + v.y, z + v.z); }
+		Vector3 operator-(const Vector3& v) const { return Vector3(x - v.x, y - v.y, z - v.z); }
+		Vector3 operator-() const { return Vector3(-x, -y, -z); }
+		Vector3 operator*(double s) const { return Vector3(x * s, y * s, z * s); }
+		double operator[](int i) const { return i == 0 ? x : (i == 1 ? y : z); }
+
+		double dot(const Vector3& v) const { return (x * v.x) + (y * v.y) + (z * v.z); }
+		Vector3 cross(const Vector3& v) const { return Vector3((y * v.z) - (z * v.y), (z * v.x) - (x * v.z), (x * v.y) - (y * v.x)); }
+		double lengthSquared() const { return dot(*this); }
+		double length() const { return sqrt(lengthSquared()); }
+	};
+
+	// Axis aligned bounds.
+	struct Aabb {
+		Vector3 min;
+		Vector3 max;
+
+		Aabb() : min(HUGE_VAL, HUGE_VAL, HUGE_VAL), max(-HUGE_VAL, -HUGE_VAL, -HUGE_VAL) {}
+		Aabb(const Vector3& _min, const Vector3& _max) : min(_min), max(_max) {}
+
+		void add(const Vector3& p) {
+			min = Vector3(std::min(min.x, p.x), std::min(min.y, p.y), std::min(min.z, p.z));
+			max = Vector3(std::max(max.x, p.x), std::max(max.y, p.y), std::max(max.z, p.z));
+		}
+
+		void add(const Aabb& b) {
+			add(b.min);
+			add(b.max);
+		}
+
+		Vector3 centre() const { return (min + max) * 0.5; }
+		Vector3 size() const { return max - min; }
+
+		// Distance between two boxes, zero when they touch or overlap.
+		double distance(const Aabb& b) const {
+			auto dx = std::max(0.0, std::max(b.min.x - max.x, min.x - b.max.x));
+			auto dy = std::max(0.0, std::max(b.min.y - max.y, min.y - b.max.y));
+			auto dz = std::max(0.0, std::max(b.min.z - max.z, min.z - b.max.z));
+			return sqrt((dx * dx) + (dy * dy) + (dz * dz));
+		}
+	};
+
+	// A rigid placement, stored row major like Matrix3D::asArray and JointSpec::transform.
+	struct Transform {
+		std::array<double, 16> m;
+
+		Transform() : m({ { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 } }) {}
+		explicit Transform(const std::array<double, 16>& _m) : m(_m) {}
+
+		Vector3 point(const Vector3& p) const {
+			return Vector3(
+				(m[0] * p.x) + (m[1] * p.y) + (m[2] * p.z) + m[3],
+				(m[4] * p.x) + (m[5] * p.y) + (m[6] * p.z) + m[7],
+				(m[8] * p.x) + (m[9] * p.y) + (m[10] * p.z) + m[11]
+			);
+		}
+
+		Vector3 vector(const Vector3& v) const {
+			return Vector3(
+				(m[0] * v.x) + (m[1] * v.y) + (m[2] * v.z),
+				(m[4] * v.x) + (m[5] * v.y) + (m[6] * v.z),
+				(m[8] * v.x) + (m[9] * v.y) + (m[10] * v.z)
+			);
+		}
+
+		Transform operator*(const Transform& t) const {
+			Transform r;
+			for (auto row = 0; row < 4; row++) {
+				for (auto col = 0; col < 4; col++) {
+					double sum = 0;
+					for (auto k = 0; k < 4; k++)
+						sum += m[(row * 4) + k] * t.m[(k * 4) + col];
+					r.m[(row * 4) + col] = sum;
+				}
+			}
+			return r;
+		}
+	};
+}
@@ -0,0 +1,43 @@
+#include "HoldingCommandCreated.h"
+
+#include "Clamping.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	void HoldingCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto inputs = cmd->commandInputs();
+		if (!inputs)
+			return;
+
+		auto clamping = ClampingSpec::defaults();
+		auto boltTorqueInput = inputs->addValueInput(ARMATURE_JOINT_HOLDING_BOLT_TORQUE_INPUT_ID, "Bolt Torque (N m)", "", ValueInput::createByReal(clamping.boltTorque));
+		if (!boltTorqueInput)
+			return;
+
+		boltTorqueInput->tooltip("How tightly each joint's bolt is done up");
+
+		auto frictionInput = inputs->addValueInput(ARMATURE_JOINT_HOLDING_FRICTION_INPUT_ID, "Seat Friction", "", ValueInput::createByReal(clamping.friction));
+		if (!frictionInput)
+			return;
+
+		frictionInput->tooltip("Coefficient of friction between the balls and the plate chamfers");
+
+		auto massInput = inputs->addValueInput(ARMATURE_JOINT_HOLDING_PUPPET_MASS_INPUT_ID, "Puppet Mass (g)", "", ValueInput::createByReal(200));
+		if (!massInput)
+			return;
+
+		massInput->tooltip("The finished puppet, armature, build up and costume, that the joints have to hold out");
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
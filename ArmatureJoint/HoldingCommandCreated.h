@@ -0,0 +1,19 @@
+#pragma once
+
+#include "HoldingCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class HoldingCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<HoldingCommandExecuted> _onExecute;
+
+	public:
+		HoldingCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<HoldingCommandExecuted>(new HoldingCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
@@ -0,0 +1,104 @@
+#include "HoldingCommandExecuted.h"
+
+#include <algorithm>
+
+#include "Clamping.h"
+#include "JointAttributes.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		const double gravity = 9.81;
+
+		double value(Ptr<CommandInputs> inputs, const char* id) {
+			auto input = static_cast<Ptr<ValueCommandInput>>(inputs->itemById(id));
+			return input ? input->value() : 0;
+		}
+
+		std::string number(double value) {
+			char text[32];
+			snprintf(text, sizeof(text), "%.3g", value);
+			return text;
+		}
+	}
+
+	void HoldingCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto command = eventArgs->command();
+		if (!command)
+			return;
+
+		auto inputs = command->commandInputs();
+		if (!inputs)
+			return;
+
+		auto clamping = ClampingSpec::defaults();
+		clamping.boltTorque = value(inputs, ARMATURE_JOINT_HOLDING_BOLT_TORQUE_INPUT_ID);
+		clamping.friction = value(inputs, ARMATURE_JOINT_HOLDING_FRICTION_INPUT_ID);
+		auto puppetMass = value(inputs, ARMATURE_JOINT_HOLDING_PUPPET_MASS_INPUT_ID);
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto unitsManager = design->unitsManager();
+		if (!unitsManager)
+			return;
+
+		auto ui = app->userInterface();
+		if (!ui)
+			return;
+
+		vector<JointSpec> specs;
+		for (auto& component : JointAttributes::joints(design)) {
+			JointSpec spec;
+			if (JointAttributes::readSpec(component, spec))
+				specs.push_back(spec);
+		}
+
+		auto reports = Clamping::evaluate(specs, clamping);
+
+		// Weakest first; joints with only nuts hold nothing of their own.
+		vector<size_t> order;
+		for (size_t i = 0; i < reports.size(); i++) {
+			if (reports[i].ballLoad > 0)
+				order.push_back(i);
+		}
+
+		if (order.empty()) {
+			ui->messageBox("There are no armature joints with balls in the design.", "Joint Holding Torque");
+			return;
+		}
+
+		std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+			return reports[a].tiltTorque < reports[b].tiltTorque;
+		});
+
+		// How far out from the joint the whole puppet's weight could hang before the weakest ball slips.
+		auto weight = puppetMass / 1000 * gravity;
+
+		std::string message = "Holding torque per ball, in N cm, tilting and twisting:\n";
+		for (auto i : order) {
+			auto& report = reports[i];
+			message += "\n" + specs[i].name + ": " + number(report.tiltTorque * 100) + " tilt, " + number(report.twistTorque * 100) + " twist";
+
+			if (weight > 0)
+				message += ", holds the puppet out to " + unitsManager->formatInternalValue(report.tiltTorque / weight * 100);
+
+			if (report.edgeContact)
+				message += " (bears on the seat edges)";
+		}
+
+		auto& weakest = reports[order.front()];
+		message += "\n\nThe weakest joint's bolt is preloaded to " + number(weakest.preload) + " N with a stiffness of " + number(weakest.boltStiffness) + " N/mm, " +
+			"so every 0.001 mm its seats bed in costs up to " + number(weakest.settlementTorque * 100) + " N cm of tilt torque.";
+
+		ui->messageBox(message, "Joint Holding Torque");
+	}
+}
@@ -0,0 +1,128 @@
+#include "Interference.h"
+
+#include <algorithm>
+
+namespace ArmatureJoint {
+	Interference::Interference() : built(false) {
+	}
+
+	int Interference::add(const Layout& layout, const Transform& placement, double margin) {
+		Joint joint;
+		joint.margin = margin;
+		joint.first = (int)primitives.size();
+		Primitive::fromLayout(layout, (int)joints.size(), joint.local);
+
+		for (auto& primitive : joint.local)
+			primitives.push_back(primitive.transformed(placement));
+
+		joints.push_back(joint);
+		built = false;
+
+		return (int)joints.size() - 1;
+	}
+
+	// Moving a joint only refits the boxes above its own leaves.
+	void Interference::move(int joint, const Transform& placement) {
+		auto& moved = joints[joint];
+		for (size_t i = 0; i < moved.local.size(); i++) {
+			auto index = moved.first + (int)i;
+			primitives[index] = moved.local[i].transformed(placement);
+
+			if (built)
+				bvh.refit(index, bounds(primitives[index]));
+		}
+	}
+
+	int Interference::count() const {
+		return (int)joints.size();
+	}
+
+	void Interference::build() {
+		std::vector<Aabb> boxes;
+		boxes.reserve(primitives.size());
+		for (auto& primitive : primitives)
+			boxes.push_back(bounds(primitive));
+
+		bvh.build(boxes);
+		built = true;
+	}
+
+	Aabb Interference::bounds(const Primitive& primitive) const {
+		return primitive.bounds(joints[primitive.joint].margin);
+	}
+
+	std::vector<Clearance> Interference::check(double range) {
+		if (!built)
+			build();
+
+		std::vector<std::pair<int, int>> candidates;
+		bvh.pairs(range, candidates);
+
+		std::map<std::pair<int, int>, Clearance> found;
+		for (auto& candidate : candidates)
+			measure(candidate.first, candidate.second, found);
+
+		return sorted(found, range);
+	}
+
+	std::vector<Clearance> Interference::check(int joint, double range) {
+		if (!built)
+			build();
+
+		std::map<std::pair<int, int>, Clearance> found;
+		std::vector<int> candidates;
+
+		auto& checked = joints[joint];
+		for (size_t i = 0; i < checked.local.size(); i++) {
+			auto index = checked.first + (int)i;
+
+			candidates.clear();
+			bvh.query(bounds(primitives[index]), range, candidates);
+
+			for (auto candidate : candidates)
+				measure(index, candidate, found);
+		}
+
+		return sorted(found, range);
+	}
+
+	// Narrow phase for one pair of solids. Solids of the same joint are allowed to touch.
+	void Interference::measure(int a, int b, std::map<std::pair<int, int>, Clearance>& found) const {
+		auto& primitiveA = primitives[a];
+		auto& primitiveB = primitives[b];
+		if (primitiveA.joint == primitiveB.joint)
+			return;
+
+		auto overlapping = false;
+		auto distance = Primitive::distance(primitiveA, primitiveB, overlapping);
+		distance -= primitiveA.radius + primitiveB.radius + joints[primitiveA.joint].margin + joints[primitiveB.joint].margin;
+
+		auto key = std::make_pair(std::min(primitiveA.joint, primitiveB.joint), std::max(primitiveA.joint, primitiveB.joint));
+
+		auto existing = found.find(key);
+		if (existing == found.end()) {
+			Clearance clearance = { key.first, key.second, distance, overlapping || distance < 0 };
+			found[key] = clearance;
+			return;
+		}
+
+		existing->second.distance = std::min(existing->second.distance, distance);
+		existing->second.colliding = existing->second.colliding || overlapping || distance < 0;
+	}
+
+	std::vector<Clearance> Interference::sorted(const std::map<std::pair<int, int>, Clearance>& found, double range) {
+		std::vector<Clearance> clearances;
+		for (auto& entry : found) {
+			if (entry.second.colliding || entry.second.distance <= range)
+				clearances.push_back(entry.second);
+		}
+
+		std::sort(clearances.begin(), clearances.end(), [](const Clearance& a, const Clearance& b) {
+			if (a.colliding != b.colliding)
+				return a.colliding;
+			return a.distance < b.distance;
+		});
+
+		return clearances;
+	}
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "Bvh.h"
+#include "Layout.h"
+#include "Primitive.h"
+
+namespace ArmatureJoint {
+	// The smallest clearance found between two joints of an armature. Negative or colliding means they intersect.
+	struct Clearance {
+		int a;
+		int b;
+		double distance;
+		bool colliding;
+	};
+
+	// Interference between the joints of a whole armature, from their analytic solids rather than the B-rep.
+	// Each joint can be given a motion margin that inflates its solids to cover the range it moves through.
+	class Interference {
+	public:
+		Interference();
+
+		int add(const Layout& layout, const Transform& placement, double margin);
+		void move(int joint, const Transform& placement);
+		int count() const;
+
+		// Every pair of joints closer than range, nearest first.
+		std::vector<Clearance> check(double range);
+
+		// Only the pairs involving one joint, which is all that can change after moving it.
+		std::vector<Clearance> check(int joint, double range);
+
+	private:
+		struct Joint {
+			std::vector<Primitive> local;
+			double margin;
+			int first;
+		};
+
+		std::vector<Joint> joints;
+		std::vector<Primitive> primitives;
+		Bvh bvh;
+		bool built;
+
+		void build();
+		Aabb bounds(const Primitive& primitive) const;
+		void measure(int a, int b, std::map<std::pair<int, int>, Clearance>& found) const;
+		static std::vector<Clearance> sorted(const std::map<std::pair<int, int>, Clearance>& found, double range);
+	};
+}
@@ -0,0 +1,50 @@
+#include "InterferenceCommandCreated.h"
+
+#include "UI.h"
+#include "Units.h"
+
+namespace ArmatureJoint {
+	void InterferenceCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto inputs = cmd->commandInputs();
+		if (!inputs)
+			return;
+
+		auto marginInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_INTERFERENCE_MARGIN_INPUT_ID,
+			"Motion Margin",
+			ValueInput::createByReal(0)
+		);
+		if (!marginInput)
+			return;
+
+		marginInput->tooltip("Grows every joint by this much to cover the range it moves through");
+
+		auto rangeInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_INTERFERENCE_RANGE_INPUT_ID,
+			"Report Clearance Below",
+			ValueInput::createByReal((1_mm).centimetres())
+		);
+		if (!rangeInput)
+			return;
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "InterferenceCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class InterferenceCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<InterferenceCommandExecuted> _onExecute;
+
+	public:
+		InterferenceCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<InterferenceCommandExecuted>(new InterferenceCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
@@ -0,0 +1,103 @@
+#include "InterferenceCommandExecuted.h"
+
+#include "Interference.h"
+#include "JointAttributes.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		const size_t maxReported = 25;
+
+		double distanceValue(Ptr<CommandInputs> inputs, const char* id) {
+			auto input = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(id));
+			return input ? input->value() : 0;
+		}
+	}
+
+	void InterferenceCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto command = eventArgs->command();
+		if (!command)
+			return;
+
+		auto inputs = command->commandInputs();
+		if (!inputs)
+			return;
+
+		auto margin = distanceValue(inputs, ARMATURE_JOINT_INTERFERENCE_MARGIN_INPUT_ID);
+		auto range = distanceValue(inputs, ARMATURE_JOINT_INTERFERENCE_RANGE_INPUT_ID);
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto root = design->rootComponent();
+		if (!root)
+			return;
+
+		auto unitsManager = design->unitsManager();
+		if (!unitsManager)
+			return;
+
+		auto ui = app->userInterface();
+		if (!ui)
+			return;
+
+		// A joint component can be placed several times, so every occurrence is its own solid set.
+		Interference interference;
+		vector<std::string> names;
+		for (auto& component : JointAttributes::joints(design)) {
+			JointSpec spec;
+			if (!JointAttributes::readSpec(component, spec))
+				continue;
+
+			Layout layout(spec);
+
+			auto occurrences = root->allOccurrencesByComponent(component);
+			for (size_t i = 0; occurrences && i < occurrences->count(); i++) {
+				auto occurrence = occurrences->item(i);
+				if (!occurrence || !occurrence->transform2())
+					continue;
+
+				auto matrix = occurrence->transform2()->asArray();
+				if (matrix.size() != 16)
+					continue;
+
+				std::array<double, 16> placement;
+				std::copy(matrix.begin(), matrix.end(), placement.begin());
+
+				interference.add(layout, Transform(placement), margin);
+				names.push_back(occurrence->name());
+			}
+		}
+
+		if (interference.count() < 2) {
+			ui->messageBox("There are fewer than two armature joints to check.", "Check Armature Interference");
+			return;
+		}
+
+		auto clearances = interference.check(range);
+		if (clearances.empty()) {
+			ui->messageBox("No joints collide or come within " + unitsManager->formatInternalValue(range) + " of each other.", "Check Armature Interference");
+			return;
+		}
+
+		std::string report;
+		for (size_t i = 0; i < clearances.size() && i < maxReported; i++) {
+			auto& clearance = clearances[i];
+			report += "\n" + names[clearance.a] + " and " + names[clearance.b] + ": ";
+			report += clearance.colliding ? std::string("collide") : unitsManager->formatInternalValue(clearance.distance) + " apart";
+		}
+
+		if (clearances.size() > maxReported)
+			report += "\n... and " + std::to_string(clearances.size() - maxReported) + " more";
+
+		ui->messageBox(std::to_string(clearances.size()) + " pairs of joints are too close:" + report, "Check Armature Interference");
+	}
+}
@@ -0,0 +1,160 @@
+#include "JointAttributes.h"
+
+#include "JointParameters.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		void addRole(map<std::string, Ptr<Base>>& roles, Ptr<Attributes> attributes, Ptr<Base> entity) {
+			if (!attributes)
+				return;
+
+			auto attribute = attributes->itemByName(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_ROLE);
+			if (!attribute)
+				return;
+
+			roles[attribute->value()] = entity;
+		}
+	}
+
+	bool JointAttributes::writeSpec(Ptr<Component> component, const JointSpec& spec) {
+		if (!component)
+			return false;
+
+		auto attributes = component->attributes();
+		if (!attributes)
+			return false;
+
+		auto value = spec.toJson().dump();
+
+		auto existing = attributes->itemByName(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_SPEC);
+		if (existing)
+			return existing->value(value);
+
+		return attributes->add(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_SPEC, value) != nullptr;
+	}
+
+	bool JointAttributes::readSpec(Ptr<Component> component, JointSpec& spec) {
+		if (!component)
+			return false;
+
+		auto attributes = component->attributes();
+		if (!attributes)
+			return false;
+
+		auto attribute = attributes->itemByName(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_SPEC);
+		if (!attribute)
+			return false;
+
+		Json json;
+		std::string error;
+		if (!Json::parse(attribute->value(), json, error))
+			return false;
+
+		// Stored specs are complete and already in internal units. Bound joints are as big as their parameters say.
+		JointCell none = { ARMATURE_JOINT_OPTION_NONE, 0 };
+		return JointSpec::fromJson(json, JointSpec(), none, 1, spec, error) && JointParameters::apply(component, spec);
+	}
+
+	bool JointAttributes::tag(Ptr<Attributes> attributes, const std::string& role) {
+		if (!attributes)
+			return false;
+
+		return attributes->add(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_ROLE, role) != nullptr;
+	}
+
+	std::string JointAttributes::roleOf(Ptr<Attributes> attributes) {
+		auto attribute = attributes ? attributes->itemByName(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_ROLE) : nullptr;
+		return attribute ? attribute->value() : std::string();
+	}
+
+	std::string JointAttributes::role(const std::string& name, int a) {
+		return name + "." + std::to_string(a);
+	}
+
+	std::string JointAttributes::role(const std::string& name, int a, int b) {
+		return role(name, a) + "." + std::to_string(b);
+	}
+
+	std::string JointAttributes::role(const std::string& name, int a, int b, int c) {
+		return role(name, a, b) + "." + std::to_string(c);
+	}
+
+	// Every generated joint in the design, found through the attribute index rather than by walking the assembly.
+	vector<Ptr<Component>> JointAttributes::joints(Ptr<Design> design) {
+		vector<Ptr<Component>> joints;
+		if (!design)
+			return joints;
+
+		for (auto& attribute : design->findAttributes(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_SPEC)) {
+			if (!attribute)
+				continue;
+
+			auto component = static_cast<Ptr<Component>>(attribute->parent());
+			if (component)
+				joints.push_back(component);
+		}
+
+		return joints;
+	}
+
+	map<std::string, Ptr<Base>> JointAttributes::roles(Ptr<Component> component) {
+		map<std::string, Ptr<Base>> roles;
+		if (!component)
+			return roles;
+
+		auto planes = component->constructionPlanes();
+		for (size_t i = 0; planes && i < planes->count(); i++) {
+			auto plane = planes->item(i);
+			if (plane)
+				addRole(roles, plane->attributes(), plane);
+		}
+
+		auto bodies = component->bRepBodies();
+		for (size_t i = 0; bodies && i < bodies->count(); i++) {
+			auto body = bodies->item(i);
+			if (body)
+				addRole(roles, body->attributes(), body);
+		}
+
+		auto features = component->features();
+		for (size_t i = 0; features && i < features->count(); i++) {
+			auto feature = features->item(i);
+			if (feature)
+				addRole(roles, feature->attributes(), feature);
+		}
+
+		auto sketches = component->sketches();
+		for (size_t i = 0; sketches && i < sketches->count(); i++) {
+			auto sketch = sketches->item(i);
+			if (!sketch)
+				continue;
+
+			addRole(roles, sketch->attributes(), sketch);
+
+			auto curves = sketch->sketchCurves();
+			if (!curves)
+				continue;
+
+			auto lines = curves->sketchLines();
+			for (size_t j = 0; lines && j < lines->count(); j++) {
+				auto line = lines->item(j);
+				if (!line)
+					continue;
+
+				addRole(roles, line->attributes(), line);
+				addRole(roles, line->startSketchPoint()->attributes(), line->startSketchPoint());
+				addRole(roles, line->endSketchPoint()->attributes(), line->endSketchPoint());
+			}
+
+			auto circles = curves->sketchCircles();
+			for (size_t j = 0; circles && j < circles->count(); j++) {
+				auto circle = circles->item(j);
+				if (circle)
+					addRole(roles, circle->attributes(), circle);
+			}
+		}
+
+		return roles;
+	}
+}
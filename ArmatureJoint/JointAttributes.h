@@ -0,0 +1,38 @@
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+#include <map>
+#include <vector>
+#include <string>
+
+#include "JointSpec.h"
+
+#define ARMATURE_JOINT_ATTRIBUTE_GROUP "ArmatureJoint"
+#define ARMATURE_JOINT_ATTRIBUTE_SPEC "spec"
+#define ARMATURE_JOINT_ATTRIBUTE_ROLE "role"
+#define ARMATURE_JOINT_ATTRIBUTE_LEAN "lean"
+
+using namespace std;
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace ArmatureJoint {
+	// The joint spec is stored on each generated component, and every generated sketch entity, plane and feature
+	// is tagged with a role so the joint can later be found and updated in place.
+	class JointAttributes {
+	public:
+		static bool writeSpec(Ptr<Component> component, const JointSpec& spec);
+		static bool readSpec(Ptr<Component> component, JointSpec& spec);
+
+		static bool tag(Ptr<Attributes> attributes, const std::string& role);
+		static std::string roleOf(Ptr<Attributes> attributes);
+		static std::string role(const std::string& name, int a);
+		static std::string role(const std::string& name, int a, int b);
+		static std::string role(const std::string& name, int a, int b, int c);
+
+		static map<std::string, Ptr<Base>> roles(Ptr<Component> component);
+		static vector<Ptr<Component>> joints(Ptr<Design> design);
+	};
+}
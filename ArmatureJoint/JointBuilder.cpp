@@ -0,0 +1,626 @@
+#include "JointBuilder.h"
+
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include <string>
+#include <vector>
+
+#include "DeferredCompute.h"
+#include "JointAttributes.h"
+#include "JointPlate.h"
+#include "UI.h"
+#include "Validator.h"
+
+namespace ArmatureJoint {
+	namespace {
+		template<class T, class C> vector<Ptr<T>> itemsOf(Ptr<C> collection) {
+			vector<Ptr<T>> items;
+			for (size_t i = 0; i < collection->count(); i++)
+				items.push_back(collection->item(i));
+			return items;
+		}
+
+		// Newest first, so nothing is deleted while a later item still refers to it.
+		template<class T> bool deleteAll(const vector<Ptr<T>>& items) {
+			for (auto item = items.rbegin(); item != items.rend(); item++) {
+				if (*item && !(*item)->deleteMe())
+					return false;
+			}
+			return true;
+		}
+	}
+
+	shared_ptr<JointBuilder> JointBuilder::create(Ptr<Design> _design) {
+		if (!_design)
+			return nullptr;
+
+		auto builder = shared_ptr<JointBuilder>(new JointBuilder(_design));
+
+		builder->rootComponent = _design->rootComponent();
+		if (!builder->rootComponent)
+			return nullptr;
+
+		builder->occurrences = builder->rootComponent->occurrences();
+		if (!builder->occurrences)
+			return nullptr;
+
+		return builder;
+	}
+
+	bool JointBuilder::validate(Ptr<Component> component, shared_ptr<Values> values) {
+		_rejection.clear();
+		if (!values)
+			return false;
+
+		if (!JointParameters::bound(component))
+			JointParameters::adopt(design, parameterMode, values);
+
+		return Validator::validate(*values, _rejection);
+	}
+
+	const std::string& JointBuilder::rejection() const {
+		return _rejection;
+	}
+
+	Ptr<Occurrence> JointBuilder::build(shared_ptr<Values> values) {
+		if (!validate(nullptr, values))
+			return nullptr;
+
+		auto transform = Matrix3D::create();
+		if (!transform)
+			return nullptr;
+
+		auto& placement = values->spec().transform;
+		if (!transform->setWithArray(std::vector<double>(placement.begin(), placement.end())))
+			return nullptr;
+
+		auto occur = occurrences->addNewComponent(transform);
+		if (!occur)
+			return nullptr;
+
+		auto component = occur->component();
+		if (!component)
+			return nullptr;
+
+		// A joint that cannot be generated leaves no component behind, nor parameters that would push the next
+		// attempt onto another prefix.
+		shared_ptr<JointParameters> parameters;
+		if (!generate(component, values, parameters)) {
+			occur->deleteMe();
+			if (parameters)
+				parameters->discard();
+			return nullptr;
+		}
+
+		return occur;
+	}
+
+	// Builds every spec that validates, and lists the others with the reason each could not be built.
+	std::string JointBuilder::build(const vector<JointSpec>& specs) {
+		std::string failed;
+		for (auto& spec : specs) {
+			auto values = Values::create(spec);
+			if (!values) {
+				failed += "\n" + spec.name;
+				continue;
+			}
+
+			if (!build(values))
+				failed += "\n" + spec.name + (_rejection.empty() ? "" : ": " + _rejection);
+		}
+		return failed;
+	}
+
+	void JointBuilder::parameters(JointParameters::Mode mode) {
+		parameterMode = mode;
+	}
+
+	void JointBuilder::lean(bool collapse) {
+		leanOutput = collapse;
+	}
+
+	int JointBuilder::collapsed() const {
+		return collapsedItems;
+	}
+
+	bool JointBuilder::generate(Ptr<Component> component, shared_ptr<Values> values) {
+		shared_ptr<JointParameters> parameters;
+		return generate(component, values, parameters);
+	}
+
+	bool JointBuilder::generate(Ptr<Component> component, shared_ptr<Values> values, shared_ptr<JointParameters>& parameters) {
+		// Bound joints have their parameters set to the new sizes before anything is drawn.
+		if (parameterMode != JointParameters::None || JointParameters::bound(component)) {
+			parameters = JointParameters::create(design, component, parameterMode, values);
+			if (!parameters)
+				return false;
+		}
+
+		if (!component->name(values->name()))
+			return false;
+
+		if (!JointAttributes::writeSpec(component, values->spec()))
+			return false;
+
+		auto planes = component->constructionPlanes();
+		if (!planes)
+			return false;
+
+		auto planeInput = planes->createInput(component->xZConstructionPlane());
+		if (!planeInput)
+			return false;
+
+		planeInput->setByOffset(component->xZConstructionPlane(), ValueInput::createByReal(values->ballZ() + values->plateOffset()));
+
+		auto plane = planes->add(planeInput);
+		if (!plane)
+			return false;
+
+		if (!plane->name("Joint Top Offset"))
+			return false;
+
+		JointAttributes::tag(plane->attributes(), "topOffsetPlane");
+
+		auto bottom = JointPlate::create(component, component->xZConstructionPlane(), values, false);
+		if (!bottom)
+			return false;
+
+		auto top = JointPlate::create(component, plane, values, true);
+		if (!top)
+			return false;
+
+		if (!createJointBall(component, values))
+			return false;
+
+		if (!createJointNuts(component, values))
+			return false;
+
+		if (parameters)
+			return parameters->bind(component);
+
+		auto attributes = component->attributes();
+		if (!leanOutput && !(attributes && attributes->itemByName(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_LEAN)))
+			return true;
+
+		return collapse(component) >= 0;
+	}
+
+	int JointBuilder::collapse(Ptr<Component> component) {
+		if (!component || JointParameters::bound(component))
+			return -1;
+
+		auto features = component->features();
+		auto sketches = component->sketches();
+		auto planes = component->constructionPlanes();
+		auto bodies = component->bRepBodies();
+		auto attributes = component->attributes();
+		auto manager = TemporaryBRepManager::get();
+		if (!features || !sketches || !planes || !bodies || !attributes || !manager)
+			return -1;
+
+		// The history is only removed once the copies are in, so a joint that cannot be collapsed is left as it was.
+		auto oldFeatures = itemsOf<Feature>(features);
+		auto oldSketches = itemsOf<Sketch>(sketches);
+		auto oldPlanes = itemsOf<ConstructionPlane>(planes);
+		auto oldBodies = itemsOf<BRepBody>(bodies);
+		auto items = (int)(oldFeatures.size() + oldSketches.size() + oldPlanes.size());
+
+		// Copies outlive the features that made the bodies, and take their names and roles with them.
+		vector<Ptr<BRepBody>> copies;
+		vector<std::string> names;
+		vector<std::string> roles;
+		for (auto& body : oldBodies) {
+			auto copy = body ? manager->copy(body) : nullptr;
+			if (!copy)
+				return -1;
+
+			copies.push_back(copy);
+			names.push_back(body->name());
+			roles.push_back(JointAttributes::roleOf(body->attributes()));
+		}
+
+		// Parametric designs only take bodies inside a base feature.
+		Ptr<BaseFeature> base;
+		if (design->designType() == DesignTypes::ParametricDesignType) {
+			auto baseFeatures = features->baseFeatures();
+			base = baseFeatures ? baseFeatures->add() : nullptr;
+			if (!base)
+				return -1;
+
+			if (!base->startEdit()) {
+				base->deleteMe();
+				return -1;
+			}
+
+			base->name("Joint Bodies");
+		}
+
+		vector<Ptr<BRepBody>> added;
+		for (size_t i = 0; i < copies.size(); i++) {
+			auto body = bodies->add(copies[i], base);
+			if (!body)
+				break;
+
+			added.push_back(body);
+			body->name(names[i]);
+			if (!roles[i].empty())
+				JointAttributes::tag(body->attributes(), roles[i]);
+		}
+
+		auto finished = !base || base->finishEdit();
+		if (added.size() < copies.size() || !finished) {
+			if (base)
+				base->deleteMe();
+			else
+				deleteAll(added);
+			return -1;
+		}
+
+		if (!deleteAll(oldFeatures) || !deleteAll(oldSketches) || !deleteAll(oldPlanes) || !deleteAll(oldBodies))
+			return -1;
+
+		if (!attributes->itemByName(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_LEAN) && !attributes->add(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_LEAN, "true"))
+			return -1;
+
+		auto removed = items - (base ? 1 : 0);
+		collapsedItems += removed;
+		return removed;
+	}
+
+	bool JointBuilder::clear(Ptr<Component> component) {
+		auto features = component->features();
+		auto sketches = component->sketches();
+		auto planes = component->constructionPlanes();
+		auto bodies = component->bRepBodies();
+		if (!features || !sketches || !planes || !bodies)
+			return false;
+
+		return
+			deleteAll(itemsOf<Feature>(features)) &&
+			deleteAll(itemsOf<Sketch>(sketches)) &&
+			deleteAll(itemsOf<ConstructionPlane>(planes)) &&
+			deleteAll(itemsOf<BRepBody>(bodies));
+	}
+
+	bool JointBuilder::createJointNuts(Ptr<Component> component, shared_ptr<Values> values) {
+		auto planes = component->constructionPlanes();
+		if (!planes)
+			return false;
+
+		for (auto col = 1; col <= values->cols(); col++) {
+			auto planeInput = planes->createInput(component->xZConstructionPlane());
+			if (!planeInput)
+				return false;
+
+			planeInput->setByOffset(component->yZConstructionPlane(), ValueInput::createByReal(values->ballX(col)));
+
+			auto plane = planes->add(planeInput);
+			if (!plane)
+				return false;
+
+			plane->name("Joint Nuts " + std::to_string(col));
+			JointAttributes::tag(plane->attributes(), JointAttributes::role("nutPlane", col));
+
+			auto sketches = component->sketches();
+			if (!sketches)
+				return false;
+
+			auto sketch = sketches->add(plane);
+			if (!sketch)
+				return false;
+
+			sketch->name("Joint Nuts Sketch" + std::to_string(col));
+			JointAttributes::tag(sketch->attributes(), JointAttributes::role("nutSketch", col));
+
+			auto added = 0;
+
+			// Every hex and bolt circle goes in before the sketch is solved, once.
+			DeferredCompute deferred(sketch);
+			if (!deferred.deferred())
+				return false;
+
+			auto curves = sketch->sketchCurves();
+			if (!curves)
+				return false;
+
+			auto lines = curves->sketchLines();
+			if (!lines)
+				return false;
+
+			auto circles = curves->sketchCircles();
+			if (!circles)
+				return false;
+
+			for (auto row = 1; row <= values->rows(); row++) {
+				auto jointType = values->jointType(row, col);
+
+				if (jointType != ARMATURE_JOINT_OPTION_NUT)
+					continue;
+
+				added++;
+
+				auto centre = Point3D::create(values->ballY(row), values->ballZ(), 0);
+				if (!centre)
+					return false;
+
+				// Each side starts where the last one ended, so the hex is closed without coincident constraints.
+				Ptr<SketchLine> sides[6];
+				for (auto i = 0; i < 6; i++) {
+					Ptr<Base> start;
+					if (i == 0)
+						start = values->nutPoint(row, i);
+					else
+						start = sides[i - 1]->endSketchPoint();
+
+					Ptr<Base> end;
+					if (i == 5)
+						end = sides[0]->startSketchPoint();
+					else
+						end = values->nutPoint(row, i + 1);
+
+					sides[i] = lines->addByTwoPoints(start, end);
+					if (!sides[i])
+						return false;
+
+					JointAttributes::tag(sides[i]->attributes(), JointAttributes::role("nutLine", row, col, i));
+				}
+
+				auto circle = circles->addByCenterRadius(centre, values->boltHoleRadius());
+				if (!circle)
+					return false;
+
+				JointAttributes::tag(circle->attributes(), JointAttributes::role("nutCircle", row, col));
+			}
+
+			if (added == 0) {
+				deferred.finish();
+				sketch->deleteMe();
+				plane->deleteMe();
+				continue;
+			}
+
+			if (!deferred.finish())
+				return false;
+
+			auto features = component->features();
+			if (!features)
+				return false;
+
+			auto extrudes = features->extrudeFeatures();
+			if (!extrudes)
+				return false;
+
+			auto profiles = sketch->profiles();
+			if (!profiles)
+				return false;
+
+			auto boltArea = values->boltCircleArea();
+			auto boltDelta = boltArea * 0.005;
+
+			for (auto i = 0; i < profiles->count(); i++) {
+				auto profile = profiles->item(i);
+				if (!profile)
+					return false;
+
+				auto areaProps = profile->areaProperties();
+				if (!areaProps)
+					return false;
+
+				auto area = areaProps->area();
+				if (area > (boltArea - boltDelta) && area < (boltArea + boltDelta))
+					continue;
+
+				auto extrudeInput = extrudes->createInput(profile, FeatureOperations::NewBodyFeatureOperation);
+				if (!extrudeInput)
+					return false;
+
+				extrudeInput->setSymmetricExtent(ValueInput::createByReal(values->ballRadius() / 2), false, 0);
+
+				auto extrude = extrudes->add(extrudeInput);
+				if (!extrude)
+					return false;
+
+				JointAttributes::tag(extrude->attributes(), JointAttributes::role("nutExtrude", col, i));
+			}
+		}
+
+		return true;
+	}
+
+	bool JointBuilder::createJointBall(Ptr<Component> component, shared_ptr<Values> values) {
+		auto planes = component->constructionPlanes();
+		if (!planes)
+			return false;
+
+		auto planeInput = planes->createInput(component->xZConstructionPlane());
+		if (!planeInput)
+			return false;
+
+		planeInput->setByOffset(component->xZConstructionPlane(), ValueInput::createByReal(values->ballZ()));
+
+		auto plane = planes->add(planeInput);
+		if (!plane)
+			return false;
+
+		plane->name("Joint Balls");
+		JointAttributes::tag(plane->attributes(), "ballPlane");
+
+		auto sketches = component->sketches();
+		if (!sketches)
+			return false;
+
+		for (auto row = 1; row <= values->rows(); row++) {
+			for (auto col = 1; col <= values->cols(); col++) {
+				if (values->jointType(row, col) != ARMATURE_JOINT_OPTION_BALL)
+					continue;
+				
+				auto sketch = sketches->add(plane);
+				if (!sketch)
+					return false;
+
+				if (!sketch->name("Ball Circles"))
+					return false;
+
+				JointAttributes::tag(sketch->attributes(), JointAttributes::role("ballSketch", row, col));
+
+				DeferredCompute deferred(sketch);
+				if (!deferred.deferred())
+					return false;
+
+				auto curves = sketch->sketchCurves();
+				if (!curves)
+					return false;
+
+				auto circles = curves->sketchCircles();
+				if (!circles)
+					return false;
+
+				auto ballDiameterCircle = circles->addByCenterRadius(
+					Point3D::create(
+						values->ballX(col),
+						values->ballY(row),
+						0
+					),
+					values->ballRadius()
+				);
+				if (!ballDiameterCircle)
+					return false;
+
+				JointAttributes::tag(ballDiameterCircle->attributes(), JointAttributes::role("ballCircle", row, col));
+
+				auto ballLines = curves->sketchLines();
+				if (!ballLines)
+					return false;
+
+				// The revolve axis is the diameter across the screw hole, so the hole's plane can be set square to the
+				// sketch through it: vertical for holes along x, horizontal for holes down the rows.
+				auto direction = values->ballHoleDirection(row, col);
+				auto reach = values->ballRadius();
+				auto ballLine = direction.x != 0
+					? ballLines->addByTwoPoints(
+						Point3D::create(values->ballX(col), values->ballY(row) - reach, 0),
+						Point3D::create(values->ballX(col), values->ballY(row) + reach, 0))
+					: ballLines->addByTwoPoints(
+						Point3D::create(values->ballX(col) - reach, values->ballY(row), 0),
+						Point3D::create(values->ballX(col) + reach, values->ballY(row), 0));
+
+				if (!ballLine)
+					return false;
+
+				JointAttributes::tag(ballLine->attributes(), JointAttributes::role("ballAxis", row, col));
+
+				if (!deferred.finish())
+					return false;
+
+				auto ballProfiles = sketch->profiles();
+				if (!ballProfiles)
+					return false;
+
+				auto ballProfile = ballProfiles->item(0);
+				if (!ballProfile)
+					return false;
+
+				auto features = component->features();
+				if (!features)
+					return false;
+
+				auto revolves = features->revolveFeatures();
+				if (!revolves)
+					return false;
+
+				auto revolveInput = revolves->createInput(ballProfile, ballLine, FeatureOperations::NewBodyFeatureOperation);
+				if (!revolveInput)
+					return false;
+
+				if (!revolveInput->setAngleExtent(false, ValueInput::createByString("360.0 deg")))
+					return false;
+
+				auto revolve = revolves->add(revolveInput);
+				if (!revolve)
+					return false;
+
+				JointAttributes::tag(revolve->attributes(), JointAttributes::role("ballRevolve", row, col));
+
+				auto bodies = revolve->bodies();
+				if (!bodies)
+					return false;
+
+				for (auto i = 0; i < bodies->count(); i++) {
+					auto body = bodies->item(i);
+					body->name("Ball_" + std::to_string(row) + "_" + std::to_string(col) + "_" + std::to_string(i));
+				}
+
+				auto ballHolePlaneInput = planes->createInput();
+				if (!ballHolePlaneInput)
+					return false;
+
+				if (!ballHolePlaneInput->setByAngle(ballLine, ValueInput::createByString("90.0 deg"), ballProfile))
+					return false;
+
+				auto ballHolePlane = planes->add(ballHolePlaneInput);
+				if (!ballHolePlane)
+					return false;
+
+				if (!ballHolePlane->name("Ball Screw Hole"))
+					return false;
+
+				JointAttributes::tag(ballHolePlane->attributes(), JointAttributes::role("ballHolePlane", row, col));
+
+				auto holeSketch = sketches->add(ballHolePlane);
+				if (!holeSketch)
+					return false;
+
+				if (!holeSketch->name("Ball Screw Hole"))
+					return false;
+
+				auto holeCurves = holeSketch->sketchCurves();
+				if (!holeCurves)
+					return false;
+
+				auto holeCircles = holeCurves->sketchCircles();
+				if (!holeCircles)
+					return false;
+
+				auto ballHoleCircle = holeCircles->addByCenterRadius(
+					Point3D::create(0, 0, 0),
+					values->holeRadius(row, col)
+				);
+				if (!ballHoleCircle)
+					return false;
+
+				JointAttributes::tag(ballHoleCircle->attributes(), JointAttributes::role("ballHoleCircle", row, col));
+
+				auto holeProfiles = holeSketch->profiles();
+				if (!holeProfiles)
+					return false;
+
+				auto holeProfile = holeProfiles->item(0);
+				if (!holeProfile)
+					return false;
+
+				auto extrudes = features->extrudeFeatures();
+				if (!extrudes)
+					return false;
+
+				auto holeExtrudeInput = extrudes->createInput(holeProfile, FeatureOperations::CutFeatureOperation);
+				if (!holeExtrudeInput)
+					return false;
+
+				// The hole plane's normal turns the sketch normal a quarter round the axis: +x from a vertical axis, and
+				// -y in the sketch, down the rows, from a horizontal one.
+				auto radius = values->ballRadius() * (direction.x + direction.z);
+
+				holeExtrudeInput->setDistanceExtent(false, ValueInput::createByReal(radius));
+
+				auto holeExtrude = extrudes->add(holeExtrudeInput);
+				if (!holeExtrude)
+					return false;
+
+				JointAttributes::tag(holeExtrude->attributes(), JointAttributes::role("ballHoleExtrude", row, col));
+			}
+		}
+
+		return true;
+	}
+}
\ No newline at end of file
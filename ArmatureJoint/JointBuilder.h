@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+#include "JointParameters.h"
+#include "Values.h"
+
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace ArmatureJoint {
+	// Generates joint components into a design. The design lookups are done once, so one builder can generate many joints.
+	class JointBuilder {
+	private:
+		Ptr<Design> design;
+		Ptr<Component> rootComponent;
+		Ptr<Occurrences> occurrences;
+		JointParameters::Mode parameterMode;
+		bool leanOutput;
+		int collapsedItems;
+		std::string _rejection; // why the last joint failed validation
+
+		bool generate(Ptr<Component> component, shared_ptr<Values> values, shared_ptr<JointParameters>& parameters);
+		bool createJointBall(Ptr<Component> component, shared_ptr<Values> values);
+		bool createJointNuts(Ptr<Component> component, shared_ptr<Values> values);
+
+	public:
+		static shared_ptr<JointBuilder> create(Ptr<Design> _design);
+
+		JointBuilder(Ptr<Design> _design) {
+			design = _design;
+			parameterMode = JointParameters::None;
+			leanOutput = false;
+			collapsedItems = 0;
+		}
+
+		// New joints are bound to user parameters in this mode. Joints already bound stay bound whatever it is.
+		void parameters(JointParameters::Mode mode);
+
+		// New joints keep only their final bodies. Joints generated lean stay lean when they are regenerated, and
+		// joints bound to parameters keep their history, which the parameters drive.
+		void lean(bool collapse);
+		int collapsed() const;
+
+		// Checks a joint at the sizes it will be generated with, before anything is added to the design. Building
+		// validates; callers that generate into an existing component validate it first.
+		bool validate(Ptr<Component> component, shared_ptr<Values> values);
+		const std::string& rejection() const;
+
+		Ptr<Occurrence> build(shared_ptr<Values> values);
+		std::string build(const vector<JointSpec>& specs);
+		bool generate(Ptr<Component> component, shared_ptr<Values> values);
+
+		// Replaces a joint's planes, sketches and features with its bodies, in a single base feature in parametric
+		// designs. Returns the number of history items removed, or -1 when the joint could not be collapsed.
+		int collapse(Ptr<Component> component);
+
+		static bool clear(Ptr<Component> component);
+	};
+}
@@ -0,0 +1,313 @@
+#include "JointEditor.h"
+
+#include <math.h>
+
+#include "JointAttributes.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		const double tolerance = 1e-9;
+
+		template<class T> Ptr<T> find(map<std::string, Ptr<Base>>& roles, const std::string& role) {
+			auto found = roles.find(role);
+			if (found == roles.end())
+				return nullptr;
+
+			return static_cast<Ptr<T>>(found->second);
+		}
+
+		// Parameters and geometry are only touched when they actually change, so untouched features are not recomputed.
+		bool setParameter(Ptr<ModelParameter> parameter, double value) {
+			if (!parameter)
+				return false;
+
+			if (fabs(parameter->value() - value) < tolerance)
+				return true;
+
+			return parameter->value(value);
+		}
+
+		bool movePoint(Ptr<SketchPoint> point, double x, double y) {
+			if (!point)
+				return false;
+
+			auto geometry = point->geometry();
+			if (!geometry)
+				return false;
+
+			auto dx = x - geometry->x();
+			auto dy = y - geometry->y();
+			if (fabs(dx) < tolerance && fabs(dy) < tolerance)
+				return true;
+
+			return point->move(Vector3D::create(dx, dy, 0));
+		}
+
+		bool setCircle(Ptr<SketchCircle> circle, double x, double y, double radius) {
+			if (!circle)
+				return false;
+
+			if (!movePoint(circle->centerSketchPoint(), x, y))
+				return false;
+
+			if (fabs(circle->radius() - radius) < tolerance)
+				return true;
+
+			return circle->radius(radius);
+		}
+
+		bool setPlaneOffset(Ptr<ConstructionPlane> plane, double offset) {
+			if (!plane)
+				return false;
+
+			auto definition = static_cast<Ptr<ConstructionPlaneOffsetDefinition>>(plane->definition());
+			if (!definition)
+				return false;
+
+			return setParameter(definition->offset(), offset);
+		}
+
+		bool setExtrudeDistance(Ptr<ExtrudeFeature> extrude, double distance) {
+			if (!extrude)
+				return false;
+
+			auto extent = extrude->extentOne();
+
+			auto symmetric = static_cast<Ptr<SymmetricExtentDefinition>>(extent);
+			if (symmetric)
+				return setParameter(symmetric->distance(), distance);
+
+			auto oneSide = static_cast<Ptr<DistanceExtentDefinition>>(extent);
+			if (!oneSide || !oneSide->distance())
+				return false;
+
+			// Keep the direction the feature was created with.
+			return setParameter(oneSide->distance(), oneSide->distance()->value() < 0 ? -fabs(distance) : fabs(distance));
+		}
+	}
+
+	shared_ptr<JointEditor> JointEditor::create(Ptr<Design> design) {
+		auto builder = JointBuilder::create(design);
+		if (!builder)
+			return nullptr;
+
+		return shared_ptr<JointEditor>(new JointEditor(builder));
+	}
+
+	bool JointEditor::update(Ptr<Component> component, shared_ptr<Values> values) {
+		if (!component || !values)
+			return false;
+
+		// Leave the joint as it is rather than half rebuilt.
+		if (!builder->validate(component, values))
+			return false;
+
+		// The dialog does not carry the placement, so keep the one the joint was generated with.
+		JointSpec current;
+		auto stored = JointAttributes::readSpec(component, current);
+		if (stored)
+			values->placement(current.transform);
+
+		if (!stored || !sameLayout(current, values->spec())) {
+			if (!JointBuilder::clear(component))
+				return false;
+
+			return builder->generate(component, values);
+		}
+
+		// Bound joints are resized through their parameters and left to recompute.
+		if (JointParameters::bound(component)) {
+			if (!JointParameters::update(component, current, values->spec())) {
+				if (!JointBuilder::clear(component))
+					return false;
+
+				return builder->generate(component, values);
+			}
+
+			if (!component->name(values->name()))
+				return false;
+
+			return JointAttributes::writeSpec(component, values->spec());
+		}
+
+		auto roles = JointAttributes::roles(component);
+
+		auto inPlace =
+			setPlaneOffset(find<ConstructionPlane>(roles, "topOffsetPlane"), values->ballZ() + values->plateOffset()) &&
+			updatePlate(roles, "bottomPlate.", values) &&
+			updatePlate(roles, "topPlate.", values) &&
+			updateBalls(roles, values) &&
+			updateNuts(roles, values);
+
+		// Joints whose history was changed by hand, or is incomplete, are regenerated rather than left half edited.
+		if (!inPlace) {
+			if (!JointBuilder::clear(component))
+				return false;
+
+			return builder->generate(component, values);
+		}
+
+		if (!component->name(values->name()))
+			return false;
+
+		return JointAttributes::writeSpec(component, values->spec());
+	}
+
+	bool JointEditor::sameLayout(const JointSpec& a, const JointSpec& b) {
+		if (a.rows != b.rows || a.cols != b.cols || a.cells.size() != b.cells.size())
+			return false;
+
+		for (size_t i = 0; i < a.cells.size(); i++) {
+			if (a.cells[i].type != b.cells[i].type)
+				return false;
+		}
+
+		return true;
+	}
+
+	const std::string& JointEditor::rejection() const {
+		return builder->rejection();
+	}
+
+	bool JointEditor::updatePlate(map<std::string, Ptr<Base>>& roles, const std::string& plate, shared_ptr<Values> values) {
+		if (!movePoint(find<SketchPoint>(roles, plate + "corner"), values->length(), -values->width()))
+			return false;
+
+		// Outlines drawn as a constrained rectangle follow their corner; unconstrained ones have the others tagged.
+		auto lengthCorner = find<SketchPoint>(roles, plate + "lengthCorner");
+		if (lengthCorner && !movePoint(lengthCorner, values->length(), 0))
+			return false;
+
+		auto widthCorner = find<SketchPoint>(roles, plate + "widthCorner");
+		if (widthCorner && !movePoint(widthCorner, 0, -values->width()))
+			return false;
+
+		if (!setCircle(find<SketchCircle>(roles, plate + "boltCircle"), values->length() / 2, -values->width() / 2, values->boltHoleRadius()))
+			return false;
+
+		for (auto row = 1; row <= values->rows(); row++) {
+			for (auto col = 1; col <= values->cols(); col++) {
+				if (values->jointType(row, col) != ARMATURE_JOINT_OPTION_BALL)
+					continue;
+
+				auto circle = find<SketchCircle>(roles, JointAttributes::role(plate + "seatCircle", row, col));
+				if (!setCircle(circle, values->ballX(col), values->ballY(row), values->circleRadius()))
+					return false;
+			}
+		}
+
+		if (!setExtrudeDistance(find<ExtrudeFeature>(roles, plate + "extrude"), values->thickness()))
+			return false;
+
+		// Plates without ball seats have no chamfer.
+		auto chamfer = find<ChamferFeature>(roles, plate + "chamfer");
+		if (chamfer) {
+			auto definition = static_cast<Ptr<DistanceAndAngleChamferTypeDefinition>>(chamfer->chamferTypeDefinition());
+			if (!definition)
+				return false;
+
+			if (!setParameter(definition->distance(), values->chamferLength()))
+				return false;
+
+			if (!setParameter(definition->angle(), values->chamferAngle()))
+				return false;
+		}
+
+		auto fillet = find<FilletFeature>(roles, plate + "fillet");
+		if (!fillet)
+			return false;
+
+		auto edgeSets = fillet->edgeSets();
+		if (!edgeSets || edgeSets->count() < 1)
+			return false;
+
+		auto edgeSet = static_cast<Ptr<ConstantRadiusFilletEdgeSet>>(edgeSets->item(0));
+		if (!edgeSet)
+			return false;
+
+		return setParameter(edgeSet->radius(), values->ballRadius());
+	}
+
+	bool JointEditor::updateBalls(map<std::string, Ptr<Base>>& roles, shared_ptr<Values> values) {
+		if (values->numJointTypes(ARMATURE_JOINT_OPTION_BALL) == 0)
+			return true;
+
+		if (!setPlaneOffset(find<ConstructionPlane>(roles, "ballPlane"), values->ballZ()))
+			return false;
+
+		for (auto row = 1; row <= values->rows(); row++) {
+			for (auto col = 1; col <= values->cols(); col++) {
+				if (values->jointType(row, col) != ARMATURE_JOINT_OPTION_BALL)
+					continue;
+
+				auto x = values->ballX(col);
+				auto y = values->ballY(row);
+				auto radius = values->ballRadius();
+
+				if (!setCircle(find<SketchCircle>(roles, JointAttributes::role("ballCircle", row, col)), x, y, radius))
+					return false;
+
+				auto axis = find<SketchLine>(roles, JointAttributes::role("ballAxis", row, col));
+				if (!axis)
+					return false;
+
+				auto vertical = values->ballHoleDirection(row, col).x != 0;
+				if (!movePoint(axis->startSketchPoint(), vertical ? x : x - radius, vertical ? y - radius : y) ||
+					!movePoint(axis->endSketchPoint(), vertical ? x : x + radius, vertical ? y + radius : y))
+					return false;
+
+				auto hole = find<SketchCircle>(roles, JointAttributes::role("ballHoleCircle", row, col));
+				if (!hole)
+					return false;
+
+				if (fabs(hole->radius() - values->holeRadius(row, col)) > tolerance && !hole->radius(values->holeRadius(row, col)))
+					return false;
+
+				if (!setExtrudeDistance(find<ExtrudeFeature>(roles, JointAttributes::role("ballHoleExtrude", row, col)), radius))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool JointEditor::updateNuts(map<std::string, Ptr<Base>>& roles, shared_ptr<Values> values) {
+		for (auto col = 1; col <= values->cols(); col++) {
+			auto plane = find<ConstructionPlane>(roles, JointAttributes::role("nutPlane", col));
+			if (!plane)
+				continue; // no nuts in this column
+
+			if (!setPlaneOffset(plane, values->ballX(col)))
+				return false;
+
+			for (auto row = 1; row <= values->rows(); row++) {
+				if (values->jointType(row, col) != ARMATURE_JOINT_OPTION_NUT)
+					continue;
+
+				for (auto i = 0; i < 6; i++) {
+					auto line = find<SketchLine>(roles, JointAttributes::role("nutLine", row, col, i));
+					if (!line)
+						return false;
+
+					auto start = values->nutPoint(row, i);
+					auto end = values->nutPoint(row, i + 1);
+					if (!movePoint(line->startSketchPoint(), start->x(), start->y()) || !movePoint(line->endSketchPoint(), end->x(), end->y()))
+						return false;
+				}
+
+				if (!setCircle(find<SketchCircle>(roles, JointAttributes::role("nutCircle", row, col)), values->ballY(row), values->ballZ(), values->boltHoleRadius()))
+					return false;
+			}
+
+			// Nut extrudes are tagged by the index of the profile they were made from.
+			auto prefix = JointAttributes::role("nutExtrude", col) + ".";
+			for (auto entry = roles.lower_bound(prefix); entry != roles.end() && entry->first.compare(0, prefix.size(), prefix) == 0; entry++) {
+				if (!setExtrudeDistance(static_cast<Ptr<ExtrudeFeature>>(entry->second), values->ballRadius() / 2))
+					return false;
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+#include <map>
+
+#include "JointBuilder.h"
+
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace ArmatureJoint {
+	// Updates a previously generated joint to a new spec. When the grid layout is unchanged the existing sketches, planes
+	// and feature parameters are edited in place so the bodies keep their identity; otherwise the component is regenerated.
+	class JointEditor {
+	private:
+		shared_ptr<JointBuilder> builder;
+
+		bool sameLayout(const JointSpec& a, const JointSpec& b);
+		bool updatePlate(map<std::string, Ptr<Base>>& roles, const std::string& plate, shared_ptr<Values> values);
+		bool updateBalls(map<std::string, Ptr<Base>>& roles, shared_ptr<Values> values);
+		bool updateNuts(map<std::string, Ptr<Base>>& roles, shared_ptr<Values> values);
+
+	public:
+		static shared_ptr<JointEditor> create(Ptr<Design> design);
+
+		JointEditor(shared_ptr<JointBuilder> _builder) {
+			builder = _builder;
+		}
+
+		bool update(Ptr<Component> component, shared_ptr<Values> values);
+		const std::string& rejection() const;
+	};
+}
@@ -0,0 +1,621 @@
+#include "JointParameters.h"
+
+#define _USE_MATH_DEFINES
+#include <ctype.h>
+#include <math.h>
+
+#include "Json.h"
+#include "JointAttributes.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		const double tolerance = 1e-9;
+
+		template<class T> Ptr<T> find(map<std::string, Ptr<Base>>& roles, const std::string& role) {
+			auto found = roles.find(role);
+			if (found == roles.end())
+				return nullptr;
+
+			return static_cast<Ptr<T>>(found->second);
+		}
+
+		// Parameter names are letters, digits and underscores, starting with a letter.
+		std::string identifier(const std::string& name) {
+			std::string id;
+			for (auto c : name)
+				id += isalnum((unsigned char)c) ? c : '_';
+
+			if (id.empty() || !isalpha((unsigned char)id[0]))
+				id = "joint_" + id;
+
+			return id;
+		}
+
+		// Distances keep the direction their feature was created with.
+		bool drive(Ptr<ModelParameter> parameter, const std::string& expression) {
+			if (!parameter)
+				return false;
+
+			return parameter->expression(parameter->value() < 0 ? "-" + expression : expression);
+		}
+
+		bool drive(Ptr<SketchDimension> dimension, const std::string& expression) {
+			return dimension && drive(dimension->parameter(), expression);
+		}
+
+		bool driveOffset(Ptr<ConstructionPlane> plane, const std::string& expression) {
+			if (!plane)
+				return false;
+
+			auto definition = static_cast<Ptr<ConstructionPlaneOffsetDefinition>>(plane->definition());
+			return definition && drive(definition->offset(), expression);
+		}
+
+		bool driveExtrude(Ptr<ExtrudeFeature> extrude, const std::string& expression) {
+			if (!extrude)
+				return false;
+
+			auto extent = extrude->extentOne();
+
+			auto symmetric = static_cast<Ptr<SymmetricExtentDefinition>>(extent);
+			if (symmetric)
+				return drive(symmetric->distance(), expression);
+
+			auto oneSide = static_cast<Ptr<DistanceExtentDefinition>>(extent);
+			return oneSide && drive(oneSide->distance(), expression);
+		}
+
+		// Fixes a point by its horizontal and vertical distance from the sketch origin.
+		bool place(Ptr<SketchPoint> point, const std::string& x, const std::string& y) {
+			if (!point || !point->parentSketch())
+				return false;
+
+			auto sketch = point->parentSketch();
+			auto dimensions = sketch->sketchDimensions();
+			if (!dimensions)
+				return false;
+
+			auto origin = sketch->originPoint();
+			auto text = point->geometry();
+
+			return
+				drive(dimensions->addDistanceDimension(origin, point, DimensionOrientations::HorizontalDimensionOrientation, text), x) &&
+				drive(dimensions->addDistanceDimension(origin, point, DimensionOrientations::VerticalDimensionOrientation, text), y);
+		}
+
+		bool diameter(Ptr<SketchCircle> circle, const std::string& expression) {
+			if (!circle || !circle->parentSketch() || !circle->centerSketchPoint())
+				return false;
+
+			auto dimensions = circle->parentSketch()->sketchDimensions();
+			if (!dimensions)
+				return false;
+
+			return drive(dimensions->addDiameterDimension(circle, circle->centerSketchPoint()->geometry()), expression);
+		}
+
+		bool uniformHoles(const JointSpec& spec) {
+			auto first = -1.0;
+			for (auto& cell : spec.cells) {
+				if (cell.type != ARMATURE_JOINT_OPTION_BALL)
+					continue;
+
+				if (first < 0)
+					first = cell.holeDiameter;
+				else if (fabs(cell.holeDiameter - first) > tolerance)
+					return false;
+			}
+			return true;
+		}
+	}
+
+	shared_ptr<JointParameters> JointParameters::create(Ptr<Design> design, Ptr<Component> component, Mode mode, shared_ptr<Values> values) {
+		if (!design || !component || !values)
+			return nullptr;
+
+		auto userParameters = design->userParameters();
+		if (!userParameters)
+			return nullptr;
+
+		Mode boundMode;
+		std::string prefix;
+		auto existing = readBinding(component, boundMode, prefix);
+		if (existing)
+			mode = boundMode;
+		else {
+			if (mode == None)
+				return nullptr;
+
+			adopt(design, mode, values);
+
+			auto base = identifier(values->name());
+			prefix = base;
+			for (auto n = 2; prefix == "armature" || userParameters->itemByName(prefix + "_length"); n++)
+				prefix = base + "_" + std::to_string(n);
+
+			if (!writeBinding(component, mode, prefix))
+				return nullptr;
+		}
+
+		auto parameters = shared_ptr<JointParameters>(new JointParameters(userParameters, values, namesFor(mode, prefix, values->spec())));
+		auto& names = parameters->names;
+		auto joint = " of " + values->name();
+		auto shared = mode == Shared ? std::string(" of every shared joint") : joint;
+
+		if (!parameters->define(names.length, values->length(), "Plate length" + joint) ||
+			!parameters->define(names.width, values->width(), "Plate width" + joint) ||
+			!parameters->define(names.thickness, values->thickness(), "Plate thickness" + shared) ||
+			!parameters->define(names.ballDiameter, values->ballDiameter(), "Ball diameter" + shared) ||
+			!parameters->define(names.boltHoleDiameter, values->boltHoleDiameter(), "Bolt hole diameter" + shared)) {
+			parameters->discard();
+			return nullptr;
+		}
+
+		for (auto& hole : names.holes) {
+			auto perCell = hole.second.find("_holeDiameter_") != std::string::npos;
+			if (!parameters->define(hole.second, values->spec().cell(hole.first.first, hole.first.second).holeDiameter, "Ball screw hole diameter" + (perCell ? joint : shared))) {
+				parameters->discard();
+				return nullptr;
+			}
+		}
+
+		return parameters;
+	}
+
+	// Lengths, widths and per-cell screw holes belong to the joint, so only the shared sizes are taken.
+	void JointParameters::adopt(Ptr<Design> design, Mode mode, shared_ptr<Values> values) {
+		if (!design || !values || mode != Shared)
+			return;
+
+		auto userParameters = design->userParameters();
+		if (!userParameters)
+			return;
+
+		auto names = namesFor(mode, "", values->spec());
+		auto read = [&](const std::string& name, double value) {
+			auto parameter = userParameters->itemByName(name);
+			return parameter ? parameter->value() : value;
+		};
+
+		values->thickness(read(names.thickness, values->thickness()));
+		values->ballDiameter(read(names.ballDiameter, values->ballDiameter()));
+		values->boltHoleDiameter(read(names.boltHoleDiameter, values->boltHoleDiameter()));
+
+		for (auto& hole : names.holes) {
+			if (hole.second.find("_holeDiameter_") != std::string::npos)
+				continue;
+
+			auto cell = values->spec().cell(hole.first.first, hole.first.second);
+			cell.holeDiameter = read(hole.second, cell.holeDiameter);
+			values->cell(hole.first.first, hole.first.second, cell);
+		}
+	}
+
+	bool JointParameters::bound(Ptr<Component> component) {
+		Mode mode;
+		std::string prefix;
+		return readBinding(component, mode, prefix);
+	}
+
+	bool JointParameters::apply(Ptr<Component> component, JointSpec& spec) {
+		Mode mode;
+		std::string prefix;
+		if (!readBinding(component, mode, prefix))
+			return true;
+
+		auto design = component->parentDesign();
+		auto userParameters = design ? design->userParameters() : nullptr;
+		if (!userParameters)
+			return false;
+
+		auto read = [&](const std::string& name, double& value) {
+			auto parameter = userParameters->itemByName(name);
+			if (parameter)
+				value = parameter->value();
+		};
+
+		auto names = namesFor(mode, prefix, spec);
+		read(names.length, spec.length);
+		read(names.width, spec.width);
+		read(names.thickness, spec.thickness);
+		read(names.ballDiameter, spec.ballDiameter);
+		read(names.boltHoleDiameter, spec.boltHoleDiameter);
+
+		for (auto& hole : names.holes)
+			read(hole.second, spec.cell(hole.first.first, hole.first.second).holeDiameter);
+
+		return true;
+	}
+
+	bool JointParameters::update(Ptr<Component> component, const JointSpec& current, const JointSpec& spec) {
+		Mode mode;
+		std::string prefix;
+		if (!readBinding(component, mode, prefix))
+			return false;
+
+		auto names = namesFor(mode, prefix, spec);
+		if (!sameNames(names, namesFor(mode, prefix, current)))
+			return false;
+
+		auto design = component->parentDesign();
+		auto userParameters = design ? design->userParameters() : nullptr;
+		if (!userParameters)
+			return false;
+
+		auto set = [&](const std::string& name, double value) {
+			auto parameter = userParameters->itemByName(name);
+			if (!parameter)
+				return false;
+
+			return fabs(parameter->value() - value) < tolerance || parameter->value(value);
+		};
+
+		if (!set(names.length, spec.length) ||
+			!set(names.width, spec.width) ||
+			!set(names.thickness, spec.thickness) ||
+			!set(names.ballDiameter, spec.ballDiameter) ||
+			!set(names.boltHoleDiameter, spec.boltHoleDiameter))
+			return false;
+
+		for (auto& hole : names.holes) {
+			if (!set(hole.second, spec.cell(hole.first.first, hole.first.second).holeDiameter))
+				return false;
+		}
+
+		return true;
+	}
+
+	bool JointParameters::addInput(Ptr<CommandInputs> inputs, const std::string& id) {
+		if (!inputs)
+			return false;
+
+		auto dropDown = inputs->addDropDownCommandInput(id, "Parameters", DropDownStyles::TextListDropDownStyle);
+		if (!dropDown)
+			return false;
+
+		auto items = dropDown->listItems();
+		if (!items)
+			return false;
+
+		if (!items->add(ARMATURE_JOINT_PARAMETERS_OPTION_NONE, true) ||
+			!items->add(ARMATURE_JOINT_PARAMETERS_OPTION_JOINT, false) ||
+			!items->add(ARMATURE_JOINT_PARAMETERS_OPTION_SHARED, false))
+			return false;
+
+		return dropDown->tooltip("Drive the joint from user parameters, its own or shared by every joint, so editing them resizes it");
+	}
+
+	JointParameters::Mode JointParameters::mode(Ptr<CommandInputs> inputs, const std::string& id) {
+		if (!inputs)
+			return None;
+
+		auto dropDown = static_cast<Ptr<DropDownCommandInput>>(inputs->itemById(id));
+		auto selected = dropDown ? dropDown->selectedItem() : nullptr;
+		if (!selected)
+			return None;
+
+		if (selected->name() == ARMATURE_JOINT_PARAMETERS_OPTION_JOINT)
+			return PerJoint;
+
+		if (selected->name() == ARMATURE_JOINT_PARAMETERS_OPTION_SHARED)
+			return Shared;
+
+		return None;
+	}
+
+	bool JointParameters::readBinding(Ptr<Component> component, Mode& mode, std::string& prefix) {
+		if (!component)
+			return false;
+
+		auto attributes = component->attributes();
+		if (!attributes)
+			return false;
+
+		auto attribute = attributes->itemByName(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_PARAMETERS);
+		if (!attribute)
+			return false;
+
+		Json json;
+		std::string error;
+		if (!Json::parse(attribute->value(), json, error) || !json.isObject() || !json["prefix"].isString())
+			return false;
+
+		mode = json["mode"].string() == "shared" ? Shared : PerJoint;
+		prefix = json["prefix"].string();
+		return !prefix.empty();
+	}
+
+	bool JointParameters::writeBinding(Ptr<Component> component, Mode mode, const std::string& prefix) {
+		auto attributes = component->attributes();
+		if (!attributes)
+			return false;
+
+		auto json = Json::object();
+		json.set("mode", mode == Shared ? "shared" : "joint");
+		json.set("prefix", prefix);
+
+		return attributes->add(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_PARAMETERS, json.dump()) != nullptr;
+	}
+
+	// Names follow from the binding and the spec, so only the mode and prefix are stored. Screw holes share one
+	// parameter while every ball's hole is the same size, and get one per cell once they differ.
+	JointParameters::Names JointParameters::namesFor(Mode mode, const std::string& prefix, const JointSpec& spec) {
+		auto shared = mode == Shared ? std::string("armature") : prefix;
+
+		Names names;
+		names.length = prefix + "_length";
+		names.width = prefix + "_width";
+		names.thickness = shared + "_thickness";
+		names.ballDiameter = shared + "_ballDiameter";
+		names.boltHoleDiameter = shared + "_boltHoleDiameter";
+
+		auto uniform = uniformHoles(spec);
+		for (auto row = 1; row <= spec.rows; row++) {
+			for (auto col = 1; col <= spec.cols; col++) {
+				if (spec.cell(row, col).type != ARMATURE_JOINT_OPTION_BALL)
+					continue;
+
+				names.holes[make_pair(row, col)] = uniform
+					? shared + "_holeDiameter"
+					: prefix + "_holeDiameter_" + std::to_string(row) + "_" + std::to_string(col);
+			}
+		}
+
+		return names;
+	}
+
+	bool JointParameters::sameNames(const Names& a, const Names& b) {
+		return a.length == b.length && a.width == b.width && a.thickness == b.thickness &&
+			a.ballDiameter == b.ballDiameter && a.boltHoleDiameter == b.boltHoleDiameter && a.holes == b.holes;
+	}
+
+	bool JointParameters::define(const std::string& name, double value, const std::string& comment) {
+		auto parameter = parameters->itemByName(name);
+		if (!parameter) {
+			if (!parameters->add(name, ValueInput::createByReal(value), "mm", comment))
+				return false;
+
+			added.push_back(name);
+			return true;
+		}
+
+		return fabs(parameter->value() - value) < tolerance || parameter->value(value);
+	}
+
+	// The expressions below restate Layout's derived sizes in terms of the parameters.
+	std::string JointParameters::radius() const {
+		return "(" + names.ballDiameter + " / 2)";
+	}
+
+	std::string JointParameters::offset() const {
+		return "(" + radius() + " / 1.2)";
+	}
+
+	std::string JointParameters::chamfer() const {
+		return "(" + radius() + " / 6)";
+	}
+
+	std::string JointParameters::ballZ() const {
+		return "(" + names.thickness + " + " + offset() + " - " + chamfer() + " / 1.25)";
+	}
+
+	std::string JointParameters::topOffset() const {
+		return "(" + ballZ() + " + " + offset() + " - " + chamfer() + " / 1.25)";
+	}
+
+	std::string JointParameters::circleDiameter() const {
+		return "(2 * " + radius() + " * sqrt(1 - 1 / 1.44))";
+	}
+
+	std::string JointParameters::ballX(int col) const {
+		auto end = radius() + " / 1.25";
+		if (values->cols() < 2 || col == 1)
+			return "(" + end + ")";
+
+		return "(" + end + " + (" + names.length + " - 2 * " + end + ") * " + std::to_string(col - 1) + " / " + std::to_string(values->cols() - 1) + ")";
+	}
+
+	std::string JointParameters::rowDepth(int row) const {
+		return "(" + names.width + " * " + std::to_string((2 * row) - 1) + " / " + std::to_string(2 * values->rows()) + ")";
+	}
+
+	bool JointParameters::bind(Ptr<Component> component) {
+		auto roles = JointAttributes::roles(component);
+
+		return
+			driveOffset(find<ConstructionPlane>(roles, "topOffsetPlane"), topOffset()) &&
+			bindPlate(roles, "bottomPlate.") &&
+			bindPlate(roles, "topPlate.") &&
+			bindBalls(roles) &&
+			bindNuts(roles);
+	}
+
+	void JointParameters::discard() {
+		for (auto name = added.rbegin(); name != added.rend(); name++) {
+			auto parameter = parameters->itemByName(*name);
+			if (parameter)
+				parameter->deleteMe();
+		}
+		added.clear();
+	}
+
+	bool JointParameters::bindPlate(map<std::string, Ptr<Base>>& roles, const std::string& plate) {
+		auto sketch = find<Sketch>(roles, plate + "sketch");
+		if (!sketch)
+			return false;
+
+		auto constraints = sketch->geometricConstraints();
+		auto lines = sketch->sketchCurves() ? sketch->sketchCurves()->sketchLines() : nullptr;
+		if (!constraints || !lines)
+			return false;
+
+		// The outline is generated unconstrained; square it up, pin its corner at the origin there and size it by the
+		// opposite one.
+		for (size_t i = 0; i < lines->count(); i++) {
+			auto line = lines->item(i);
+			auto start = line->startSketchPoint()->geometry();
+			auto end = line->endSketchPoint()->geometry();
+			if (fabs(start->y() - end->y()) < tolerance) {
+				if (!constraints->addHorizontal(line))
+					return false;
+			}
+			else if (!constraints->addVertical(line)) {
+				return false;
+			}
+		}
+
+		for (size_t i = 0; i < lines->count(); i++) {
+			auto start = lines->item(i)->startSketchPoint();
+			auto geometry = start->geometry();
+			if (fabs(geometry->x()) < tolerance && fabs(geometry->y()) < tolerance) {
+				if (!constraints->addCoincident(start, sketch->originPoint()))
+					return false;
+				break;
+			}
+		}
+
+		if (!place(find<SketchPoint>(roles, plate + "corner"), names.length, names.width))
+			return false;
+
+		auto bolt = find<SketchCircle>(roles, plate + "boltCircle");
+		if (!bolt || !place(bolt->centerSketchPoint(), "(" + names.length + " / 2)", "(" + names.width + " / 2)") || !diameter(bolt, names.boltHoleDiameter))
+			return false;
+
+		for (auto row = 1; row <= values->rows(); row++) {
+			for (auto col = 1; col <= values->cols(); col++) {
+				if (values->jointType(row, col) != ARMATURE_JOINT_OPTION_BALL)
+					continue;
+
+				auto seat = find<SketchCircle>(roles, JointAttributes::role(plate + "seatCircle", row, col));
+				if (!seat || !place(seat->centerSketchPoint(), ballX(col), rowDepth(row)) || !diameter(seat, circleDiameter()))
+					return false;
+			}
+		}
+
+		if (!driveExtrude(find<ExtrudeFeature>(roles, plate + "extrude"), names.thickness))
+			return false;
+
+		auto chamferFeature = find<ChamferFeature>(roles, plate + "chamfer");
+		if (chamferFeature) {
+			auto definition = static_cast<Ptr<DistanceAndAngleChamferTypeDefinition>>(chamferFeature->chamferTypeDefinition());
+			if (!definition || !drive(definition->distance(), chamfer()) || !drive(definition->angle(), "45 deg"))
+				return false;
+		}
+
+		auto fillet = find<FilletFeature>(roles, plate + "fillet");
+		if (!fillet)
+			return false;
+
+		auto edgeSets = fillet->edgeSets();
+		if (!edgeSets || edgeSets->count() < 1)
+			return false;
+
+		auto edgeSet = static_cast<Ptr<ConstantRadiusFilletEdgeSet>>(edgeSets->item(0));
+		return edgeSet && drive(edgeSet->radius(), radius());
+	}
+
+	bool JointParameters::bindBalls(map<std::string, Ptr<Base>>& roles) {
+		if (values->numJointTypes(ARMATURE_JOINT_OPTION_BALL) == 0)
+			return true;
+
+		if (!driveOffset(find<ConstructionPlane>(roles, "ballPlane"), ballZ()))
+			return false;
+
+		for (auto row = 1; row <= values->rows(); row++) {
+			for (auto col = 1; col <= values->cols(); col++) {
+				if (values->jointType(row, col) != ARMATURE_JOINT_OPTION_BALL)
+					continue;
+
+				auto circle = find<SketchCircle>(roles, JointAttributes::role("ballCircle", row, col));
+				auto axis = find<SketchLine>(roles, JointAttributes::role("ballAxis", row, col));
+				if (!circle || !axis || !circle->parentSketch())
+					return false;
+
+				auto constraints = circle->parentSketch()->geometricConstraints();
+				if (!constraints)
+					return false;
+
+				// The revolve axis is the ball's diameter across its screw hole, vertical for holes along x.
+				auto square = values->ballHoleDirection(row, col).x != 0 ? constraints->addVertical(axis) : constraints->addHorizontal(axis);
+				if (!place(circle->centerSketchPoint(), ballX(col), rowDepth(row)) || !diameter(circle, names.ballDiameter) ||
+					!square ||
+					!constraints->addMidPoint(circle->centerSketchPoint(), axis) ||
+					!constraints->addCoincident(axis->startSketchPoint(), circle))
+					return false;
+
+				auto hole = find<SketchCircle>(roles, JointAttributes::role("ballHoleCircle", row, col));
+				if (!hole || !hole->parentSketch() || !hole->parentSketch()->geometricConstraints())
+					return false;
+
+				if (!hole->parentSketch()->geometricConstraints()->addCoincident(hole->centerSketchPoint(), hole->parentSketch()->originPoint()) ||
+					!diameter(hole, names.holes[make_pair(row, col)]))
+					return false;
+
+				if (!driveExtrude(find<ExtrudeFeature>(roles, JointAttributes::role("ballHoleExtrude", row, col)), radius()))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool JointParameters::bindNuts(map<std::string, Ptr<Base>>& roles) {
+		for (auto col = 1; col <= values->cols(); col++) {
+			auto plane = find<ConstructionPlane>(roles, JointAttributes::role("nutPlane", col));
+			if (!plane)
+				continue; // no nuts in this column
+
+			if (!driveOffset(plane, ballX(col)))
+				return false;
+
+			for (auto row = 1; row <= values->rows(); row++) {
+				if (values->jointType(row, col) != ARMATURE_JOINT_OPTION_NUT)
+					continue;
+
+				auto bolt = find<SketchCircle>(roles, JointAttributes::role("nutCircle", row, col));
+				if (!bolt || !bolt->parentSketch())
+					return false;
+
+				auto sketch = bolt->parentSketch();
+				auto constraints = sketch->geometricConstraints();
+				auto circles = sketch->sketchCurves() ? sketch->sketchCurves()->sketchCircles() : nullptr;
+				if (!constraints || !circles)
+					return false;
+
+				if (!place(bolt->centerSketchPoint(), rowDepth(row), ballZ()) || !diameter(bolt, names.boltHoleDiameter))
+					return false;
+
+				// A regular hex: its corners on a construction circle around the bolt hole, equal sides and a level top.
+				auto guide = circles->addByCenterRadius(bolt->centerSketchPoint(), 2 * values->ballOffset() * tan(M_PI / 6));
+				if (!guide || !guide->isConstruction(true) || !diameter(guide, "(4 * " + offset() + " * tan(30 deg))"))
+					return false;
+
+				Ptr<SketchLine> sides[6];
+				for (auto i = 0; i < 6; i++) {
+					sides[i] = find<SketchLine>(roles, JointAttributes::role("nutLine", row, col, i));
+					if (!sides[i])
+						return false;
+				}
+
+				// The sides already share their corners.
+				for (auto i = 0; i < 6; i++) {
+					if (!constraints->addCoincident(sides[i]->startSketchPoint(), guide) ||
+						(i > 0 && !constraints->addEqual(sides[0], sides[i])))
+						return false;
+				}
+
+				if (!constraints->addHorizontal(sides[0]))
+					return false;
+			}
+
+			auto prefix = JointAttributes::role("nutExtrude", col) + ".";
+			for (auto entry = roles.lower_bound(prefix); entry != roles.end() && entry->first.compare(0, prefix.size(), prefix) == 0; entry++) {
+				if (!driveExtrude(static_cast<Ptr<ExtrudeFeature>>(entry->second), "(" + radius() + " / 2)"))
+					return false;
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+
+#include <map>
+#include <string>
+
+#include "Values.h"
+
+#define ARMATURE_JOINT_ATTRIBUTE_PARAMETERS "parameters"
+
+using namespace std;
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace ArmatureJoint {
+	// Drives a generated joint from design user parameters. Its sizes become user parameters and every sketch
+	// dimension and feature distance derived from them is an expression, so changing a parameter is a recompute of
+	// the timeline rather than a rebuild by the add-in. Shared parameters hold the ball, plate, bolt and screw hole
+	// sizes of every joint bound to them, so one change resizes the whole puppet; lengths and widths stay per joint.
+	class JointParameters {
+	public:
+		enum Mode { None, PerJoint, Shared };
+
+		// Joints already bound keep their parameters, set to the new sizes. A new joint in shared mode takes the
+		// sizes of shared parameters that already exist, so it matches the joints bound before it.
+		static shared_ptr<JointParameters> create(Ptr<Design> design, Ptr<Component> component, Mode mode, shared_ptr<Values> values);
+		static bool bound(Ptr<Component> component);
+
+		// Gives a new joint the sizes create() will leave it with, those of the shared parameters that already exist,
+		// without changing the design; so it can be validated before anything is written.
+		static void adopt(Ptr<Design> design, Mode mode, shared_ptr<Values> values);
+
+		// Overlays the current parameter values on the spec stored with the joint, so a joint resized through its
+		// parameters reads back at its new size.
+		static bool apply(Ptr<Component> component, JointSpec& spec);
+
+		// Resizes a bound joint by its parameters. False when the new spec needs different parameters than the
+		// joint was bound to, and the joint has to be regenerated.
+		static bool update(Ptr<Component> component, const JointSpec& current, const JointSpec& spec);
+
+		static bool addInput(Ptr<CommandInputs> inputs, const std::string& id);
+		static Mode mode(Ptr<CommandInputs> inputs, const std::string& id);
+
+		bool bind(Ptr<Component> component);
+
+		// Removes the parameters create() added, for a new joint that could not be generated after all. Call it once
+		// the joint's component is gone, since its sketches and features refer to them.
+		void discard();
+
+	private:
+		struct Names {
+			std::string length;
+			std::string width;
+			std::string thickness;
+			std::string ballDiameter;
+			std::string boltHoleDiameter;
+			map<pair<int, int>, std::string> holes; // ball cells only
+		};
+
+		Ptr<UserParameters> parameters;
+		shared_ptr<Values> values;
+		Names names;
+		std::vector<std::string> added;
+
+		JointParameters(Ptr<UserParameters> _parameters, shared_ptr<Values> _values, const Names& _names) {
+			parameters = _parameters;
+			values = _values;
+			names = _names;
+		}
+
+		static bool readBinding(Ptr<Component> component, Mode& mode, std::string& prefix);
+		static bool writeBinding(Ptr<Component> component, Mode mode, const std::string& prefix);
+		static Names namesFor(Mode mode, const std::string& prefix, const JointSpec& spec);
+		static bool sameNames(const Names& a, const Names& b);
+
+		bool define(const std::string& name, double value, const std::string& comment);
+
+		std::string radius() const;
+		std::string offset() const;
+		std::string chamfer() const;
+		std::string ballZ() const;
+		std::string topOffset() const;
+		std::string circleDiameter() const;
+		std::string ballX(int col) const;
+		std::string rowDepth(int row) const;
+
+		bool bindPlate(map<std::string, Ptr<Base>>& roles, const std::string& plate);
+		bool bindBalls(map<std::string, Ptr<Base>>& roles);
+		bool bindNuts(map<std::string, Ptr<Base>>& roles);
+	};
+}
@@ -0,0 +1,527 @@
+#include "JointSpec.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <cctype>
+#include <cstdlib>
+#include <math.h>
+
+#include "ArmatureFile.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		bool isJointType(const std::string& type) {
+			return type == ARMATURE_JOINT_OPTION_BALL || type == ARMATURE_JOINT_OPTION_NUT || type == ARMATURE_JOINT_OPTION_NONE;
+		}
+
+		std::string trim(const std::string& s) {
+			auto start = s.find_first_not_of(" \t\r\n");
+			if (start == std::string::npos)
+				return "";
+
+			auto end = s.find_last_not_of(" \t\r\n");
+			return s.substr(start, end - start + 1);
+		}
+
+		std::vector<std::string> split(const std::string& s, char separator) {
+			std::vector<std::string> parts;
+			std::string part;
+			std::istringstream stream(s);
+			while (std::getline(stream, part, separator))
+				parts.push_back(trim(part));
+			return parts;
+		}
+
+		std::vector<std::string> csvFields(const std::string& line) {
+			std::vector<std::string> fields;
+			std::string field;
+			auto quoted = false;
+			for (size_t i = 0; i < line.size(); i++) {
+				auto c = line[i];
+				if (quoted) {
+					if (c == '"' && i + 1 < line.size() && line[i + 1] == '"') {
+						field += '"';
+						i++;
+					}
+					else if (c == '"') {
+						quoted = false;
+					}
+					else {
+						field += c;
+					}
+				}
+				else if (c == '"') {
+					quoted = true;
+				}
+				else if (c == ',') {
+					fields.push_back(trim(field));
+					field.clear();
+				}
+				else {
+					field += c;
+				}
+			}
+			fields.push_back(trim(field));
+			return fields;
+		}
+
+		bool parseCell(const Json& json, const JointCell& defaultCell, double unitScale, JointCell& cell, std::string& error) {
+			cell = defaultCell;
+
+			if (json.isString()) {
+				cell.type = json.string();
+			}
+			else if (json.isObject()) {
+				if (json.has("type"))
+					cell.type = json["type"].string();
+				if (json["holeDiameter"].isNumber()) {
+					if (!isfinite(json["holeDiameter"].number())) {
+						error = "holeDiameter must be a finite number";
+						return false;
+					}
+					cell.holeDiameter = json["holeDiameter"].number() * unitScale;
+				}
+			}
+			else {
+				error = "cells must be a type name or an object";
+				return false;
+			}
+
+			if (!isJointType(cell.type)) {
+				error = "unknown joint type '" + cell.type + "'";
+				return false;
+			}
+			return true;
+		}
+
+		std::string extension(const std::string& path) {
+			auto dot = path.find_last_of('.');
+			if (dot == std::string::npos)
+				return "";
+
+			auto ext = path.substr(dot + 1);
+			std::transform(ext.begin(), ext.end(), ext.begin(), [](char c) { return (char)tolower((unsigned char)c); });
+			return ext;
+		}
+
+		std::string csvQuote(const std::string& field) {
+			// A name starting with '#' would otherwise read back as a comment line.
+			if (field.find_first_of(",\"") == std::string::npos && (field.empty() || field[0] != '#'))
+				return field;
+
+			std::string quoted = "\"";
+			for (auto c : field) {
+				if (c == '"')
+					quoted += '"';
+				quoted += c;
+			}
+			return quoted + "\"";
+		}
+
+		// CSV cells are written as "Ball:3;Nut|None;Ball", rows separated by '|' and columns by ';'.
+		Json csvCells(const std::string& text) {
+			auto cells = Json::array();
+			for (auto& row : split(text, '|')) {
+				auto& cols = cells.push(Json::array());
+				for (auto& col : split(row, ';')) {
+					auto separator = col.find(':');
+					if (separator == std::string::npos) {
+						cols.push(Json(col));
+						continue;
+					}
+
+					auto cell = Json::object();
+					cell.set("type", trim(col.substr(0, separator)));
+					cell.set("holeDiameter", strtod(col.c_str() + separator + 1, nullptr));
+					cols.push(cell);
+				}
+			}
+			return cells;
+		}
+	}
+
+	JointCell JointCell::defaults() {
+		JointCell cell;
+		cell.type = ARMATURE_JOINT_OPTION_BALL;
+		cell.holeDiameter = Defaults::holeDiameter.centimetres();
+		return cell;
+	}
+
+	JointSpec::JointSpec() : length(0), width(0), thickness(0), ballDiameter(0), boltHoleDiameter(0), rows(0), cols(0) {
+		transform = { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 };
+	}
+
+	JointSpec JointSpec::defaults() {
+		JointSpec spec;
+		spec.name = "Joint";
+		spec.length = Defaults::length.centimetres();
+		spec.width = Defaults::width.centimetres();
+		spec.thickness = Defaults::thickness.centimetres();
+		spec.ballDiameter = Defaults::ballDiameter.centimetres();
+		spec.boltHoleDiameter = Defaults::boltHoleDiameter.centimetres();
+		spec.resize(Defaults::rows, Defaults::cols, JointCell::defaults());
+		return spec;
+	}
+
+	JointCell& JointSpec::cell(int row, int col) {
+		return cells[((row - 1) * cols) + (col - 1)];
+	}
+
+	const JointCell& JointSpec::cell(int row, int col) const {
+		return cells[((row - 1) * cols) + (col - 1)];
+	}
+
+	void JointSpec::resize(int _rows, int _cols, const JointCell& fill) {
+		std::vector<JointCell> resized(_rows * _cols, fill);
+		for (auto row = 1; row <= std::min(rows, _rows); row++) {
+			for (auto col = 1; col <= std::min(cols, _cols); col++)
+				resized[((row - 1) * _cols) + (col - 1)] = cell(row, col);
+		}
+
+		rows = _rows;
+		cols = _cols;
+		cells.swap(resized);
+	}
+
+	Json JointSpec::toJson() const {
+		auto json = Json::object();
+		json.set("name", name);
+		json.set("length", length);
+		json.set("width", width);
+		json.set("thickness", thickness);
+		json.set("ballDiameter", ballDiameter);
+		json.set("boltHoleDiameter", boltHoleDiameter);
+		json.set("rows", rows);
+		json.set("cols", cols);
+
+		auto& gridJson = json.set("cells", Json::array());
+		for (auto row = 1; row <= rows; row++) {
+			auto& rowJson = gridJson.push(Json::array());
+			for (auto col = 1; col <= cols; col++) {
+				auto cellJson = Json::object();
+				cellJson.set("type", cell(row, col).type);
+				cellJson.set("holeDiameter", cell(row, col).holeDiameter);
+				rowJson.push(cellJson);
+			}
+		}
+
+		auto& transformJson = json.set("transform", Json::array());
+		for (auto v : transform)
+			transformJson.push(v);
+
+		return json;
+	}
+
+	bool JointSpec::fromJson(const Json& json, const JointSpec& defaults, const JointCell& defaultCell, double unitScale, JointSpec& spec, std::string& error) {
+		if (!json.isObject()) {
+			error = "joint must be an object";
+			return false;
+		}
+
+		spec = defaults;
+
+		if (json["name"].isString())
+			spec.name = json["name"].string();
+
+		struct { const char* key; double* value; } lengths[] = {
+			{ "length", &spec.length },
+			{ "width", &spec.width },
+			{ "thickness", &spec.thickness },
+			{ "ballDiameter", &spec.ballDiameter },
+			{ "boltHoleDiameter", &spec.boltHoleDiameter },
+		};
+		for (auto& l : lengths) {
+			if (!json.has(l.key))
+				continue;
+
+			if (!json[l.key].isNumber() || !(json[l.key].number() > 0) || !isfinite(json[l.key].number())) {
+				error = spec.name + ": " + l.key + " must be a positive number";
+				return false;
+			}
+			*l.value = json[l.key].number() * unitScale;
+		}
+
+		auto& grid = json["cells"];
+		// Checked as doubles, so sizes that are not numbers or do not fit an int never reach the cast.
+		auto rowsValue = json["rows"].isNumber() ? json["rows"].number() : (grid.isArray() ? (double)grid.size() : spec.rows);
+		auto colsValue = json["cols"].isNumber() ? json["cols"].number() : (grid.isArray() ? (double)grid[0].size() : spec.cols);
+		if (!(rowsValue >= 1) || !(colsValue >= 1)) {
+			error = spec.name + ": rows and cols must be at least 1";
+			return false;
+		}
+		if (rowsValue > Defaults::maxRows || colsValue > Defaults::maxCols) {
+			error = spec.name + ": at most " + std::to_string(Defaults::maxRows) + " rows and " + std::to_string(Defaults::maxCols) + " cols";
+			return false;
+		}
+		auto rows = (int)rowsValue;
+		auto cols = (int)colsValue;
+
+		spec.cells.clear();
+		spec.rows = 0;
+		spec.cols = 0;
+		spec.resize(rows, cols, defaultCell);
+
+		if (grid.isArray()) {
+			for (auto row = 1; row <= rows && row <= (int)grid.size(); row++) {
+				auto& rowJson = grid[row - 1];
+				for (auto col = 1; col <= cols && col <= (int)rowJson.size(); col++) {
+					if (!parseCell(rowJson[col - 1], defaultCell, unitScale, spec.cell(row, col), error)) {
+						error = spec.name + ": " + error;
+						return false;
+					}
+				}
+			}
+		}
+
+		auto& transform = json["transform"];
+		if (transform.isArray()) {
+			if (transform.size() != 16) {
+				error = spec.name + ": transform must have 16 values";
+				return false;
+			}
+
+			for (size_t i = 0; i < 16; i++) {
+				if (!isfinite(transform[i].number())) {
+					error = spec.name + ": transform values must be finite numbers";
+					return false;
+				}
+				spec.transform[i] = transform[i].number();
+			}
+
+			// Only the translation column carries a length.
+			spec.transform[3] *= unitScale;
+			spec.transform[7] *= unitScale;
+			spec.transform[11] *= unitScale;
+		}
+
+		return true;
+	}
+
+	JointChange::JointChange() :
+		matchBallDiameter(false), matchedBallDiameter(0),
+		changeBallDiameter(false), ballDiameter(0),
+		changeThickness(false), thickness(0),
+		changeBoltHoleDiameter(false), boltHoleDiameter(0),
+		changeHoleDiameter(false), holeDiameter(0) {
+	}
+
+	bool JointChange::matches(const JointSpec& spec) const {
+		if (!matchBallDiameter)
+			return true;
+
+		return fabs(spec.ballDiameter - matchedBallDiameter) < 1e-6;
+	}
+
+	bool JointChange::apply(JointSpec& spec) const {
+		if (!matches(spec))
+			return false;
+
+		auto changed = false;
+		auto set = [&changed](bool change, double& field, double value) {
+			if (!change || fabs(field - value) < 1e-9)
+				return;
+			field = value;
+			changed = true;
+		};
+
+		set(changeBallDiameter, spec.ballDiameter, ballDiameter);
+		set(changeThickness, spec.thickness, thickness);
+		set(changeBoltHoleDiameter, spec.boltHoleDiameter, boltHoleDiameter);
+		for (auto& cell : spec.cells) {
+			if (cell.type == ARMATURE_JOINT_OPTION_BALL)
+				set(changeHoleDiameter, cell.holeDiameter, holeDiameter);
+		}
+
+		return changed;
+	}
+
+	double JointSpecFile::unitScale(const std::string& units) {
+		if (units == "mm")
+			return (1_mm).centimetres();
+		if (units == "cm")
+			return (1_cm).centimetres();
+		if (units == "m")
+			return (1000_mm).centimetres();
+		if (units == "in")
+			return (1_in).centimetres();
+		return 0;
+	}
+
+	bool JointSpecFile::read(const std::string& path, const JointSpec& defaults, const JointCell& defaultCell, std::vector<JointSpec>& specs, std::string& error) {
+		std::ifstream file(path, std::ios::in | std::ios::binary);
+		if (!file) {
+			error = "could not open " + path;
+			return false;
+		}
+
+		if (extension(path) == "armature") {
+			auto armature = ArmatureFile::open(path);
+			if (!armature) {
+				error = path + " is not an armature file";
+				return false;
+			}
+			return armature->specs(specs, error);
+		}
+
+		std::stringstream text;
+		text << file.rdbuf();
+
+		if (extension(path) == "csv")
+			return readCsv(text.str(), defaults, defaultCell, specs, error);
+
+		return readJson(text.str(), defaults, defaultCell, specs, error);
+	}
+
+	bool JointSpecFile::readJson(const std::string& text, const JointSpec& defaults, const JointCell& defaultCell, std::vector<JointSpec>& specs, std::string& error) {
+		Json json;
+		if (!Json::parse(text, json, error))
+			return false;
+
+		auto units = json["units"].isString() ? json["units"].string() : "mm";
+		auto scale = unitScale(units);
+		if (scale == 0) {
+			error = "unknown units '" + units + "'";
+			return false;
+		}
+
+		auto& joints = json.isArray() ? json : json["joints"];
+		if (!joints.isArray()) {
+			error = "expected a list of joints";
+			return false;
+		}
+
+		for (size_t i = 0; i < joints.size(); i++) {
+			JointSpec spec;
+			if (!JointSpec::fromJson(joints[i], defaults, defaultCell, scale, spec, error))
+				return false;
+
+			if (!joints[i].has("name"))
+				spec.name = defaults.name + " " + std::to_string(i + 1);
+
+			specs.push_back(spec);
+		}
+		return true;
+	}
+
+	bool JointSpecFile::readCsv(const std::string& text, const JointSpec& defaults, const JointCell& defaultCell, std::vector<JointSpec>& specs, std::string& error) {
+		std::istringstream lines(text);
+		std::string line;
+		std::vector<std::string> header;
+
+		while (std::getline(lines, line)) {
+			line = trim(line);
+			if (line.empty() || line[0] == '#')
+				continue;
+
+			auto fields = csvFields(line);
+			if (header.empty()) {
+				header = fields;
+				continue;
+			}
+
+			auto json = Json::object();
+			auto units = std::string("mm");
+			for (size_t i = 0; i < header.size() && i < fields.size(); i++) {
+				auto& key = header[i];
+				auto& field = fields[i];
+				if (field.empty())
+					continue;
+
+				if (key == "units")
+					units = field;
+				else if (key == "name")
+					json.set(key, field);
+				else if (key == "cells")
+					json.set(key, csvCells(field));
+				else if (key == "transform") {
+					auto& transform = json.set(key, Json::array());
+					std::istringstream values(field);
+					double v;
+					while (values >> v)
+						transform.push(v);
+				}
+				else
+					json.set(key, strtod(field.c_str(), nullptr));
+			}
+
+			auto scale = unitScale(units);
+			if (scale == 0) {
+				error = "unknown units '" + units + "'";
+				return false;
+			}
+
+			JointSpec spec;
+			if (!JointSpec::fromJson(json, defaults, defaultCell, scale, spec, error))
+				return false;
+
+			if (!json.has("name"))
+				spec.name = defaults.name + " " + std::to_string(specs.size() + 1);
+
+			specs.push_back(spec);
+		}
+
+		if (header.empty()) {
+			error = "empty joint specification file";
+			return false;
+		}
+		return true;
+	}
+
+	bool JointSpecFile::write(const std::string& path, const std::vector<JointSpec>& specs, std::string& error) {
+		auto ext = extension(path);
+		if (ext == "armature")
+			return ArmatureFile::write(path, specs, error);
+
+		std::ofstream file(path, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file) {
+			error = "could not open " + path;
+			return false;
+		}
+
+		file << (ext == "csv" ? writeCsv(specs) : writeJson(specs));
+		file.close();
+
+		if (file.fail()) {
+			error = "could not write " + path;
+			return false;
+		}
+		return true;
+	}
+
+	std::string JointSpecFile::writeJson(const std::vector<JointSpec>& specs) {
+		auto json = Json::object();
+		json.set("units", "cm");
+
+		auto& joints = json.set("joints", Json::array());
+		for (auto& spec : specs)
+			joints.push(spec.toJson());
+
+		return json.dump() + "\n";
+	}
+
+	std::string JointSpecFile::writeCsv(const std::vector<JointSpec>& specs) {
+		auto number = [](double value) { return Json(value).dump(); };
+
+		std::string text = "name,units,length,width,thickness,ballDiameter,boltHoleDiameter,rows,cols,cells,transform\n";
+		for (auto& spec : specs) {
+			std::string cells;
+			for (auto row = 1; row <= spec.rows; row++) {
+				for (auto col = 1; col <= spec.cols; col++) {
+					auto& cell = spec.cell(row, col);
+					cells += (col > 1 ? ";" : row > 1 ? "|" : "") + cell.type + ":" + number(cell.holeDiameter);
+				}
+			}
+
+			std::string transform;
+			for (auto v : spec.transform)
+				transform += (transform.empty() ? "" : " ") + number(v);
+
+			text += csvQuote(spec.name) + ",cm," + number(spec.length) + "," + number(spec.width) + "," + number(spec.thickness) + "," +
+				number(spec.ballDiameter) + "," + number(spec.boltHoleDiameter) + "," + std::to_string(spec.rows) + "," +
+				std::to_string(spec.cols) + "," + cells + "," + transform + "\n";
+		}
+		return text;
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "Json.h"
+#include "Units.h"
+
+namespace ArmatureJoint {
+	// The joint the create command starts from.
+	namespace Defaults {
+		constexpr Length length = 15_mm;
+		constexpr Length width = 6_mm;
+		constexpr Length thickness = 1_in / 16;
+		constexpr Length ballDiameter = 5_mm;
+		constexpr Length boltHoleDiameter = 3_mm;
+		constexpr Length holeDiameter = 3_mm;
+		constexpr int rows = 2;
+		constexpr int cols = 1;
+		constexpr int maxRows = 100;
+		constexpr int maxCols = 20;
+	}
+
+	struct JointCell {
+		std::string type;
+		double holeDiameter;
+
+		static JointCell defaults();
+	};
+
+	// Everything needed to generate one joint, independent of the command dialog. Lengths are in internal units (cm).
+	struct JointSpec {
+		std::string name;
+		double length;
+		double width;
+		double thickness;
+		double ballDiameter;
+		double boltHoleDiameter;
+		int rows;
+		int cols;
+		std::vector<JointCell> cells; // row major, rows * cols
+		std::array<double, 16> transform; // row major placement, as taken by Matrix3D::setWithArray
+
+		JointSpec();
+
+		static JointSpec defaults();
+
+		JointCell& cell(int row, int col);
+		const JointCell& cell(int row, int col) const;
+		void resize(int rows, int cols, const JointCell& fill);
+
+		Json toJson() const;
+		static bool fromJson(const Json& json, const JointSpec& defaults, const JointCell& defaultCell, double unitScale, JointSpec& spec, std::string& error);
+	};
+
+	// A change applied to many joints at once. Only the fields whose flag is set are changed, and only on joints matching the filter.
+	struct JointChange {
+		bool matchBallDiameter;
+		double matchedBallDiameter;
+		bool changeBallDiameter;
+		double ballDiameter;
+		bool changeThickness;
+		double thickness;
+		bool changeBoltHoleDiameter;
+		double boltHoleDiameter;
+		bool changeHoleDiameter;
+		double holeDiameter;
+
+		JointChange();
+
+		bool matches(const JointSpec& spec) const;
+		bool apply(JointSpec& spec) const;
+	};
+
+	// Reads joint lists from a JSON file ({"units": "mm", "joints": [{"name", "length", ..., "cells": [["Ball", {"type": "Nut", "holeDiameter": 3}]], "transform": [16]}]})
+	// or a CSV file with a header row naming the same fields, where cells are written as "Ball:3;Nut|None;Ball". Missing fields take the defaults.
+	// Binary .armature files are read and written with ArmatureFile. Text files are written in centimetres, so every form round trips exactly.
+	class JointSpecFile {
+	public:
+		static bool read(const std::string& path, const JointSpec& defaults, const JointCell& defaultCell, std::vector<JointSpec>& specs, std::string& error);
+		static bool readJson(const std::string& text, const JointSpec& defaults, const JointCell& defaultCell, std::vector<JointSpec>& specs, std::string& error);
+		static bool readCsv(const std::string& text, const JointSpec& defaults, const JointCell& defaultCell, std::vector<JointSpec>& specs, std::string& error);
+		static bool write(const std::string& path, const std::vector<JointSpec>& specs, std::string& error);
+		static std::string writeJson(const std::vector<JointSpec>& specs);
+		static std::string writeCsv(const std::vector<JointSpec>& specs);
+		static double unitScale(const std::string& units);
+	};
+}
@@ -0,0 +1,344 @@
+#include "Json.h"
+
+#include <cstdlib>
+#include <cstdio>
+#include <cstring>
+#include <math.h>
+
+namespace ArmatureJoint {
+	namespace {
+		const Json nullJson;
+
+		class Parser {
+		public:
+			Parser(const std::string& _text) : text(_text), pos(0) {}
+
+			bool parse(Json& result, std::string& error) {
+				if (!value(result, error))
+					return false;
+
+				whitespace();
+				if (pos != text.size())
+					return fail("unexpected trailing characters", error);
+
+				return true;
+			}
+
+		private:
+			const std::string& text;
+			size_t pos;
+
+			bool fail(const std::string& message, std::string& error) {
+				error = message + " at offset " + std::to_string(pos);
+				return false;
+			}
+
+			void whitespace() {
+				while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\r' || text[pos] == '\n'))
+					pos++;
+			}
+
+			bool literal(const char* word) {
+				auto start = pos;
+				for (auto c = word; *c; c++, pos++) {
+					if (pos >= text.size() || text[pos] != *c) {
+						pos = start;
+						return false;
+					}
+				}
+				return true;
+			}
+
+			bool value(Json& result, std::string& error) {
+				whitespace();
+				if (pos >= text.size())
+					return fail("unexpected end of input", error);
+
+				auto c = text[pos];
+				if (c == '{')
+					return object(result, error);
+				if (c == '[')
+					return array(result, error);
+				if (c == '"') {
+					std::string s;
+					if (!string(s, error))
+						return false;
+					result = Json(s);
+					return true;
+				}
+				if (literal("true")) {
+					result = Json(true);
+					return true;
+				}
+				if (literal("false")) {
+					result = Json(false);
+					return true;
+				}
+				if (literal("null")) {
+					result = Json();
+					return true;
+				}
+
+				// strtod also reads nan, inf and hex, which are not JSON, so only decimal characters may be consumed.
+				const char* start = text.c_str() + pos;
+				char* end = nullptr;
+				auto number = strtod(start, &end);
+				if (end == start || strspn(start, "+-.0123456789eE") != (size_t)(end - start))
+					return fail("unexpected character", error);
+				if (!isfinite(number))
+					return fail("number out of range", error);
+
+				pos += end - start;
+				result = Json(number);
+				return true;
+			}
+
+			bool string(std::string& result, std::string& error) {
+				pos++; // opening quote
+				while (pos < text.size()) {
+					auto c = text[pos++];
+					if (c == '"')
+						return true;
+
+					if (c != '\\') {
+						result += c;
+						continue;
+					}
+
+					if (pos >= text.size())
+						break;
+
+					auto escaped = text[pos++];
+					switch (escaped) {
+					case 'n': result += '\n'; break;
+					case 't': result += '\t'; break;
+					case 'r': result += '\r'; break;
+					case 'b': result += '\b'; break;
+					case 'f': result += '\f'; break;
+					case 'u': {
+						if (pos + 4 > text.size())
+							return fail("truncated unicode escape", error);
+
+						auto code = strtoul(text.substr(pos, 4).c_str(), nullptr, 16);
+						pos += 4;
+						if (code < 0x80) {
+							result += (char)code;
+						}
+						else if (code < 0x800) {
+							result += (char)(0xC0 | (code >> 6));
+							result += (char)(0x80 | (code & 0x3F));
+						}
+						else {
+							result += (char)(0xE0 | (code >> 12));
+							result += (char)(0x80 | ((code >> 6) & 0x3F));
+							result += (char)(0x80 | (code & 0x3F));
+						}
+						break;
+					}
+					default: result += escaped; break;
+					}
+				}
+				return fail("unterminated string", error);
+			}
+
+			bool array(Json& result, std::string& error) {
+				pos++;
+				result = Json::array();
+
+				whitespace();
+				if (pos < text.size() && text[pos] == ']') {
+					pos++;
+					return true;
+				}
+
+				while (true) {
+					Json item;
+					if (!value(item, error))
+						return false;
+					result.push(item);
+
+					whitespace();
+					if (pos < text.size() && text[pos] == ',') {
+						pos++;
+						continue;
+					}
+					if (pos < text.size() && text[pos] == ']') {
+						pos++;
+						return true;
+					}
+					return fail("expected ',' or ']'", error);
+				}
+			}
+
+			bool object(Json& result, std::string& error) {
+				pos++;
+				result = Json::object();
+
+				whitespace();
+				if (pos < text.size() && text[pos] == '}') {
+					pos++;
+					return true;
+				}
+
+				while (true) {
+					whitespace();
+					if (pos >= text.size() || text[pos] != '"')
+						return fail("expected member name", error);
+
+					std::string key;
+					if (!string(key, error))
+						return false;
+
+					whitespace();
+					if (pos >= text.size() || text[pos] != ':')
+						return fail("expected ':'", error);
+					pos++;
+
+					Json item;
+					if (!value(item, error))
+						return false;
+					result.set(key, item);
+
+					whitespace();
+					if (pos < text.size() && text[pos] == ',') {
+						pos++;
+						continue;
+					}
+					if (pos < text.size() && text[pos] == '}') {
+						pos++;
+						return true;
+					}
+					return fail("expected ',' or '}'", error);
+				}
+			}
+		};
+	}
+
+	Json Json::array() {
+		Json json;
+		json._type = Array;
+		return json;
+	}
+
+	Json Json::object() {
+		Json json;
+		json._type = Object;
+		return json;
+	}
+
+	bool Json::parse(const std::string& text, Json& result, std::string& error) {
+		Parser parser(text);
+		return parser.parse(result, error);
+	}
+
+	size_t Json::size() const {
+		if (_type == Array)
+			return _array.size();
+		if (_type == Object)
+			return _object.size();
+		return 0;
+	}
+
+	const Json& Json::operator[](size_t index) const {
+		if (_type != Array || index >= _array.size())
+			return nullJson;
+
+		return _array[index];
+	}
+
+	const Json& Json::operator[](const std::string& key) const {
+		for (auto& member : _object) {
+			if (member.first == key)
+				return member.second;
+		}
+		return nullJson;
+	}
+
+	bool Json::has(const std::string& key) const {
+		for (auto& member : _object) {
+			if (member.first == key)
+				return true;
+		}
+		return false;
+	}
+
+	Json& Json::push(const Json& value) {
+		_type = Array;
+		_array.push_back(value);
+		return _array.back();
+	}
+
+	Json& Json::set(const std::string& key, const Json& value) {
+		_type = Object;
+		for (auto& member : _object) {
+			if (member.first == key) {
+				member.second = value;
+				return member.second;
+			}
+		}
+		_object.push_back(std::make_pair(key, value));
+		return _object.back().second;
+	}
+
+	std::string Json::dump() const {
+		std::string out;
+		dump(out);
+		return out;
+	}
+
+	void Json::dump(std::string& out) const {
+		switch (_type) {
+		case Null:
+			out += "null";
+			break;
+		case Bool:
+			out += _bool ? "true" : "false";
+			break;
+		case Number: {
+			// The shortest form that reads back as the same double, so values survive a round trip through text.
+			char buffer[32];
+			for (auto precision = 15; precision <= 17; precision++) {
+				snprintf(buffer, sizeof(buffer), "%.*g", precision, _number);
+				if (strtod(buffer, nullptr) == _number)
+					break;
+			}
+			out += buffer;
+			break;
+		}
+		case String:
+			out += '"';
+			for (auto c : _string) {
+				switch (c) {
+				case '"': out += "\\\""; break;
+				case '\\': out += "\\\\"; break;
+				case '\n': out += "\\n"; break;
+				case '\r': out += "\\r"; break;
+				case '\t': out += "\\t"; break;
+				default: out += c; break;
+				}
+			}
+			out += '"';
+			break;
+		case Array:
+			out += '[';
+			for (size_t i = 0; i < _array.size(); i++) {
+				if (i > 0)
+					out += ',';
+				_array[i].dump(out);
+			}
+			out += ']';
+			break;
+		case Object:
+			out += '{';
+			for (size_t i = 0; i < _object.size(); i++) {
+				if (i > 0)
+					out += ',';
+				Json(_object[i].first).dump(out);
+				out += ':';
+				_object[i].second.dump(out);
+			}
+			out += '}';
+			break;
+		}
+	}
+}
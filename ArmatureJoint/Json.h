@@ -0,0 +1,56 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <utility>
+
+namespace ArmatureJoint {
+	// Minimal JSON document used for joint specification files and the spec attribute stored on generated components.
+	class Json {
+	public:
+		enum Type { Null, Bool, Number, String, Array, Object };
+
+		Json() : _type(Null), _bool(false), _number(0) {}
+		Json(bool value) : _type(Bool), _bool(value), _number(0) {}
+		Json(double value) : _type(Number), _bool(false), _number(value) {}
+		Json(int value) : _type(Number), _bool(false), _number(value) {}
+		Json(const std::string& value) : _type(String), _bool(false), _number(0), _string(value) {}
+		Json(const char* value) : _type(String), _bool(false), _number(0), _string(value) {}
+
+		static Json array();
+		static Json object();
+		static bool parse(const std::string& text, Json& result, std::string& error);
+
+		Type type() const { return _type; }
+		bool isNull() const { return _type == Null; }
+		bool isNumber() const { return _type == Number; }
+		bool isString() const { return _type == String; }
+		bool isArray() const { return _type == Array; }
+		bool isObject() const { return _type == Object; }
+
+		bool boolValue() const { return _bool; }
+		double number() const { return _number; }
+		const std::string& string() const { return _string; }
+
+		size_t size() const;
+		const Json& operator[](size_t index) const;
+		const Json& operator[](const std::string& key) const;
+		bool has(const std::string& key) const;
+		const std::vector<std::pair<std::string, Json>>& members() const { return _object; }
+
+		Json& push(const Json& value);
+		Json& set(const std::string& key, const Json& value);
+
+		std::string dump() const;
+
+	private:
+		Type _type;
+		bool _bool;
+		double _number;
+		std::string _string;
+		std::vector<Json> _array;
+		std::vector<std::pair<std::string, Json>> _object;
+
+		void dump(std::string& out) const;
+	};
+}
@@ -0,0 +1,316 @@
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <algorithm>
+
+#include "Layout.h"
+#include "UI.h"
+
+#define NODE(n) (1u << (n))
+
+namespace ArmatureJoint {
+	// The nodes each node is computed from directly.
+	const unsigned Layout::dependencies[NodeCount] = {
+		0, // Length
+		0, // Width
+		0, // Thickness
+		0, // BallDiameter
+		0, // BoltHoleDiameter
+		0, // Grid
+		NODE(BallDiameter), // BallRadius
+		NODE(BallRadius), // BallOffset
+		NODE(BallRadius), // ChamferLength
+		NODE(BallOffset) | NODE(ChamferLength), // PlateOffset
+		NODE(Thickness) | NODE(PlateOffset), // BallZ
+		NODE(BallRadius) | NODE(BallOffset), // CircleRadius
+		NODE(CircleRadius), // CircleArea
+		NODE(Width) | NODE(Grid), // RowSize
+		NODE(Length) | NODE(BallRadius) | NODE(Grid), // ColumnPitch
+		NODE(CircleRadius) | NODE(Grid), // MinWidth
+		NODE(BallRadius) | NODE(CircleRadius) | NODE(MinWidth) | NODE(Grid), // MinLength
+		NODE(RowSize) | NODE(BallOffset), // MaxBallDiameter
+		NODE(BoltHoleDiameter), // BoltCircleArea
+		NODE(Grid), // BallCount
+		NODE(Grid), // NutCount
+		NODE(Length) | NODE(Width) | NODE(BoltCircleArea) | NODE(CircleArea) | NODE(BallCount), // ExpectedArea
+	};
+
+	double Layout::circleRadiusOfSphere(double sphereRadius, double offset) {
+		return sqrt(pow(sphereRadius, 2) - pow(offset, 2));
+	}
+
+	double Layout::diameterForCircleRadiusOfSphere(double circleRadius, double offset) {
+		return sqrt(pow(circleRadius, 2) + pow(offset, 2)) * 2;
+	}
+
+	Layout::Layout() : valid(0) {
+	}
+
+	Layout::Layout(const JointSpec& spec) : _spec(spec), valid(0) {
+	}
+
+	const JointSpec& Layout::spec() const {
+		return _spec;
+	}
+
+	void Layout::spec(const JointSpec& spec) {
+		_spec = spec;
+		valid = 0;
+	}
+
+	void Layout::placement(const std::array<double, 16>& transform) {
+		_spec.transform = transform;
+	}
+
+	void Layout::snapshot(double* values) const {
+		static_assert(snapshotSize == NodeCount, "The snapshot holds every node.");
+
+		for (auto node = 0; node < NodeCount; node++)
+			values[node] = value((Node)node);
+	}
+
+	void Layout::restore(const double* values) {
+		std::copy(values, values + NodeCount, cache.begin());
+		valid = NODE(NodeCount) - 1;
+	}
+
+	double Layout::value(Node node) const {
+		if (!(valid & NODE(node))) {
+			cache[node] = compute(node);
+			valid |= NODE(node);
+		}
+		return cache[node];
+	}
+
+	double Layout::compute(Node node) const {
+		switch (node) {
+		case Length: return _spec.length;
+		case Width: return _spec.width;
+		case Thickness: return _spec.thickness;
+		case BallDiameter: return _spec.ballDiameter;
+		case BoltHoleDiameter: return _spec.boltHoleDiameter;
+		case Grid: return _spec.rows * _spec.cols;
+		case BallRadius: return value(BallDiameter) / 2;
+		case BallOffset: return value(BallRadius) / 1.2;
+		case ChamferLength: return value(BallRadius) / 6;
+		case PlateOffset: return value(BallOffset) - (value(ChamferLength) / 1.25);
+		case BallZ: return value(Thickness) + value(PlateOffset);
+		case CircleRadius: return circleRadiusOfSphere(value(BallRadius), value(BallOffset));
+		case CircleArea: return M_PI * pow(value(CircleRadius), 2);
+		case RowSize: return value(Width) / (double)_spec.rows;
+		case ColumnPitch: return _spec.cols > 1 ? (value(Length) - (2 * (value(BallRadius) / 1.25))) / (double)(_spec.cols - 1) : 0;
+		case MinWidth: return ((value(CircleRadius) * 2) + 0.05) * _spec.rows;
+		case MinLength: return std::max(value(MinWidth), (2 * (value(BallRadius) / 1.25)) + (((value(CircleRadius) * 2) + 0.05) * (_spec.cols - 1)));
+		case MaxBallDiameter: return diameterForCircleRadiusOfSphere(value(RowSize) + 0.05, value(BallOffset));
+		case BoltCircleArea: return M_PI * pow(value(BoltHoleDiameter) / 2, 2);
+		case BallCount: return count(ARMATURE_JOINT_OPTION_BALL);
+		case NutCount: return count(ARMATURE_JOINT_OPTION_NUT);
+		case ExpectedArea: return (value(Length) * value(Width)) - (value(BoltCircleArea) + (value(CircleArea) * value(BallCount)));
+		default: return 0;
+		}
+	}
+
+	int Layout::count(const std::string& jointType) const {
+		int num = 0;
+		for (auto& cell : _spec.cells) {
+			if (cell.type == jointType)
+				num++;
+		}
+		return num;
+	}
+
+	// Nodes are declared in dependency order, so one pass marks everything downstream of the change.
+	void Layout::invalidate(Node changed) {
+		auto stale = NODE(changed);
+		for (auto node = (int)changed + 1; node < NodeCount; node++) {
+			if (dependencies[node] & stale)
+				stale |= NODE(node);
+		}
+		valid &= ~stale;
+	}
+
+	std::string Layout::name() const {
+		return _spec.name;
+	}
+
+	void Layout::name(const std::string& name) {
+		_spec.name = name;
+	}
+
+	double Layout::length() const {
+		return value(Length);
+	}
+
+	void Layout::length(double length) {
+		_spec.length = length;
+		invalidate(Length);
+	}
+
+	double Layout::width() const {
+		return value(Width);
+	}
+
+	void Layout::width(double width) {
+		_spec.width = width;
+		invalidate(Width);
+	}
+
+	double Layout::thickness() const {
+		return value(Thickness);
+	}
+
+	void Layout::thickness(double thickness) {
+		_spec.thickness = thickness;
+		invalidate(Thickness);
+	}
+
+	double Layout::ballDiameter() const {
+		return value(BallDiameter);
+	}
+
+	void Layout::ballDiameter(double ballDiameter) {
+		_spec.ballDiameter = ballDiameter;
+		invalidate(BallDiameter);
+	}
+
+	double Layout::boltHoleDiameter() const {
+		return value(BoltHoleDiameter);
+	}
+
+	void Layout::boltHoleDiameter(double boltHoleDiameter) {
+		_spec.boltHoleDiameter = boltHoleDiameter;
+		invalidate(BoltHoleDiameter);
+	}
+
+	int Layout::rows() const {
+		return _spec.rows;
+	}
+
+	int Layout::cols() const {
+		return _spec.cols;
+	}
+
+	void Layout::resize(int rows, int cols, const JointCell& fill) {
+		if (rows == _spec.rows && cols == _spec.cols)
+			return;
+
+		_spec.resize(rows, cols, fill);
+		invalidate(Grid);
+	}
+
+	std::string Layout::jointType(int row, int col) const {
+		return _spec.cell(row, col).type;
+	}
+
+	double Layout::holeDiameter(int row, int col) const {
+		return _spec.cell(row, col).holeDiameter;
+	}
+
+	// Hole diameters feed no derived value, so only a change of joint type invalidates anything.
+	void Layout::cell(int row, int col, const JointCell& cell) {
+		auto& current = _spec.cell(row, col);
+		auto typeChanged = current.type != cell.type;
+
+		current = cell;
+		if (typeChanged)
+			invalidate(Grid);
+	}
+
+	double Layout::ballRadius() const {
+		return value(BallRadius);
+	}
+
+	double Layout::ballOffset() const {
+		return value(BallOffset);
+	}
+
+	double Layout::plateOffset() const {
+		return value(PlateOffset);
+	}
+
+	// The first and last columns sit at the plate ends, any others are spread evenly between them.
+	double Layout::ballX(int col) const {
+		return (ballRadius() / 1.25) + (columnPitch() * (col - 1));
+	}
+
+	double Layout::columnPitch() const {
+		return value(ColumnPitch);
+	}
+
+	// Screw holes leave between the plates, as a unit vector in the joint's frame: x along the length and z down the
+	// rows. The end columns point out of their plate end; the columns between would run into their neighbours that
+	// way, so they point out of the nearer plate side, and Validator rejects any that still meet a ball or nut.
+	Vector3 Layout::ballHoleDirection(int row, int col) const {
+		if (col == 1 || col == _spec.cols)
+			return Vector3(col * 2 <= _spec.cols + 1 ? -1 : 1, 0, 0);
+
+		return Vector3(0, 0, row * 2 <= _spec.rows + 1 ? -1 : 1);
+	}
+
+	double Layout::ballY(int row) const {
+		auto rowSize = value(RowSize);
+
+		return -((rowSize * row) - (rowSize / 2));
+	}
+
+	double Layout::ballZ() const {
+		return value(BallZ);
+	}
+
+	double Layout::circleRadius() const {
+		return value(CircleRadius);
+	}
+
+	double Layout::circleArea() const {
+		return value(CircleArea);
+	}
+
+	double Layout::circleCircumference() const {
+		return 2 * M_PI * circleRadius();
+	}
+
+	double Layout::minWidth() const {
+		return value(MinWidth);
+	}
+
+	double Layout::minLength() const {
+		return value(MinLength);
+	}
+
+	double Layout::maxBallDiameter() const {
+		return value(MaxBallDiameter);
+	}
+
+	double Layout::boltHoleRadius() const {
+		return boltHoleDiameter() / 2;
+	}
+
+	double Layout::boltCircleArea() const {
+		return value(BoltCircleArea);
+	}
+
+	double Layout::holeRadius(int row, int col) const {
+		return holeDiameter(row, col) / 2;
+	}
+
+	double Layout::chamferLength() const {
+		return value(ChamferLength);
+	}
+
+	double Layout::chamferAngle() const {
+		return (45_deg).radians();
+	}
+
+	double Layout::expectedArea() const {
+		return value(ExpectedArea);
+	}
+
+	int Layout::numJointTypes(const std::string& jointType) const {
+		if (jointType == ARMATURE_JOINT_OPTION_BALL)
+			return (int)value(BallCount);
+
+		if (jointType == ARMATURE_JOINT_OPTION_NUT)
+			return (int)value(NutCount);
+
+		return count(jointType);
+	}
+}
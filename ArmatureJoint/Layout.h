@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <string>
+
+#include "Geometry.h"
+#include "JointSpec.h"
+
+namespace ArmatureJoint {
+	// The joint geometry derived from a spec, independent of Fusion. Derived values are cached nodes in a small
+	// dependency graph: changing a spec field only invalidates the nodes that depend on it.
+	class Layout {
+	public:
+		static double circleRadiusOfSphere(double sphereRadius, double offset);
+		static double diameterForCircleRadiusOfSphere(double circleRadius, double offset);
+
+		Layout();
+		explicit Layout(const JointSpec& spec);
+
+		const JointSpec& spec() const;
+		void spec(const JointSpec& spec);
+		void placement(const std::array<double, 16>& transform);
+
+		std::string name() const;
+		void name(const std::string& name);
+		double length() const;
+		void length(double length);
+		double width() const;
+		void width(double width);
+		double thickness() const;
+		void thickness(double thickness);
+		double ballDiameter() const;
+		void ballDiameter(double ballDiameter);
+		double boltHoleDiameter() const;
+		void boltHoleDiameter(double boltHoleDiameter);
+		int rows() const;
+		int cols() const;
+		void resize(int rows, int cols, const JointCell& fill);
+		std::string jointType(int row, int col) const;
+		double holeDiameter(int row, int col) const;
+		void cell(int row, int col, const JointCell& cell);
+
+		double ballRadius() const;
+		double ballOffset() const;
+		double plateOffset() const;
+		double ballX(int col) const;
+		double columnPitch() const;
+		Vector3 ballHoleDirection(int row, int col) const;
+		double ballY(int row) const;
+		double ballZ() const;
+		double circleRadius() const;
+		double circleArea() const;
+		double circleCircumference() const;
+		double minWidth() const;
+		double minLength() const;
+		double maxBallDiameter() const;
+		double boltHoleRadius() const;
+		double boltCircleArea() const;
+		double holeRadius(int row, int col) const;
+		double chamferLength() const;
+		double chamferAngle() const;
+		double expectedArea() const;
+		int numJointTypes(const std::string& jointType) const;
+
+		// Every derived value at once, so a layout worked out ahead of time can be restored without recomputing it.
+		// Restoring assumes the values were taken from a layout with the current spec.
+		static const size_t snapshotSize = 22;
+		void snapshot(double* values) const;
+		void restore(const double* values);
+
+	protected:
+		JointSpec _spec;
+
+	private:
+		// Spec fields first, then derived nodes in dependency order.
+		enum Node {
+			Length,
+			Width,
+			Thickness,
+			BallDiameter,
+			BoltHoleDiameter,
+			Grid,
+			BallRadius,
+			BallOffset,
+			ChamferLength,
+			PlateOffset,
+			BallZ,
+			CircleRadius,
+			CircleArea,
+			RowSize,
+			ColumnPitch,
+			MinWidth,
+			MinLength,
+			MaxBallDiameter,
+			BoltCircleArea,
+			BallCount,
+			NutCount,
+			ExpectedArea,
+			NodeCount
+		};
+
+		static const unsigned dependencies[NodeCount];
+
+		mutable unsigned valid;
+		mutable std::array<double, NodeCount> cache;
+
+		double value(Node node) const;
+		double compute(Node node) const;
+		int count(const std::string& jointType) const;
+		void invalidate(Node changed);
+	};
+}
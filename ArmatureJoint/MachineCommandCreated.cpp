@@ -0,0 +1,74 @@
+#include "MachineCommandCreated.h"
+
+#include "UI.h"
+#include "Units.h"
+
+namespace ArmatureJoint {
+	void MachineCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto inputs = cmd->commandInputs();
+		if (!inputs)
+			return;
+
+		auto sheetWidthInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_MACHINE_SHEET_WIDTH_INPUT_ID,
+			"Sheet Width",
+			ValueInput::createByReal((300_mm).centimetres())
+		);
+		if (!sheetWidthInput)
+			return;
+
+		sheetWidthInput->tooltip("Width of the stock sheets the plates are machined from");
+
+		auto sheetHeightInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_MACHINE_SHEET_HEIGHT_INPUT_ID,
+			"Sheet Height",
+			ValueInput::createByReal((300_mm).centimetres())
+		);
+		if (!sheetHeightInput)
+			return;
+
+		sheetHeightInput->tooltip("Height of the stock sheets the plates are machined from");
+
+		auto spacingInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_MACHINE_SPACING_INPUT_ID,
+			"Spacing",
+			ValueInput::createByReal((6_mm).centimetres())
+		);
+		if (!spacingInput)
+			return;
+
+		spacingInput->tooltip("Gap left between neighbouring plates for the cutter to pass");
+
+		auto rotateInput = inputs->addBoolValueInput(ARMATURE_JOINT_MACHINE_ROTATE_INPUT_ID, "Allow Rotation", true, "", true);
+		if (!rotateInput)
+			return;
+
+		rotateInput->tooltip("Lets plates turn a quarter to fit the sheets better");
+
+		auto generateInput = inputs->addBoolValueInput(ARMATURE_JOINT_MACHINE_GENERATE_INPUT_ID, "Generate Toolpaths", true, "", true);
+		if (!generateInput)
+			return;
+
+		generateInput->tooltip("Generates every new setup's toolpaths in one background job once the setups are made");
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
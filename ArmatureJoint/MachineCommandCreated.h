@@ -0,0 +1,19 @@
+#pragma once
+
+#include "MachineCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class MachineCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<MachineCommandExecuted> _onExecute;
+
+	public:
+		MachineCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<MachineCommandExecuted>(new MachineCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
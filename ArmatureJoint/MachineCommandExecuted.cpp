@@ -0,0 +1,121 @@
+#include "MachineCommandExecuted.h"
+
+#include "JointAttributes.h"
+#include "PlateMachining.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	void MachineCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto command = eventArgs->command();
+		if (!command)
+			return;
+
+		auto inputs = command->commandInputs();
+		if (!inputs)
+			return;
+
+		auto sheetWidthInput = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_MACHINE_SHEET_WIDTH_INPUT_ID));
+		auto sheetHeightInput = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_MACHINE_SHEET_HEIGHT_INPUT_ID));
+		auto spacingInput = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_MACHINE_SPACING_INPUT_ID));
+		auto rotateInput = static_cast<Ptr<BoolValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_MACHINE_ROTATE_INPUT_ID));
+		auto generateInput = static_cast<Ptr<BoolValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_MACHINE_GENERATE_INPUT_ID));
+		if (!sheetWidthInput || !sheetHeightInput || !spacingInput || !rotateInput || !generateInput)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto ui = app->userInterface();
+		if (!ui)
+			return;
+
+		if (JointAttributes::joints(design).empty()) {
+			ui->messageBox("There are no armature joints in the design.", "Machine Plates");
+			return;
+		}
+
+		auto document = app->activeDocument();
+		auto products = document ? document->products() : nullptr;
+		auto cam = products ? static_cast<Ptr<adsk::cam::CAM>>(products->itemByProductType("CAMProductType")) : nullptr;
+		if (!cam) {
+			ui->messageBox("This document has no manufacturing workspace to add setups to.", "Machine Plates");
+			return;
+		}
+
+		// The template last used with this design is offered first.
+		auto attributes = design->attributes();
+		auto stored = attributes ? attributes->itemByName(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_CAM_TEMPLATE) : nullptr;
+
+		auto fileDialog = ui->createFileDialog();
+		if (!fileDialog)
+			return;
+
+		fileDialog->title("Select Plate Operations Template");
+		fileDialog->filter(ARMATURE_JOINT_MACHINE_FILE_FILTER);
+		fileDialog->isMultiSelectEnabled(false);
+		if (stored)
+			fileDialog->initialFilename(stored->value());
+
+		if (fileDialog->showOpen() != DialogResults::DialogOK)
+			return;
+
+		auto path = fileDialog->filename();
+		auto operations = adsk::cam::CAMTemplate::createFromFile(path);
+		if (!operations) {
+			ui->messageBox("Could not read " + path, "Machine Plates");
+			return;
+		}
+
+		if (attributes) {
+			if (stored)
+				stored->value(path);
+			else
+				attributes->add(ARMATURE_JOINT_ATTRIBUTE_GROUP, ARMATURE_JOINT_ATTRIBUTE_CAM_TEMPLATE, path);
+		}
+
+		auto machining = PlateMachining::create(design, cam);
+		if (!machining)
+			return;
+
+		if (!machining->layOut(sheetWidthInput->value(), sheetHeightInput->value(), spacingInput->value(), rotateInput->value())) {
+			ui->messageBox("Could not lay the plates out on sheets.", "Machine Plates");
+			return;
+		}
+
+		if (!machining->addSetups(operations)) {
+			ui->messageBox("Could not create the machining setups.", "Machine Plates");
+			return;
+		}
+
+		auto message = "Laid " + std::to_string(machining->plates()) + " plates on " + std::to_string(machining->sheets().size()) + " sheets, with a setup for each.";
+		if (machining->unplaced() > 0)
+			message += " " + std::to_string(machining->unplaced()) + " plates are larger than a sheet and were left out.";
+
+		if (machining->withoutOperations() > 0)
+			message += " The template added no operations to " + std::to_string(machining->withoutOperations()) + " of the setups.";
+
+		auto& skipped = machining->skipped();
+		if (!skipped.empty()) {
+			message += "\n\nThese joints were left out because their plate bodies are missing; regenerate them to include them:";
+			for (auto& name : skipped)
+				message += "\n" + name;
+		}
+
+		if (generateInput->value()) {
+			if (machining->generate())
+				message += "\n\nToolpaths are being generated in the background.";
+			else
+				message += "\n\nToolpath generation could not be started.";
+		}
+
+		ui->messageBox(message, "Machine Plates");
+	}
+}
@@ -0,0 +1,86 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ArmatureJoint {
+	MappedFile::MappedFile() : _data(nullptr), _size(0) {
+#ifdef _WIN32
+		file = INVALID_HANDLE_VALUE;
+		mapping = nullptr;
+#endif
+	}
+
+	MappedFile::~MappedFile() {
+#ifdef _WIN32
+		if (_data)
+			UnmapViewOfFile(_data);
+		if (mapping)
+			CloseHandle(mapping);
+		if (file != INVALID_HANDLE_VALUE)
+			CloseHandle(file);
+#else
+		if (_data)
+			munmap((void*)_data, _size);
+#endif
+	}
+
+	// Empty files cannot be mapped, and no format here is empty, so they fail like missing ones.
+	std::unique_ptr<MappedFile> MappedFile::open(const std::string& path) {
+		auto mapped = std::unique_ptr<MappedFile>(new MappedFile());
+
+#ifdef _WIN32
+		mapped->file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (mapped->file == INVALID_HANDLE_VALUE)
+			return nullptr;
+
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(mapped->file, &size) || size.QuadPart == 0)
+			return nullptr;
+
+		mapped->mapping = CreateFileMappingA(mapped->file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapped->mapping)
+			return nullptr;
+
+		mapped->_data = (const char*)MapViewOfFile(mapped->mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!mapped->_data)
+			return nullptr;
+
+		mapped->_size = (size_t)size.QuadPart;
+#else
+		auto descriptor = ::open(path.c_str(), O_RDONLY);
+		if (descriptor < 0)
+			return nullptr;
+
+		struct stat status;
+		if (fstat(descriptor, &status) != 0 || status.st_size == 0) {
+			close(descriptor);
+			return nullptr;
+		}
+
+		auto view = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		close(descriptor);
+		if (view == MAP_FAILED)
+			return nullptr;
+
+		mapped->_data = (const char*)view;
+		mapped->_size = (size_t)status.st_size;
+#endif
+
+		return mapped;
+	}
+
+	const char* MappedFile::data() const {
+		return _data;
+	}
+
+	size_t MappedFile::size() const {
+		return _size;
+	}
+}
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <stddef.h>
+#include <memory>
+#include <string>
+
+namespace ArmatureJoint {
+	// A whole file mapped read only, for binary formats that are used in place rather than parsed.
+	class MappedFile {
+	public:
+		~MappedFile();
+
+		static std::unique_ptr<MappedFile> open(const std::string& path);
+
+		const char* data() const;
+		size_t size() const;
+
+	private:
+		MappedFile();
+
+		const char* _data;
+		size_t _size;
+
+#ifdef _WIN32
+		void* file;
+		void* mapping;
+#endif
+	};
+}
@@ -0,0 +1,44 @@
+#include "MassCommandCreated.h"
+
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		bool addDensity(Ptr<CommandInputs> inputs, const std::string& id, const std::string& name, double density) {
+			auto input = inputs->addValueInput(id, name, "", ValueInput::createByReal(density));
+			if (!input)
+				return false;
+
+			input->tooltip("Density in grams per cubic centimetre");
+			return true;
+		}
+	}
+
+	void MassCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto inputs = cmd->commandInputs();
+		if (!inputs)
+			return;
+
+		// Brass plates, steel balls and nuts.
+		if (!addDensity(inputs, ARMATURE_JOINT_MASS_PLATE_DENSITY_INPUT_ID, "Plate Density (g/cm^3)", 8.5))
+			return;
+
+		if (!addDensity(inputs, ARMATURE_JOINT_MASS_BALL_DENSITY_INPUT_ID, "Ball Density (g/cm^3)", 7.85))
+			return;
+
+		if (!addDensity(inputs, ARMATURE_JOINT_MASS_NUT_DENSITY_INPUT_ID, "Nut Density (g/cm^3)", 7.85))
+			return;
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
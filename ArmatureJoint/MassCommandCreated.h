@@ -0,0 +1,19 @@
+#pragma once
+
+#include "MassCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class MassCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<MassCommandExecuted> _onExecute;
+
+	public:
+		MassCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<MassCommandExecuted>(new MassCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
@@ -0,0 +1,104 @@
+#include "MassCommandExecuted.h"
+
+#include <map>
+
+#include "JointAttributes.h"
+#include "MassProperties.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		double value(Ptr<CommandInputs> inputs, const char* id) {
+			auto input = static_cast<Ptr<ValueCommandInput>>(inputs->itemById(id));
+			return input ? input->value() : 0;
+		}
+
+		std::string number(double value) {
+			char text[32];
+			snprintf(text, sizeof(text), "%.4g", value);
+			return text;
+		}
+	}
+
+	void MassCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto command = eventArgs->command();
+		if (!command)
+			return;
+
+		auto inputs = command->commandInputs();
+		if (!inputs)
+			return;
+
+		Materials materials;
+		materials.plate = value(inputs, ARMATURE_JOINT_MASS_PLATE_DENSITY_INPUT_ID);
+		materials.ball = value(inputs, ARMATURE_JOINT_MASS_BALL_DENSITY_INPUT_ID);
+		materials.nut = value(inputs, ARMATURE_JOINT_MASS_NUT_DENSITY_INPUT_ID);
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto root = design->rootComponent();
+		if (!root)
+			return;
+
+		auto unitsManager = design->unitsManager();
+		if (!unitsManager)
+			return;
+
+		auto ui = app->userInterface();
+		if (!ui)
+			return;
+
+		ArmatureMass armature;
+		for (auto& component : JointAttributes::joints(design)) {
+			JointSpec spec;
+			if (!JointAttributes::readSpec(component, spec))
+				continue;
+
+			auto local = MassProperties::fromLayout(Layout(spec), materials);
+
+			auto occurrences = root->allOccurrencesByComponent(component);
+			for (size_t i = 0; occurrences && i < occurrences->count(); i++) {
+				auto occurrence = occurrences->item(i);
+				if (!occurrence || !occurrence->transform2())
+					continue;
+
+				auto matrix = occurrence->transform2()->asArray();
+				if (matrix.size() != 16)
+					continue;
+
+				std::array<double, 16> placement;
+				std::copy(matrix.begin(), matrix.end(), placement.begin());
+
+				armature.add(local, Transform(placement));
+			}
+		}
+
+		if (armature.count() == 0) {
+			ui->messageBox("There are no armature joints in the design.", "Armature Mass Properties");
+			return;
+		}
+
+		auto total = armature.total();
+		auto centre = total.centre();
+		auto inertia = total.inertia();
+
+		ui->messageBox(
+			std::to_string(armature.count()) + " joints.\n" +
+			"Mass: " + number(total.mass) + " g\n" +
+			"Centre of mass: " + unitsManager->formatInternalValue(centre.x) + ", " + unitsManager->formatInternalValue(centre.y) + ", " + unitsManager->formatInternalValue(centre.z) + "\n" +
+			"Moments of inertia about the centre of mass (g cm^2):\n" +
+			"Ixx " + number(inertia[0]) + ", Iyy " + number(inertia[4]) + ", Izz " + number(inertia[8]) + "\n" +
+			"Ixy " + number(inertia[1]) + ", Ixz " + number(inertia[2]) + ", Iyz " + number(inertia[5]),
+			"Armature Mass Properties"
+		);
+	}
+}
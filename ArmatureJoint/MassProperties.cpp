@@ -0,0 +1,343 @@
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include "MassProperties.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	Section Section::circle(double cu, double cv, double radius) {
+		auto area = M_PI * radius * radius;
+		auto polar = M_PI * pow(radius, 4) / 4;
+
+		Section s = { area, cu * area, cv * area, (cu * cu * area) + polar, (cv * cv * area) + polar, cu * cv * area };
+		return s;
+	}
+
+	Section Section::polygon(const std::vector<std::pair<double, double>>& points) {
+		Section s = { 0, 0, 0, 0, 0, 0 };
+		for (size_t i = 0; i < points.size(); i++) {
+			auto& a = points[i];
+			auto& b = points[(i + 1) % points.size()];
+			auto cross = (a.first * b.second) - (b.first * a.second);
+
+			s.area += cross / 2;
+			s.u += (a.first + b.first) * cross / 6;
+			s.v += (a.second + b.second) * cross / 6;
+			s.uu += ((a.first * a.first) + (a.first * b.first) + (b.first * b.first)) * cross / 12;
+			s.vv += ((a.second * a.second) + (a.second * b.second) + (b.second * b.second)) * cross / 12;
+			s.uv += ((a.first * b.second) + (2 * a.first * a.second) + (2 * b.first * b.second) + (b.first * a.second)) * cross / 24;
+		}
+		return s;
+	}
+
+	Section Section::fillet(double cu, double cv, double su, double sv, double radius) {
+		// The square between the corner and the fillet's centre, less the quarter disc, with the corner at the origin.
+		auto r2 = radius * radius;
+		auto area = r2 * (1 - M_PI_4);
+		auto first = r2 * radius * ((5.0 / 6.0) - M_PI_4);
+		auto second = r2 * r2 * (1 - (5 * M_PI / 16));
+		auto product = r2 * r2 * ((19.0 / 24.0) - M_PI_4);
+
+		Section s = {
+			area,
+			(cu * area) + (su * first),
+			(cv * area) + (sv * first),
+			(cu * cu * area) + (2 * cu * su * first) + second,
+			(cv * cv * area) + (2 * cv * sv * first) + second,
+			(cu * cv * area) + (cu * sv * first) + (cv * su * first) + (su * sv * product)
+		};
+		return s;
+	}
+
+	Section Section::operator+(const Section& s) const {
+		Section r = { area + s.area, u + s.u, v + s.v, uu + s.uu, vv + s.vv, uv + s.uv };
+		return r;
+	}
+
+	Section Section::operator-(const Section& s) const {
+		Section r = { area - s.area, u - s.u, v - s.v, uu - s.uu, vv - s.vv, uv - s.uv };
+		return r;
+	}
+
+	MassProperties::MassProperties() : mass(0), first(), second() {
+	}
+
+	MassProperties& MassProperties::operator+=(const MassProperties& m) {
+		mass += m.mass;
+		first = first + m.first;
+		for (auto i = 0; i < 9; i++)
+			second[i] += m.second[i];
+		return *this;
+	}
+
+	MassProperties& MassProperties::operator-=(const MassProperties& m) {
+		return *this += m * -1;
+	}
+
+	MassProperties MassProperties::operator+(const MassProperties& m) const {
+		MassProperties sum = *this;
+		return sum += m;
+	}
+
+	MassProperties MassProperties::operator*(double density) const {
+		MassProperties m;
+		m.mass = mass * density;
+		m.first = first * density;
+		for (auto i = 0; i < 9; i++)
+			m.second[i] = second[i] * density;
+		return m;
+	}
+
+	MassProperties MassProperties::transformed(const Transform& placement) const {
+		// With p' = R p + t: S' = R S R^T + (R f) t^T + t (R f)^T + m t t^T, and f' = R f + m t.
+		MassProperties m;
+		m.mass = mass;
+
+		double r[9];
+		for (auto i = 0; i < 3; i++) {
+			for (auto j = 0; j < 3; j++)
+				r[(i * 3) + j] = placement.m[(i * 4) + j];
+		}
+
+		for (auto i = 0; i < 3; i++) {
+			for (auto j = 0; j < 3; j++) {
+				double sum = 0;
+				for (auto k = 0; k < 3; k++) {
+					for (auto l = 0; l < 3; l++)
+						sum += r[(i * 3) + k] * second[(k * 3) + l] * r[(j * 3) + l];
+				}
+				m.second[(i * 3) + j] = sum;
+			}
+		}
+
+		m.first = placement.vector(first);
+		return m.translated(Vector3(placement.m[3], placement.m[7], placement.m[11]));
+	}
+
+	MassProperties MassProperties::translated(const Vector3& offset) const {
+		MassProperties m = *this;
+		for (auto i = 0; i < 3; i++) {
+			for (auto j = 0; j < 3; j++)
+				m.second[(i * 3) + j] += (first[i] * offset[j]) + (offset[i] * first[j]) + (mass * offset[i] * offset[j]);
+		}
+		m.first = first + (offset * mass);
+		return m;
+	}
+
+	Vector3 MassProperties::centre() const {
+		if (mass == 0)
+			return Vector3();
+
+		return first * (1 / mass);
+	}
+
+	std::array<double, 9> MassProperties::inertia() const {
+		std::array<double, 9> central;
+		auto c = centre();
+		for (auto i = 0; i < 3; i++) {
+			for (auto j = 0; j < 3; j++)
+				central[(i * 3) + j] = second[(i * 3) + j] - (mass * c[i] * c[j]);
+		}
+
+		auto trace = central[0] + central[4] + central[8];
+
+		std::array<double, 9> inertia;
+		for (auto i = 0; i < 9; i++)
+			inertia[i] = (i % 4 == 0 ? trace : 0) - central[i];
+		return inertia;
+	}
+
+	MassProperties MassProperties::prism(const Section& section, int u, int v, int w, double w0, double w1) {
+		auto t = w1 - w0;
+		auto w2 = ((w1 * w1) - (w0 * w0)) / 2;
+		auto w3 = ((w1 * w1 * w1) - (w0 * w0 * w0)) / 3;
+
+		MassProperties m;
+		m.mass = section.area * t;
+
+		double first[3];
+		first[u] = section.u * t;
+		first[v] = section.v * t;
+		first[w] = section.area * w2;
+		m.first = Vector3(first[0], first[1], first[2]);
+
+		auto set = [&](int a, int b, double value) {
+			m.second[(a * 3) + b] = value;
+			m.second[(b * 3) + a] = value;
+		};
+		set(u, u, section.uu * t);
+		set(v, v, section.vv * t);
+		set(w, w, section.area * w3);
+		set(u, v, section.uv * t);
+		set(u, w, section.u * w2);
+		set(v, w, section.v * w2);
+		return m;
+	}
+
+	MassProperties MassProperties::frustum(double cu, double cv, int u, int v, int w, double w0, double r0, double w1, double r1) {
+		// Every slice is a disc; the integrands are polynomials of degree four or less in w, so three point
+		// Gauss-Legendre quadrature is exact.
+		const double nodes[] = { -sqrt(0.6), 0, sqrt(0.6) };
+		const double weights[] = { 5.0 / 9.0, 8.0 / 9.0, 5.0 / 9.0 };
+
+		MassProperties m;
+		auto half = (w1 - w0) / 2;
+		for (auto i = 0; i < 3; i++) {
+			auto at = w0 + (half * (nodes[i] + 1));
+			auto radius = r0 + ((r1 - r0) * (nodes[i] + 1) / 2);
+			auto slice = Section::circle(cu, cv, radius);
+			auto weight = weights[i] * half;
+
+			double first[3];
+			first[u] = slice.u;
+			first[v] = slice.v;
+			first[w] = slice.area * at;
+
+			double second[9];
+			auto set = [&](int a, int b, double value) {
+				second[(a * 3) + b] = value;
+				second[(b * 3) + a] = value;
+			};
+			set(u, u, slice.uu);
+			set(v, v, slice.vv);
+			set(w, w, slice.area * at * at);
+			set(u, v, slice.uv);
+			set(u, w, slice.u * at);
+			set(v, w, slice.v * at);
+
+			m.mass += slice.area * weight;
+			m.first = m.first + (Vector3(first[0], first[1], first[2]) * weight);
+			for (auto j = 0; j < 9; j++)
+				m.second[j] += second[j] * weight;
+		}
+		return m;
+	}
+
+	MassProperties MassProperties::drilledSphere(double radius, double holeRadius, const Vector3& direction) {
+		auto r2 = radius * radius;
+		auto r3 = r2 * radius;
+		auto r5 = r3 * r2;
+
+		MassProperties m;
+		m.mass = 4 * M_PI * r3 / 3;
+		for (auto i = 0; i < 3; i++)
+			m.second[i * 4] = 4 * M_PI * r5 / 15;
+
+		if (holeRadius <= 0)
+			return m;
+
+		// The plug from the centre along the axis to the surface, radius a: it runs to sqrt(r^2 - rho^2) at distance rho from the axis.
+		auto a = std::min(holeRadius, radius);
+		auto a2 = a * a;
+		auto s = sqrt(r2 - a2);
+		auto s3 = s * s * s;
+		auto s5 = s3 * s * s;
+
+		MassProperties plug;
+		plug.mass = 2 * M_PI * (r3 - s3) / 3;
+		plug.first = direction * (M_PI * ((r2 * a2 / 2) - (a2 * a2 / 4)));
+
+		auto axial = 2 * M_PI * (r5 - s5) / 15;
+		auto radial = M_PI * ((2.0 / 3.0 * r2 * (r3 - s3)) - (2.0 / 5.0 * (r5 - s5)));
+		for (auto i = 0; i < 3; i++) {
+			auto share = direction[i] * direction[i];
+			plug.second[i * 4] = (share * axial) + ((1 - share) * radial / 2);
+		}
+
+		m -= plug;
+		return m;
+	}
+
+	MassProperties MassProperties::fromLayout(const Layout& layout, const Materials& materials) {
+		// Component frame: x along the length, y up through the plates, z across the width.
+		const int x = 0, y = 1, z = 2;
+
+		auto length = layout.length();
+		auto width = layout.width();
+		auto thickness = layout.thickness();
+		auto c = layout.circleRadius();
+		auto chamfer = std::min(layout.chamferLength(), thickness);
+
+		// The plate outline, with the vertical corner edges filleted to the ball radius.
+		auto fillet = std::min(layout.ballRadius(), std::min(length, width) / 2);
+		auto outline = Section::polygon({ { 0, 0 }, { length, 0 }, { length, width }, { 0, width } })
+			- Section::fillet(0, 0, 1, 1, fillet)
+			- Section::fillet(length, 0, -1, 1, fillet)
+			- Section::fillet(length, width, -1, -1, fillet)
+			- Section::fillet(0, width, 1, -1, fillet)
+			- Section::circle(length / 2, width / 2, layout.boltHoleRadius());
+
+		std::vector<std::pair<double, double>> seats;
+		for (auto row = 1; row <= layout.rows(); row++) {
+			for (auto col = 1; col <= layout.cols(); col++) {
+				if (layout.jointType(row, col) == ARMATURE_JOINT_OPTION_BALL) {
+					seats.push_back(std::make_pair(layout.ballX(col), -layout.ballY(row)));
+					outline = outline - Section::circle(layout.ballX(col), -layout.ballY(row), c);
+				}
+			}
+		}
+
+		// Each plate is chamfered on the face towards the balls: the bottom plate on its top face, the top on its bottom.
+		auto bottom = thickness;
+		auto top = layout.ballZ() + layout.plateOffset();
+
+		MassProperties plates = prism(outline, x, z, y, 0, bottom) + prism(outline, x, z, y, top, top + thickness);
+		for (auto& seat : seats) {
+			plates -= frustum(seat.first, seat.second, x, z, y, bottom - chamfer, c, bottom, c + chamfer);
+			plates += prism(Section::circle(seat.first, seat.second, c), x, z, y, bottom - chamfer, bottom);
+			plates -= frustum(seat.first, seat.second, x, z, y, top, c + chamfer, top + chamfer, c);
+			plates += prism(Section::circle(seat.first, seat.second, c), x, z, y, top, top + chamfer);
+		}
+
+		MassProperties balls;
+		MassProperties nuts;
+		auto offset = layout.ballOffset();
+		auto opp = offset * tan(M_PI / 6);
+		for (auto row = 1; row <= layout.rows(); row++) {
+			for (auto col = 1; col <= layout.cols(); col++) {
+				auto type = layout.jointType(row, col);
+				auto centre = Vector3(layout.ballX(col), layout.ballZ(), -layout.ballY(row));
+
+				if (type == ARMATURE_JOINT_OPTION_BALL) {
+					balls += drilledSphere(layout.ballRadius(), layout.holeRadius(row, col), layout.ballHoleDirection(row, col)).translated(centre);
+				}
+				else if (type == ARMATURE_JOINT_OPTION_NUT) {
+					// The hex has flats facing the plates and is extruded half a ball radius either side of its column.
+					auto hex = Section::polygon({
+						{ centre.z - (2 * opp), centre.y },
+						{ centre.z - opp, centre.y - offset },
+						{ centre.z + opp, centre.y - offset },
+						{ centre.z + (2 * opp), centre.y },
+						{ centre.z + opp, centre.y + offset },
+						{ centre.z - opp, centre.y + offset }
+					}) - Section::circle(centre.z, centre.y, layout.boltHoleRadius());
+
+					nuts += prism(hex, z, y, x, centre.x - (layout.ballRadius() / 2), centre.x + (layout.ballRadius() / 2));
+				}
+			}
+		}
+
+		return (plates * materials.plate) + (balls * materials.ball) + (nuts * materials.nut);
+	}
+
+	int ArmatureMass::add(const MassProperties& properties, const Transform& placement) {
+		local.push_back(properties);
+		placed.push_back(properties.transformed(placement));
+		return (int)local.size() - 1;
+	}
+
+	void ArmatureMass::move(int joint, const Transform& placement) {
+		placed[joint] = local[joint].transformed(placement);
+	}
+
+	int ArmatureMass::count() const {
+		return (int)local.size();
+	}
+
+	MassProperties ArmatureMass::total() const {
+		MassProperties sum;
+		for (auto& joint : placed)
+			sum += joint;
+		return sum;
+	}
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Geometry.h"
+#include "Layout.h"
+
+namespace ArmatureJoint {
+	// Densities of each part, in grams per cubic centimetre.
+	struct Materials {
+		double plate;
+		double ball;
+		double nut;
+	};
+
+	// Area moments of a planar section about its plane's origin: area, first moments and second moments in (u, v).
+	struct Section {
+		double area;
+		double u;
+		double v;
+		double uu;
+		double vv;
+		double uv;
+
+		static Section circle(double cu, double cv, double radius);
+		static Section polygon(const std::vector<std::pair<double, double>>& points);
+
+		// The sliver a corner fillet of this radius removes, with its corner at (cu, cv) opening towards (su, sv).
+		static Section fillet(double cu, double cv, double su, double sv, double radius);
+
+		Section operator+(const Section& s) const;
+		Section operator-(const Section& s) const;
+	};
+
+	// Mass, first and second moments about the origin of one frame. Raw moments simply add, so solids are built by
+	// adding and subtracting closed form pieces, and whole armatures by adding placed joints.
+	class MassProperties {
+	public:
+		MassProperties();
+
+		double mass;
+		Vector3 first;
+		std::array<double, 9> second; // integral of p p^T dm, row major
+
+		MassProperties& operator+=(const MassProperties& m);
+		MassProperties& operator-=(const MassProperties& m);
+		MassProperties operator+(const MassProperties& m) const;
+		MassProperties operator*(double density) const;
+		MassProperties transformed(const Transform& placement) const;
+		MassProperties translated(const Vector3& offset) const;
+
+		Vector3 centre() const;
+
+		// Inertia tensor about the centre of mass, row major.
+		std::array<double, 9> inertia() const;
+
+		// A section in the plane of axes u and v, extruded along axis w from w0 to w1. Axes are 0, 1, 2 for x, y, z.
+		static MassProperties prism(const Section& section, int u, int v, int w, double w0, double w1);
+
+		// A cone frustum around the line (cu, cv) along axis w, radius r0 at w0 and r1 at w1.
+		static MassProperties frustum(double cu, double cv, int u, int v, int w, double w0, double r0, double w1, double r1);
+
+		// A sphere at the origin, less the screw hole drilled from its centre out along direction, a unit axis.
+		static MassProperties drilledSphere(double radius, double holeRadius, const Vector3& direction);
+
+		// The generated plates, balls and nuts in the joint's component frame.
+		static MassProperties fromLayout(const Layout& layout, const Materials& materials);
+	};
+
+	// A whole armature: each joint's properties are computed once in its own frame, so posing only re-places the
+	// joints that moved and re-adds the totals.
+	class ArmatureMass {
+	public:
+		int add(const MassProperties& local, const Transform& placement);
+		void move(int joint, const Transform& placement);
+		int count() const;
+		MassProperties total() const;
+
+	private:
+		std::vector<MassProperties> local;
+		std::vector<MassProperties> placed;
+	};
+}
@@ -0,0 +1,488 @@
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include <algorithm>
+
+#include "Mesh.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		struct Point2 {
+			double x;
+			double y;
+			int index;
+		};
+
+		typedef std::vector<Point2> Loop;
+
+		// Unit circle directions for n segments. Rings, fillets and hex flats index one shared table, so each body works
+		// out a direction's sine and cosine once rather than once per vertex.
+		void unitCircle(int n, std::vector<double>& cosines, std::vector<double>& sines) {
+			cosines.resize(n);
+			sines.resize(n);
+			auto step = 2 * M_PI / n;
+			for (auto i = 0; i < n; i++) {
+				cosines[i] = cos(step * i);
+				sines[i] = sin(step * i);
+			}
+		}
+
+		double cross(const Point2& a, const Point2& b, const Point2& c) {
+			return ((b.x - a.x) * (c.y - a.y)) - ((b.y - a.y) * (c.x - a.x));
+		}
+
+		double area(const Loop& loop) {
+			double sum = 0;
+			for (size_t i = 0; i < loop.size(); i++) {
+				auto& a = loop[i];
+				auto& b = loop[(i + 1) % loop.size()];
+				sum += (a.x * b.y) - (b.x * a.y);
+			}
+			return sum / 2;
+		}
+
+		bool same(const Point2& a, const Point2& b) {
+			return a.x == b.x && a.y == b.y;
+		}
+
+		bool inside(const Point2& p, const Point2& a, const Point2& b, const Point2& c) {
+			return cross(a, b, p) >= 0 && cross(b, c, p) >= 0 && cross(c, a, p) >= 0;
+		}
+
+		// Joins a hole into the outline with a bridge from its rightmost point to a visible outline vertex, so the
+		// result is one simple loop. Holes must be merged rightmost first.
+		void bridge(Loop& outline, const Loop& hole) {
+			size_t m = 0;
+			for (size_t i = 1; i < hole.size(); i++) {
+				if (hole[i].x > hole[m].x)
+					m = i;
+			}
+			auto& pm = hole[m];
+
+			// The nearest outline edge crossed by a ray from the hole towards +x.
+			auto nearest = HUGE_VAL;
+			size_t candidate = 0;
+			for (size_t i = 0; i < outline.size(); i++) {
+				auto& a = outline[i];
+				auto& b = outline[(i + 1) % outline.size()];
+				if ((a.y > pm.y) == (b.y > pm.y))
+					continue;
+
+				auto x = a.x + ((pm.y - a.y) * (b.x - a.x) / (b.y - a.y));
+				if (x < pm.x || x >= nearest)
+					continue;
+
+				nearest = x;
+				candidate = a.x > b.x ? i : (i + 1) % outline.size();
+			}
+
+			// A reflex vertex inside the triangle to that edge would block the bridge; take the one closest in angle.
+			Point2 hit = { nearest, pm.y, -1 };
+			auto& pc = outline[candidate];
+			auto best = candidate;
+			auto bestTangent = HUGE_VAL;
+			for (size_t i = 0; i < outline.size(); i++) {
+				auto& p = outline[i];
+				if (i == candidate || p.x < pm.x)
+					continue;
+
+				auto& prev = outline[(i + outline.size() - 1) % outline.size()];
+				auto& next = outline[(i + 1) % outline.size()];
+				if (cross(prev, p, next) > 0)
+					continue;
+
+				auto inTriangle = pc.y > pm.y ? inside(p, pm, hit, pc) : inside(p, pm, pc, hit);
+				if (!inTriangle)
+					continue;
+
+				auto tangent = fabs(p.y - pm.y) / std::max(p.x - pm.x, 1e-300);
+				if (tangent < bestTangent) {
+					best = i;
+					bestTangent = tangent;
+				}
+			}
+
+			// Earlier bridges duplicate vertices; join the copy whose corner the bridge actually leaves through.
+			auto opens = [&](size_t i) {
+				auto& p = outline[i];
+				auto& prev = outline[(i + outline.size() - 1) % outline.size()];
+				auto& next = outline[(i + 1) % outline.size()];
+				auto left = cross(p, next, pm) > 0;
+				auto right = cross(prev, p, pm) > 0;
+				return cross(prev, p, next) > 0 ? left && right : left || right;
+			};
+
+			if (!opens(best)) {
+				for (size_t i = 0; i < outline.size(); i++) {
+					if (i != best && same(outline[i], outline[best]) && opens(i)) {
+						best = i;
+						break;
+					}
+				}
+			}
+
+			Loop merged;
+			merged.reserve(outline.size() + hole.size() + 2);
+			merged.insert(merged.end(), outline.begin(), outline.begin() + best + 1);
+			for (size_t i = 0; i <= hole.size(); i++)
+				merged.push_back(hole[(m + i) % hole.size()]);
+			merged.push_back(outline[best]);
+			merged.insert(merged.end(), outline.begin() + best + 1, outline.end());
+			outline.swap(merged);
+		}
+
+		// Ear clipping of an outline with holes. Triangles come out counter-clockwise in (x, y).
+		void triangulate(Loop outline, std::vector<Loop> holes, std::vector<std::array<int, 3>>& triangles) {
+			if (area(outline) < 0)
+				std::reverse(outline.begin(), outline.end());
+
+			for (auto& hole : holes) {
+				if (area(hole) > 0)
+					std::reverse(hole.begin(), hole.end());
+			}
+
+			std::sort(holes.begin(), holes.end(), [](const Loop& a, const Loop& b) {
+				auto maxX = [](const Loop& loop) {
+					auto x = -HUGE_VAL;
+					for (auto& p : loop)
+						x = std::max(x, p.x);
+					return x;
+				};
+				return maxX(a) > maxX(b);
+			});
+
+			for (auto& hole : holes)
+				bridge(outline, hole);
+
+			auto n = outline.size();
+			std::vector<size_t> prev(n), next(n);
+			for (size_t i = 0; i < n; i++) {
+				prev[i] = (i + n - 1) % n;
+				next[i] = (i + 1) % n;
+			}
+
+			auto isEar = [&](size_t i) {
+				auto& a = outline[prev[i]];
+				auto& b = outline[i];
+				auto& c = outline[next[i]];
+				if (cross(a, b, c) <= 0)
+					return false;
+
+				for (auto j = next[next[i]]; j != prev[i]; j = next[j]) {
+					auto& p = outline[j];
+					if (same(p, a) || same(p, b) || same(p, c))
+						continue;
+
+					if (inside(p, a, b, c))
+						return false;
+				}
+				return true;
+			};
+
+			auto remaining = n;
+			auto i = (size_t)0;
+			auto misses = (size_t)0;
+			while (remaining > 3) {
+				// Rounding can leave no strict ear on a nearly degenerate loop; then clip anyway rather than stall.
+				if (isEar(i) || misses > remaining) {
+					std::array<int, 3> triangle = { { outline[prev[i]].index, outline[i].index, outline[next[i]].index } };
+					triangles.push_back(triangle);
+
+					next[prev[i]] = next[i];
+					prev[next[i]] = prev[i];
+					remaining--;
+					i = prev[i];
+					misses = 0;
+					continue;
+				}
+
+				i = next[i];
+				misses++;
+			}
+
+			std::array<int, 3> last = { { outline[prev[i]].index, outline[i].index, outline[next[i]].index } };
+			triangles.push_back(last);
+		}
+
+		// Quads between two rings of equal size.
+		void strip(Mesh& mesh, const std::vector<int>& a, const std::vector<int>& b) {
+			auto n = a.size();
+			for (size_t i = 0; i < n; i++) {
+				auto j = (i + 1) % n;
+				mesh.triangles.push_back({ { a[i], a[j], b[j] } });
+				mesh.triangles.push_back({ { a[i], b[j], b[i] } });
+			}
+		}
+
+		void fan(Mesh& mesh, int centre, const std::vector<int>& ring) {
+			auto n = ring.size();
+			for (size_t i = 0; i < n; i++)
+				mesh.triangles.push_back({ { centre, ring[i], ring[(i + 1) % n] } });
+		}
+
+		void flip(Mesh& mesh, size_t first) {
+			for (auto i = first; i < mesh.triangles.size(); i++)
+				std::swap(mesh.triangles[i][1], mesh.triangles[i][2]);
+		}
+
+		int add(Mesh& mesh, const Vector3& p) {
+			mesh.vertices.push_back(p);
+			return (int)mesh.vertices.size() - 1;
+		}
+	}
+
+	double Mesh::volume() const {
+		double sum = 0;
+		for (auto& t : triangles)
+			sum += vertices[t[0]].dot(vertices[t[1]].cross(vertices[t[2]]));
+		return sum / 6;
+	}
+
+	int Mesher::segments(double radius, double tolerance) {
+		if (radius <= 0 || tolerance <= 0 || tolerance >= radius)
+			return 8;
+
+		auto n = (int)ceil(M_PI / acos(1 - (tolerance / radius)));
+		return std::max(8, (n + 3) / 4 * 4);
+	}
+
+	std::vector<Mesh> Mesher::joint(const Layout& layout, double tolerance) {
+		std::vector<Mesh> meshes;
+		meshes.push_back(plate(layout, false, tolerance));
+		meshes.push_back(plate(layout, true, tolerance));
+
+		for (auto row = 1; row <= layout.rows(); row++) {
+			for (auto col = 1; col <= layout.cols(); col++) {
+				auto type = layout.jointType(row, col);
+				auto centre = Vector3(layout.ballX(col), layout.ballZ(), -layout.ballY(row));
+
+				if (type == ARMATURE_JOINT_OPTION_BALL)
+					meshes.push_back(ball(centre, layout.ballRadius(), layout.holeRadius(row, col), layout.ballHoleDirection(row, col), tolerance));
+				else if (type == ARMATURE_JOINT_OPTION_NUT && layout.boltHoleRadius() < layout.ballOffset())
+					meshes.push_back(nut(centre, layout.ballRadius(), 2 * layout.ballOffset(), layout.boltHoleRadius(), tolerance));
+			}
+		}
+
+		return meshes;
+	}
+
+	Mesh Mesher::plate(const Layout& layout, bool top, double tolerance) {
+		// Plate frame: the outline in (x, z), thickness along y, chamfered on the face towards the balls.
+		auto length = layout.length();
+		auto width = layout.width();
+		auto thickness = layout.thickness();
+		auto base = top ? layout.ballZ() + layout.plateOffset() : 0;
+		auto chamferFace = top ? base : base + thickness;
+		auto otherFace = top ? base + thickness : base;
+		auto chamfer = std::min(layout.chamferLength(), thickness);
+		auto c = layout.circleRadius();
+
+		Mesh mesh;
+		std::vector<double> cosines, sines;
+
+		// The outline: straight sides between quarter circle fillets at the corners, counter-clockwise in (x, z). Each
+		// fillet is a quarter of one circle table, starting the given number of quarter turns round from +x.
+		auto fillet = std::min(layout.ballRadius(), std::min(length, width) / 2);
+		auto quarter = std::max(2, segments(fillet, tolerance) / 4);
+		unitCircle(4 * quarter, cosines, sines);
+		std::vector<std::pair<double, double>> outline;
+		const double corners[4][2] = { { length - fillet, fillet }, { length - fillet, width - fillet }, { fillet, width - fillet }, { fillet, fillet } };
+		const int starts[4] = { 3, 0, 1, 2 };
+		for (auto corner = 0; corner < 4; corner++) {
+			for (auto i = 0; i <= quarter; i++) {
+				auto k = ((starts[corner] * quarter) + i) % (4 * quarter);
+				std::pair<double, double> p(corners[corner][0] + (fillet * cosines[k]), corners[corner][1] + (fillet * sines[k]));
+				if (!outline.empty() && fabs(outline.back().first - p.first) < 1e-12 && fabs(outline.back().second - p.second) < 1e-12)
+					continue;
+				outline.push_back(p);
+			}
+		}
+		if (fabs(outline.front().first - outline.back().first) < 1e-12 && fabs(outline.front().second - outline.back().second) < 1e-12)
+			outline.pop_back();
+
+		auto ring = [&](const std::vector<std::pair<double, double>>& points, double y) {
+			std::vector<int> indices;
+			for (auto& p : points)
+				indices.push_back(add(mesh, Vector3(p.first, y, p.second)));
+			return indices;
+		};
+
+		auto circle = [&](double cx, double cz, double radius) {
+			unitCircle(segments(radius, tolerance), cosines, sines);
+			std::vector<std::pair<double, double>> points;
+			for (size_t i = 0; i < cosines.size(); i++)
+				points.push_back(std::make_pair(cx + (radius * cosines[i]), cz + (radius * sines[i])));
+			return points;
+		};
+
+		auto loop = [&](const std::vector<int>& indices) {
+			Loop loop;
+			for (auto index : indices)
+				loop.push_back({ mesh.vertices[index].x, mesh.vertices[index].z, index });
+			return loop;
+		};
+
+		// Rings on the bottom face (y = base) and the top face, and the holes through both.
+		auto outlineBottom = ring(outline, base);
+		auto outlineTop = ring(outline, base + thickness);
+		strip(mesh, outlineTop, outlineBottom);
+
+		std::vector<Loop> bottomHoles;
+		std::vector<Loop> topHoles;
+
+		auto bolt = circle(length / 2, width / 2, layout.boltHoleRadius());
+		auto boltBottom = ring(bolt, base);
+		auto boltTop = ring(bolt, base + thickness);
+		strip(mesh, boltBottom, boltTop);
+		bottomHoles.push_back(loop(boltBottom));
+		topHoles.push_back(loop(boltTop));
+
+		for (auto row = 1; row <= layout.rows(); row++) {
+			for (auto col = 1; col <= layout.cols(); col++) {
+				if (layout.jointType(row, col) != ARMATURE_JOINT_OPTION_BALL)
+					continue;
+
+				// The seat is the bore, widened by the chamfer to c + chamfer at the chamfered face.
+				auto x = layout.ballX(col);
+				auto z = -layout.ballY(row);
+				unitCircle(segments(c + chamfer, tolerance), cosines, sines);
+
+				std::vector<std::pair<double, double>> bore, mouth;
+				for (size_t i = 0; i < cosines.size(); i++) {
+					bore.push_back(std::make_pair(x + (c * cosines[i]), z + (c * sines[i])));
+					mouth.push_back(std::make_pair(x + ((c + chamfer) * cosines[i]), z + ((c + chamfer) * sines[i])));
+				}
+
+				// Walls run from the bottom face ring up to the top face ring, through the chamfer's foot if it has one.
+				auto mouthRing = ring(mouth, chamferFace);
+				auto otherRing = ring(bore, otherFace);
+				auto low = top ? mouthRing : otherRing;
+				auto high = top ? otherRing : mouthRing;
+				if (chamfer < thickness) {
+					auto foot = ring(bore, top ? chamferFace + chamfer : chamferFace - chamfer);
+					strip(mesh, low, foot);
+					strip(mesh, foot, high);
+				}
+				else {
+					strip(mesh, low, high);
+				}
+
+				bottomHoles.push_back(loop(low));
+				topHoles.push_back(loop(high));
+			}
+		}
+
+		// Counter-clockwise in (x, z) faces -y, which is right for the bottom face.
+		triangulate(loop(outlineBottom), bottomHoles, mesh.triangles);
+		auto topFirst = mesh.triangles.size();
+		triangulate(loop(outlineTop), topHoles, mesh.triangles);
+		flip(mesh, topFirst);
+
+		return mesh;
+	}
+
+	Mesh Mesher::ball(const Vector3& centre, double radius, double holeRadius, const Vector3& direction, double tolerance) {
+		// Built around the hole axis, +x, then turned about y onto the hole's direction, which lies in the xz plane.
+		Mesh mesh;
+		std::vector<double> cosines, sines;
+		auto n = segments(radius, tolerance);
+		unitCircle(n, cosines, sines);
+
+		auto a = std::min(std::max(holeRadius, 0.0), radius * 0.999);
+		auto rim = asin(a / radius);
+		auto step = 2 * acos(std::max(1 - (tolerance / radius), -1.0));
+		auto latitudes = std::max(4, (int)ceil((M_PI - rim) / std::max(step, 1e-6)));
+
+		auto ring = [&](double x, double r) {
+			std::vector<int> indices;
+			for (auto i = 0; i < n; i++)
+				indices.push_back(add(mesh, Vector3(x, r * cosines[i], r * sines[i])));
+			return indices;
+		};
+
+		// Latitude rings from the hole's rim, or the pole when there is no hole, round to the far pole.
+		std::vector<int> first;
+		auto pole = -1;
+		if (a > 0)
+			first = ring(radius * cos(rim), a);
+		else
+			pole = add(mesh, Vector3(radius, 0, 0));
+
+		auto previous = first;
+		for (auto k = 1; k < latitudes; k++) {
+			auto theta = rim + ((M_PI - rim) * k / latitudes);
+			auto current = ring(radius * cos(theta), radius * sin(theta));
+			if (previous.empty())
+				fan(mesh, pole, current);
+			else {
+				strip(mesh, current, previous);
+			}
+			previous = current;
+		}
+
+		auto south = add(mesh, Vector3(-radius, 0, 0));
+		std::vector<int> reversed(previous.rbegin(), previous.rend());
+		fan(mesh, south, reversed);
+
+		if (a > 0) {
+			// The hole: a wall from the rim down to the centre, and a flat bottom through the centre.
+			auto bottom = ring(0, a);
+			strip(mesh, first, bottom);
+			fan(mesh, add(mesh, Vector3()), bottom);
+		}
+
+		for (auto& v : mesh.vertices)
+			v = Vector3((v.x * direction.x) - (v.z * direction.z), v.y, (v.x * direction.z) + (v.z * direction.x)) + centre;
+
+		return mesh;
+	}
+
+	Mesh Mesher::nut(const Vector3& centre, double length, double acrossFlats, double holeRadius, double tolerance) {
+		// A hex prism along x with its flats facing y, less the bolt hole. Both rings sample the same directions,
+		// with a multiple of six so the hex corners are included, and are joined by quads on each end face.
+		Mesh mesh;
+		std::vector<double> cosines, sines;
+		auto n = (std::max(segments(holeRadius, tolerance), 12) + 5) / 6 * 6;
+		unitCircle(n, cosines, sines);
+
+		auto apothem = acrossFlats / 2;
+		auto x0 = centre.x - (length / 2);
+		auto x1 = centre.x + (length / 2);
+
+		// The hex's radius in each direction: the apothem over the cosine to the middle of the flat it meets, by the
+		// difference formula on the table so only the six flat normals need trigonometry.
+		double normalCos[6], normalSin[6];
+		for (auto flat = 0; flat < 6; flat++) {
+			normalCos[flat] = cos((flat * M_PI / 3) + (M_PI / 6));
+			normalSin[flat] = sin((flat * M_PI / 3) + (M_PI / 6));
+		}
+
+		std::vector<double> hexRadius(n);
+		for (auto i = 0; i < n; i++) {
+			auto flat = i * 6 / n;
+			hexRadius[i] = apothem / ((cosines[i] * normalCos[flat]) + (sines[i] * normalSin[flat]));
+		}
+
+		auto ring = [&](double x, bool hex) {
+			std::vector<int> indices;
+			for (auto i = 0; i < n; i++) {
+				auto r = hex ? hexRadius[i] : holeRadius;
+				indices.push_back(add(mesh, Vector3(x, centre.y + (r * sines[i]), centre.z + (r * cosines[i]))));
+			}
+			return indices;
+		};
+
+		auto hexStart = ring(x0, true);
+		auto hexEnd = ring(x1, true);
+		auto holeStart = ring(x0, false);
+		auto holeEnd = ring(x1, false);
+
+		strip(mesh, hexEnd, hexStart);
+		strip(mesh, holeStart, holeEnd);
+		strip(mesh, hexStart, holeStart);
+		strip(mesh, holeEnd, hexEnd);
+
+		return mesh;
+	}
+}
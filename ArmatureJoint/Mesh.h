@@ -0,0 +1,31 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Geometry.h"
+#include "Layout.h"
+
+namespace ArmatureJoint {
+	// A closed, outward wound triangle mesh of one body, in centimetres.
+	struct Mesh {
+		std::vector<Vector3> vertices;
+		std::vector<std::array<int, 3>> triangles;
+
+		double volume() const;
+	};
+
+	// Tessellates the generated bodies straight from the layout, so no B-rep is needed. Curves are divided finely
+	// enough that no chord strays more than the tolerance from the true surface.
+	class Mesher {
+	public:
+		static int segments(double radius, double tolerance);
+
+		// Bottom plate, top plate, then the balls and nuts in row order, in the joint's component frame.
+		static std::vector<Mesh> joint(const Layout& layout, double tolerance);
+
+		static Mesh plate(const Layout& layout, bool top, double tolerance);
+		static Mesh ball(const Vector3& centre, double radius, double holeRadius, const Vector3& direction, double tolerance);
+		static Mesh nut(const Vector3& centre, double length, double acrossFlats, double holeRadius, double tolerance);
+	};
+}
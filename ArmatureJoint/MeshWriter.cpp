@@ -0,0 +1,347 @@
+#include "MeshWriter.h"
+
+#include <ctype.h>
+#include <string.h>
+
+#include "Parallel.h"
+
+namespace ArmatureJoint {
+	namespace {
+		const double millimetres = (1_cm).millimetres();
+
+		const char* contentTypes =
+			"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+			"<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+			"<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+			"<Default Extension=\"model\" ContentType=\"application/vnd.ms-package.3dmanufacturing-3dmodel+xml\"/>"
+			"</Types>\n";
+
+		const char* relationships =
+			"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+			"<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+			"<Relationship Target=\"/3D/3dmodel.model\" Id=\"rel0\" Type=\"http://schemas.microsoft.com/3dmanufacturing/2013/01/3dmodel\"/>"
+			"</Relationships>\n";
+
+		uint32_t crc32(uint32_t crc, const std::string& data) {
+			static const auto table = [] {
+				std::array<uint32_t, 256> table;
+				for (uint32_t i = 0; i < 256; i++) {
+					auto c = i;
+					for (auto k = 0; k < 8; k++)
+						c = c & 1 ? 0xedb88320u ^ (c >> 1) : c >> 1;
+					table[i] = c;
+				}
+				return table;
+			}();
+
+			crc = ~crc;
+			for (auto byte : data)
+				crc = table[(crc ^ (uint8_t)byte) & 0xff] ^ (crc >> 8);
+			return ~crc;
+		}
+
+		void put16(std::string& out, uint32_t value) {
+			out += (char)(value & 0xff);
+			out += (char)((value >> 8) & 0xff);
+		}
+
+		void put32(std::string& out, uint32_t value) {
+			put16(out, value & 0xffff);
+			put16(out, value >> 16);
+		}
+
+		void putFloat(std::string& out, double value) {
+			auto f = (float)value;
+			uint32_t bits;
+			memcpy(&bits, &f, sizeof(bits));
+			put32(out, bits);
+		}
+
+		Vector3 placed(const Transform& placement, const Vector3& p) {
+			return placement.point(p) * millimetres;
+		}
+
+		bool endsWith(const std::string& text, const std::string& suffix) {
+			if (text.size() < suffix.size())
+				return false;
+
+			for (size_t i = 0; i < suffix.size(); i++) {
+				if (tolower(text[text.size() - suffix.size() + i]) != suffix[i])
+					return false;
+			}
+			return true;
+		}
+	}
+
+	MeshWriter::MeshWriter() : triangleCount(0) {
+	}
+
+	MeshWriter::~MeshWriter() {
+	}
+
+	std::shared_ptr<MeshWriter> MeshWriter::create(const std::string& path) {
+		if (endsWith(path, ".3mf"))
+			return ThreeMfWriter::create(path);
+
+		if (endsWith(path, ".stl"))
+			return StlWriter::create(path);
+
+		return nullptr;
+	}
+
+	bool MeshWriter::write(const std::vector<Layout>& layouts, const std::vector<std::vector<Transform>>& placements, double tolerance, int workers) {
+		auto window = (size_t)Parallel::workers(workers) * 2;
+
+		for (size_t first = 0; first < layouts.size(); first += window) {
+			auto count = std::min(window, layouts.size() - first);
+
+			std::vector<std::vector<Mesh>> meshes(count);
+			Parallel::forEach(count, [&](size_t i, int) {
+				meshes[i] = Mesher::joint(layouts[first + i], tolerance);
+			}, workers);
+
+			for (size_t i = 0; i < count; i++) {
+				for (auto& placement : placements[first + i]) {
+					for (auto& mesh : meshes[i]) {
+						if (!add(mesh, placement))
+							return false;
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+
+	uint64_t MeshWriter::triangles() const {
+		return triangleCount;
+	}
+
+	std::shared_ptr<StlWriter> StlWriter::create(const std::string& path) {
+		auto writer = std::shared_ptr<StlWriter>(new StlWriter());
+
+		writer->file.open(path, std::ios::binary | std::ios::trunc);
+		if (!writer->file)
+			return nullptr;
+
+		// The triangle count follows the header and is filled in on close.
+		std::string header(80, ' ');
+		header.replace(0, 16, "Armature joints ");
+		put32(header, 0);
+		writer->file << header;
+
+		if (!writer->file)
+			return nullptr;
+
+		return writer;
+	}
+
+	bool StlWriter::add(const Mesh& mesh, const Transform& placement) {
+		std::string out;
+		out.reserve(mesh.triangles.size() * 50);
+
+		for (auto& triangle : mesh.triangles) {
+			auto a = placed(placement, mesh.vertices[triangle[0]]);
+			auto b = placed(placement, mesh.vertices[triangle[1]]);
+			auto c = placed(placement, mesh.vertices[triangle[2]]);
+
+			auto normal = (b - a).cross(c - a);
+			auto length = normal.length();
+			if (length > 0)
+				normal = normal * (1 / length);
+
+			for (auto& p : { normal, a, b, c }) {
+				putFloat(out, p.x);
+				putFloat(out, p.y);
+				putFloat(out, p.z);
+			}
+			put16(out, 0);
+		}
+
+		triangleCount += mesh.triangles.size();
+		file << out;
+		return (bool)file;
+	}
+
+	bool StlWriter::close() {
+		if (triangleCount > 0xffffffffull)
+			return false;
+
+		std::string count;
+		put32(count, (uint32_t)triangleCount);
+
+		file.seekp(80);
+		file << count;
+		file.close();
+		return !file.fail();
+	}
+
+	std::shared_ptr<ThreeMfWriter> ThreeMfWriter::create(const std::string& path) {
+		auto writer = std::shared_ptr<ThreeMfWriter>(new ThreeMfWriter());
+		writer->objects = 0;
+
+		writer->file.open(path, std::ios::binary | std::ios::trunc);
+		if (!writer->file)
+			return nullptr;
+
+		if (!writer->entry("[Content_Types].xml", contentTypes))
+			return nullptr;
+
+		if (!writer->entry("_rels/.rels", relationships))
+			return nullptr;
+
+		if (!writer->begin("3D/3dmodel.model"))
+			return nullptr;
+
+		if (!writer->stream(
+			"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+			"<model unit=\"millimeter\" xml:lang=\"en-US\" xmlns=\"http://schemas.microsoft.com/3dmanufacturing/core/2015/02\">\n"
+			"<resources>\n"
+		))
+			return nullptr;
+
+		return writer;
+	}
+
+	bool ThreeMfWriter::add(const Mesh& mesh, const Transform& placement) {
+		std::string out;
+		out.reserve(mesh.vertices.size() * 48 + mesh.triangles.size() * 40);
+
+		char line[128];
+		snprintf(line, sizeof(line), "<object id=\"%d\" type=\"model\"><mesh><vertices>\n", ++objects);
+		out += line;
+
+		for (auto& vertex : mesh.vertices) {
+			auto p = placed(placement, vertex);
+			snprintf(line, sizeof(line), "<vertex x=\"%.5f\" y=\"%.5f\" z=\"%.5f\"/>\n", p.x, p.y, p.z);
+			out += line;
+		}
+
+		out += "</vertices><triangles>\n";
+		for (auto& triangle : mesh.triangles) {
+			snprintf(line, sizeof(line), "<triangle v1=\"%d\" v2=\"%d\" v3=\"%d\"/>\n", triangle[0], triangle[1], triangle[2]);
+			out += line;
+		}
+		out += "</triangles></mesh></object>\n";
+
+		triangleCount += mesh.triangles.size();
+		return stream(out);
+	}
+
+	bool ThreeMfWriter::close() {
+		std::string build = "</resources>\n<build>\n";
+		for (auto id = 1; id <= objects; id++)
+			build += "<item objectid=\"" + std::to_string(id) + "\"/>\n";
+		build += "</build>\n</model>\n";
+
+		if (!stream(build) || !end())
+			return false;
+
+		// The central directory, then its end record.
+		auto directoryOffset = (uint32_t)file.tellp();
+		std::string directory;
+		for (auto& entry : entries) {
+			put32(directory, 0x02014b50);
+			put16(directory, 20);
+			put16(directory, 20);
+			put16(directory, entry.name == "3D/3dmodel.model" ? 0x0008 : 0);
+			put16(directory, 0);
+			put16(directory, 0);
+			put16(directory, 0x21);
+			put32(directory, entry.crc);
+			put32(directory, entry.size);
+			put32(directory, entry.size);
+			put16(directory, (uint32_t)entry.name.size());
+			put16(directory, 0);
+			put16(directory, 0);
+			put16(directory, 0);
+			put16(directory, 0);
+			put32(directory, 0);
+			put32(directory, entry.offset);
+			directory += entry.name;
+		}
+
+		auto directorySize = (uint32_t)directory.size();
+		put32(directory, 0x06054b50);
+		put16(directory, 0);
+		put16(directory, 0);
+		put16(directory, (uint32_t)entries.size());
+		put16(directory, (uint32_t)entries.size());
+		put32(directory, directorySize);
+		put32(directory, directoryOffset);
+		put16(directory, 0);
+
+		file << directory;
+		file.close();
+		return !file.fail();
+	}
+
+	bool ThreeMfWriter::entry(const std::string& name, const std::string& data) {
+		Entry entry = { name, crc32(0, data), (uint32_t)data.size(), (uint32_t)file.tellp() };
+
+		std::string header;
+		put32(header, 0x04034b50);
+		put16(header, 20);
+		put16(header, 0);
+		put16(header, 0);
+		put16(header, 0);
+		put16(header, 0x21);
+		put32(header, entry.crc);
+		put32(header, entry.size);
+		put32(header, entry.size);
+		put16(header, (uint32_t)name.size());
+		put16(header, 0);
+		header += name;
+
+		file << header << data;
+		entries.push_back(entry);
+		return (bool)file;
+	}
+
+	bool ThreeMfWriter::begin(const std::string& name) {
+		current.name = name;
+		current.crc = 0;
+		current.size = 0;
+		current.offset = (uint32_t)file.tellp();
+
+		// Bit 3: the CRC and sizes follow the data.
+		std::string header;
+		put32(header, 0x04034b50);
+		put16(header, 20);
+		put16(header, 0x0008);
+		put16(header, 0);
+		put16(header, 0);
+		put16(header, 0x21);
+		put32(header, 0);
+		put32(header, 0);
+		put32(header, 0);
+		put16(header, (uint32_t)name.size());
+		put16(header, 0);
+		header += name;
+
+		file << header;
+		return (bool)file;
+	}
+
+	bool ThreeMfWriter::stream(const std::string& data) {
+		if ((uint64_t)current.size + data.size() > 0xffffffffull)
+			return false;
+
+		current.crc = crc32(current.crc, data);
+		current.size += (uint32_t)data.size();
+		file << data;
+		return (bool)file;
+	}
+
+	bool ThreeMfWriter::end() {
+		std::string descriptor;
+		put32(descriptor, 0x08074b50);
+		put32(descriptor, current.crc);
+		put32(descriptor, current.size);
+		put32(descriptor, current.size);
+
+		file << descriptor;
+		entries.push_back(current);
+		return (bool)file;
+	}
+}
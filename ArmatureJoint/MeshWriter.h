@@ -0,0 +1,70 @@
+#pragma once
+
+#include <stdint.h>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "Mesh.h"
+
+namespace ArmatureJoint {
+	// Streams placed meshes to a file as they are added, so an armature is never held in memory as a whole.
+	// Files are written in millimetres.
+	class MeshWriter {
+	public:
+		virtual ~MeshWriter();
+
+		// A binary STL or a 3MF package, by the path's extension.
+		static std::shared_ptr<MeshWriter> create(const std::string& path);
+
+		virtual bool add(const Mesh& mesh, const Transform& placement) = 0;
+		virtual bool close() = 0;
+
+		// Tessellates each layout once, a few at a time across all cores, and writes every placement of it.
+		bool write(const std::vector<Layout>& layouts, const std::vector<std::vector<Transform>>& placements, double tolerance, int workers = 0);
+
+		uint64_t triangles() const;
+
+	protected:
+		MeshWriter();
+
+		std::ofstream file;
+		uint64_t triangleCount;
+	};
+
+	class StlWriter : public MeshWriter {
+	public:
+		static std::shared_ptr<StlWriter> create(const std::string& path);
+
+		bool add(const Mesh& mesh, const Transform& placement) override;
+		bool close() override;
+	};
+
+	// Each added mesh becomes its own object, so the parts stay separate for slicing. The package is a zip with stored
+	// entries; the model is written with a trailing data descriptor since its size and CRC are only known at the end.
+	class ThreeMfWriter : public MeshWriter {
+	public:
+		static std::shared_ptr<ThreeMfWriter> create(const std::string& path);
+
+		bool add(const Mesh& mesh, const Transform& placement) override;
+		bool close() override;
+
+	private:
+		struct Entry {
+			std::string name;
+			uint32_t crc;
+			uint32_t size;
+			uint32_t offset;
+		};
+
+		bool entry(const std::string& name, const std::string& data);
+		bool begin(const std::string& name);
+		bool stream(const std::string& data);
+		bool end();
+
+		std::vector<Entry> entries;
+		Entry current;
+		int objects;
+	};
+}
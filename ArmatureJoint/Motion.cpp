@@ -0,0 +1,184 @@
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include <algorithm>
+
+#include "Motion.h"
+#include "Parallel.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		// Directions an obstacle blocks, as angles from the shaft's rest axis towards +z.
+		struct Blocked {
+			double low;
+			double high;
+			CellMotion::Stop stop;
+		};
+
+		double wrap(double angle) {
+			return atan2(sin(angle), cos(angle));
+		}
+
+		// A disc seen from the origin, a along the rest axis and b across it. The shaft is only out of its ball from
+		// the rim of the hole on, so unless the disc's tangent point lies beyond that, the circle of the rim bounds
+		// it instead; a disc that does not reach the rim blocks nothing, and low is above high.
+		Blocked disc(double a, double b, double radius, double rim, CellMotion::Stop stop) {
+			auto distance = sqrt((a * a) + (b * b));
+			auto centre = atan2(b, a);
+			auto tangent = radius < distance ? sqrt((distance * distance) - (radius * radius)) : 0;
+			auto reach = ((rim * rim) + (distance * distance) - (radius * radius)) / std::max(2 * rim * distance, 1e-12);
+			auto half = tangent > rim ? asin(radius / distance) : (reach < 1 ? acos(std::max(reach, -1.0)) : -1);
+
+			Blocked blocked = { centre - half, centre + half, stop };
+			return blocked;
+		}
+
+		// A box seen from the origin spans the angles of its corners.
+		Blocked box(double a, double b, double halfA, double halfB, CellMotion::Stop stop) {
+			Blocked blocked = { -M_PI, M_PI, stop };
+			if (fabs(a) < halfA && fabs(b) < halfB)
+				return blocked;
+
+			auto centre = atan2(b, a);
+			blocked.low = HUGE_VAL;
+			blocked.high = -HUGE_VAL;
+			for (auto sa : { -1, 1 }) {
+				for (auto sb : { -1, 1 }) {
+					auto angle = centre + wrap(atan2(b + (sb * halfB), a + (sa * halfA)) - centre);
+					blocked.low = std::min(blocked.low, angle);
+					blocked.high = std::max(blocked.high, angle);
+				}
+			}
+			return blocked;
+		}
+
+		CellMotion cell(const Layout& layout, int row, int col) {
+			CellMotion motion = { row, col, M_PI_2, M_PI_2, M_PI_2, M_PI_2, CellMotion::Free };
+
+			auto r = layout.ballRadius();
+			auto shaft = layout.holeRadius(row, col);
+			auto rim = sqrt(std::max((r * r) - (shaft * shaft), 0.0));
+			auto gap = layout.plateOffset();
+			auto direction = layout.ballHoleDirection(row, col);
+			auto x = layout.ballX(col);
+			auto z = -layout.ballY(row);
+
+			// Obstacles are placed along the shaft and across it, in the plane of the gap.
+			auto along = [&](double px, double pz) { return ((px - x) * direction.x) + ((pz - z) * direction.z); };
+			auto across = [&](double px, double pz) { return ((px - x) * fabs(direction.z)) + ((pz - z) * fabs(direction.x)); };
+
+			// A shaft as thick as the gap between the plates cannot move at all.
+			if (shaft >= gap) {
+				motion.tilt = motion.swingPositive = motion.swingNegative = motion.cone = 0;
+				motion.stop = CellMotion::Plate;
+				return motion;
+			}
+
+			// Tilting, the shaft pivots over the plate end or side, or the mouth of the seat when that reaches past it.
+			auto end = direction.x != 0 ? (direction.x < 0 ? x : layout.length() - x) : (direction.z < 0 ? z : layout.width() - z);
+			auto mouth = layout.circleRadius() + std::min(layout.chamferLength(), layout.thickness());
+			auto edge = std::max(end, mouth);
+			auto tilt = atan2(gap, edge) - asin(shaft / sqrt((edge * edge) + (gap * gap)));
+			motion.tilt = std::min(std::max(tilt, 0.0), M_PI_2);
+
+			// Neighbours grow by the shaft's radius so the shaft itself can be a line.
+			std::vector<Blocked> obstacles;
+			auto nutHalfLength = r / 2;
+			auto nutHalfWidth = 2 * layout.ballOffset() * tan(M_PI / 6);
+			for (auto other = 1; other <= layout.rows(); other++) {
+				for (auto otherCol = 1; otherCol <= layout.cols(); otherCol++) {
+					if (other == row && otherCol == col)
+						continue;
+
+					auto type = layout.jointType(other, otherCol);
+					auto a = along(layout.ballX(otherCol), -layout.ballY(other));
+					auto b = across(layout.ballX(otherCol), -layout.ballY(other));
+
+					if (type == ARMATURE_JOINT_OPTION_BALL)
+						obstacles.push_back(disc(a, b, r + shaft, rim, CellMotion::Ball));
+					else if (type == ARMATURE_JOINT_OPTION_NUT) {
+						auto halfA = (fabs(direction.x) * nutHalfLength) + (fabs(direction.z) * nutHalfWidth);
+						auto halfB = (fabs(direction.x) * nutHalfWidth) + (fabs(direction.z) * nutHalfLength);
+						obstacles.push_back(box(a, b, halfA + shaft, halfB + shaft, CellMotion::Nut));
+					}
+				}
+			}
+			auto boltX = layout.length() / 2;
+			auto boltZ = layout.width() / 2;
+			obstacles.push_back(disc(along(boltX, boltZ), across(boltX, boltZ), layout.boltHoleRadius() + shaft, rim, CellMotion::Bolt));
+
+			auto positiveStop = CellMotion::Free;
+			auto negativeStop = CellMotion::Free;
+			for (auto& blocked : obstacles) {
+				if (blocked.low > blocked.high)
+					continue;
+
+				if (blocked.low <= 0 && blocked.high >= 0) {
+					motion.tilt = motion.swingPositive = motion.swingNegative = motion.cone = 0;
+					motion.stop = blocked.stop;
+					return motion;
+				}
+
+				if (blocked.low > 0 && blocked.low < motion.swingPositive) {
+					motion.swingPositive = blocked.low;
+					positiveStop = blocked.stop;
+				}
+				else if (blocked.high < 0 && -blocked.high < motion.swingNegative) {
+					motion.swingNegative = -blocked.high;
+					negativeStop = blocked.stop;
+				}
+			}
+
+			motion.cone = motion.tilt;
+			motion.stop = motion.tilt < M_PI_2 ? CellMotion::Plate : CellMotion::Free;
+			if (motion.swingPositive < motion.cone) {
+				motion.cone = motion.swingPositive;
+				motion.stop = positiveStop;
+			}
+			if (motion.swingNegative < motion.cone) {
+				motion.cone = motion.swingNegative;
+				motion.stop = negativeStop;
+			}
+
+			return motion;
+		}
+	}
+
+	std::vector<CellMotion> Motion::analyse(const Layout& layout) {
+		std::vector<CellMotion> cells;
+		for (auto row = 1; row <= layout.rows(); row++) {
+			for (auto col = 1; col <= layout.cols(); col++) {
+				if (layout.jointType(row, col) == ARMATURE_JOINT_OPTION_BALL)
+					cells.push_back(cell(layout, row, col));
+			}
+		}
+		return cells;
+	}
+
+	std::vector<std::vector<CellMotion>> Motion::analyse(const std::vector<JointSpec>& joints, int workers) {
+		std::vector<std::vector<CellMotion>> motions(joints.size());
+		Parallel::forEach(joints.size(), [&](size_t item, int) {
+			motions[item] = analyse(Layout(joints[item]));
+		}, workers);
+		return motions;
+	}
+
+	// Joints without balls have nothing to move, which is a full range rather than none.
+	double Motion::smallestCone(const std::vector<CellMotion>& cells) {
+		auto smallest = M_PI_2;
+		for (auto& cell : cells)
+			smallest = std::min(smallest, cell.cone);
+		return smallest;
+	}
+
+	std::string Motion::stopName(CellMotion::Stop stop) {
+		switch (stop) {
+		case CellMotion::Plate: return "the plate end";
+		case CellMotion::Ball: return "a neighbouring ball";
+		case CellMotion::Nut: return "a neighbouring nut";
+		case CellMotion::Bolt: return "the bolt";
+		default: return "nothing";
+		}
+	}
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Layout.h"
+
+namespace ArmatureJoint {
+	// How far one ball's shaft, the screw in its hole, can swing from its rest axis before it hits something. Tilt
+	// is towards either plate, where the plate end or side the shaft leaves by stops it; swing stays in the gap
+	// between the plates, towards +z or -z in the joint's frame for shafts along x and +x or -x for shafts along z,
+	// until a neighbouring ball or nut or the bolt is in the way. The cone is the
+	// smallest of them, the half angle the shaft is free to move through in every direction. Angles in radians, up
+	// to a right angle.
+	struct CellMotion {
+		enum Stop { Free, Plate, Ball, Nut, Bolt };
+
+		int row;
+		int col;
+		double tilt;
+		double swingPositive;
+		double swingNegative;
+		double cone;
+		Stop stop; // what limits the cone
+	};
+
+	// Range of motion worked out in closed form from the layout: the shaft is a cylinder from the ball's centre,
+	// the plate end a straight edge, and neighbours in the gap are discs or boxes seen from the ball's centre.
+	class Motion {
+	public:
+		static std::vector<CellMotion> analyse(const Layout& layout);
+		static std::vector<std::vector<CellMotion>> analyse(const std::vector<JointSpec>& joints, int workers = 0);
+
+		static double smallestCone(const std::vector<CellMotion>& cells);
+		static std::string stopName(CellMotion::Stop stop);
+	};
+}
@@ -0,0 +1,29 @@
+#include "MotionCommandCreated.h"
+
+#include "UI.h"
+
+namespace ArmatureJoint {
+	void MotionCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto inputs = cmd->commandInputs();
+		if (!inputs)
+			return;
+
+		auto minConeInput = inputs->addValueInput(ARMATURE_JOINT_MOTION_MIN_CONE_INPUT_ID, "Minimum Swing", "deg", ValueInput::createByString("30 deg"));
+		if (!minConeInput)
+			return;
+
+		minConeInput->tooltip("Balls whose shafts cannot swing this far in every direction are listed");
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
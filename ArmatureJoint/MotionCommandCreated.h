@@ -0,0 +1,19 @@
+#pragma once
+
+#include "MotionCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class MotionCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<MotionCommandExecuted> _onExecute;
+
+	public:
+		MotionCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<MotionCommandExecuted>(new MotionCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
@@ -0,0 +1,82 @@
+#include "MotionCommandExecuted.h"
+
+#include "JointAttributes.h"
+#include "Motion.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		std::string degrees(double radians) {
+			char text[32];
+			snprintf(text, sizeof(text), "%.1f deg", Angle::fromRadians(radians).degrees());
+			return text;
+		}
+	}
+
+	void MotionCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto command = eventArgs->command();
+		if (!command)
+			return;
+
+		auto inputs = command->commandInputs();
+		if (!inputs)
+			return;
+
+		auto minConeInput = static_cast<Ptr<ValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_MOTION_MIN_CONE_INPUT_ID));
+		if (!minConeInput)
+			return;
+
+		auto minCone = minConeInput->value();
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto ui = app->userInterface();
+		if (!ui)
+			return;
+
+		vector<JointSpec> specs;
+		for (auto& component : JointAttributes::joints(design)) {
+			JointSpec spec;
+			if (JointAttributes::readSpec(component, spec))
+				specs.push_back(spec);
+		}
+
+		if (specs.empty()) {
+			ui->messageBox("There are no armature joints in the design.", "Check Range of Motion");
+			return;
+		}
+
+		auto motions = Motion::analyse(specs);
+
+		// Tilt, then swing towards +z and -z, so a cramped ball shows which way it needs room.
+		std::string limited;
+		auto count = 0;
+		for (size_t i = 0; i < specs.size(); i++) {
+			for (auto& cell : motions[i]) {
+				if (cell.cone >= minCone)
+					continue;
+
+				count++;
+				limited += "\n" + specs[i].name + ", row " + std::to_string(cell.row) + ", column " + std::to_string(cell.col) + ": " +
+					degrees(cell.cone) + ", stopped by " + Motion::stopName(cell.stop) + " (tilt " + degrees(cell.tilt) + ", swing " +
+					degrees(cell.swingPositive) + " and " + degrees(cell.swingNegative) + ")";
+			}
+		}
+
+		if (count == 0) {
+			ui->messageBox("Every ball in the " + std::to_string(specs.size()) + " joints can swing at least " + degrees(minCone) + " in every direction.", "Check Range of Motion");
+			return;
+		}
+
+		ui->messageBox(std::to_string(count) + " balls cannot swing " + degrees(minCone) + " in every direction:\n" + limited, "Check Range of Motion");
+	}
+}
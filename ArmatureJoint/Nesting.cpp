@@ -0,0 +1,234 @@
+#include "Nesting.h"
+
+#include <algorithm>
+#include <deque>
+#include <math.h>
+
+#include "Parallel.h"
+
+namespace ArmatureJoint {
+	namespace {
+		// Below this many skyline segments across the open sheets, handing candidates to threads costs more than it saves.
+		const size_t parallelSegments = 2048;
+
+		struct Segment {
+			double x;
+			double y;
+			double width;
+		};
+
+		struct Candidate {
+			bool found;
+			double x;
+			double y;
+			double top;
+		};
+
+		bool better(const Candidate& a, const Candidate& b) {
+			if (!b.found)
+				return a.found;
+			if (!a.found)
+				return false;
+			if (a.top != b.top)
+				return a.top < b.top;
+			return a.x < b.x;
+		}
+
+		class Sheet {
+		public:
+			Sheet(double width, double height, double epsilon) : width(width), height(height), epsilon(epsilon) {
+				skyline.push_back({ 0, 0, width });
+			}
+
+			size_t segments() const {
+				return skyline.size();
+			}
+
+			// Lowest, then leftmost, spot for a w by h rectangle with its left edge on a segment. The rectangle rests on
+			// the highest segment under it, found with a monotonic queue as the window slides right.
+			Candidate fit(double w, double h) const {
+				Candidate best = { false, 0, 0, 0 };
+				if (failed(w, h))
+					return best;
+
+				std::deque<size_t> highest;
+				size_t end = 0;
+				for (size_t i = 0; i < skyline.size(); i++) {
+					auto x = skyline[i].x;
+					if (x + w > width + epsilon)
+						break;
+
+					for (; end < skyline.size() && skyline[end].x < x + w - epsilon; end++) {
+						while (!highest.empty() && skyline[highest.back()].y <= skyline[end].y)
+							highest.pop_back();
+						highest.push_back(end);
+					}
+					while (highest.front() < i)
+						highest.pop_front();
+
+					Candidate candidate = { true, x, skyline[highest.front()].y, skyline[highest.front()].y + h };
+					if (candidate.top <= height + epsilon && better(candidate, best))
+						best = candidate;
+				}
+
+				return best;
+			}
+
+			void place(double x, double y, double w, double h) {
+				std::vector<Segment> next;
+				next.reserve(skyline.size() + 2);
+
+				for (auto& segment : skyline) {
+					auto right = segment.x + segment.width;
+					if (right <= x + epsilon || segment.x >= x + w - epsilon) {
+						next.push_back(segment);
+						continue;
+					}
+					if (segment.x < x - epsilon)
+						next.push_back({ segment.x, segment.y, x - segment.x });
+					if (next.empty() || next.back().x + next.back().width < x + epsilon)
+						next.push_back({ x, y + h, w });
+					if (right > x + w + epsilon)
+						next.push_back({ x + w, segment.y, right - (x + w) });
+				}
+
+				// Neighbours at the same height are one segment.
+				skyline.clear();
+				for (auto& segment : next) {
+					if (!skyline.empty() && fabs(skyline.back().y - segment.y) <= epsilon)
+						skyline.back().width = segment.x + segment.width - skyline.back().x;
+					else
+						skyline.push_back(segment);
+				}
+			}
+
+			// Sheets only fill up, so a part at least as large as one that did not fit will not fit either.
+			bool failed(double w, double h) const {
+				for (auto& size : failures) {
+					if (w >= size.first - epsilon && h >= size.second - epsilon)
+						return true;
+				}
+				return false;
+			}
+
+			void fail(double w, double h) {
+				if (failed(w, h))
+					return;
+
+				failures.erase(std::remove_if(failures.begin(), failures.end(), [&](const std::pair<double, double>& size) {
+					return size.first >= w - epsilon && size.second >= h - epsilon;
+				}), failures.end());
+				failures.push_back(std::make_pair(w, h));
+			}
+
+		private:
+			double width;
+			double height;
+			double epsilon;
+			std::vector<Segment> skyline;
+			std::vector<std::pair<double, double>> failures;
+		};
+	}
+
+	NestResult Nesting::pack(const std::vector<NestPart>& parts, double sheetWidth, double sheetHeight, double kerf, bool rotate, int workers) {
+		NestResult result;
+		result.placements.assign(parts.size(), { -1, 0, 0, false });
+		result.sheets = 0;
+		result.unplaced = 0;
+		result.yield = 0;
+
+		// Each part carries a kerf on its right and top, and the sheet one more so the last part may use its edge.
+		auto width = sheetWidth + kerf;
+		auto height = sheetHeight + kerf;
+		auto epsilon = 1e-9 * std::max(width, height);
+
+		std::vector<size_t> order(parts.size());
+		for (size_t i = 0; i < order.size(); i++)
+			order[i] = i;
+		std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+			auto longA = std::max(parts[a].width, parts[a].height);
+			auto longB = std::max(parts[b].width, parts[b].height);
+			if (longA != longB)
+				return longA > longB;
+			return parts[a].width * parts[a].height > parts[b].width * parts[b].height;
+		});
+
+		std::vector<Sheet> sheets;
+		double partArea = 0;
+
+		for (auto index : order) {
+			auto& part = parts[index];
+			double sizes[2][2] = { { part.width + kerf, part.height + kerf }, { part.height + kerf, part.width + kerf } };
+			auto orientations = rotate ? 2 : 1;
+
+			// One candidate per open sheet and orientation. The first sheet with room wins, so earlier sheets fill up first.
+			size_t segments = 0;
+			for (auto& sheet : sheets)
+				segments += sheet.segments();
+
+			std::vector<Candidate> candidates(sheets.size() * orientations, { false, 0, 0, 0 });
+			auto fit = [&](size_t item, int) {
+				auto orientation = item % orientations;
+				candidates[item] = sheets[item / orientations].fit(sizes[orientation][0], sizes[orientation][1]);
+			};
+
+			if (segments * orientations < parallelSegments) {
+				for (size_t item = 0; item < candidates.size(); item++)
+					fit(item, 0);
+			}
+			else {
+				Parallel::forEach(candidates.size(), fit, workers);
+			}
+
+			auto chosen = candidates.size();
+			for (size_t item = 0; item < candidates.size(); item++) {
+				if (!candidates[item].found) {
+					sheets[item / orientations].fail(sizes[item % orientations][0], sizes[item % orientations][1]);
+					continue;
+				}
+
+				auto sameSheet = chosen == candidates.size() || item / orientations == chosen / orientations;
+				if (sameSheet && (chosen == candidates.size() || better(candidates[item], candidates[chosen])))
+					chosen = item;
+			}
+
+			Candidate candidate = { false, 0, 0, 0 };
+			auto orientation = 0;
+			auto sheet = 0;
+			if (chosen != candidates.size()) {
+				candidate = candidates[chosen];
+				orientation = (int)(chosen % orientations);
+				sheet = (int)(chosen / orientations);
+			}
+			else {
+				Sheet empty(width, height, epsilon);
+				for (auto turn = 0; turn < orientations; turn++) {
+					auto fresh = empty.fit(sizes[turn][0], sizes[turn][1]);
+					if (better(fresh, candidate)) {
+						candidate = fresh;
+						orientation = turn;
+					}
+				}
+
+				if (!candidate.found) {
+					result.unplaced++;
+					continue;
+				}
+
+				sheet = (int)sheets.size();
+				sheets.push_back(empty);
+			}
+
+			sheets[sheet].place(candidate.x, candidate.y, sizes[orientation][0], sizes[orientation][1]);
+
+			result.placements[index] = { sheet, candidate.x, candidate.y, orientation == 1 };
+			partArea += part.width * part.height;
+		}
+
+		result.sheets = (int)sheets.size();
+		if (result.sheets > 0)
+			result.yield = partArea / (result.sheets * sheetWidth * sheetHeight);
+
+		return result;
+	}
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <vector>
+
+namespace ArmatureJoint {
+	// A rectangle to nest, such as a plate's space from PlateDxf::width and PlateDxf::height.
+	struct NestPart {
+		double width;
+		double height;
+	};
+
+	// Where a part went: the bottom left of its space on a sheet, turned a quarter anticlockwise when rotated.
+	// Parts larger than an empty sheet are left on sheet -1.
+	struct NestPlacement {
+		int sheet;
+		double x;
+		double y;
+		bool rotated;
+	};
+
+	struct NestResult {
+		std::vector<NestPlacement> placements; // in the order the parts were given
+		int sheets;
+		int unplaced;
+		double yield; // part area over the area of the sheets used
+	};
+
+	// Packs rectangles onto as few stock sheets as it can: largest parts first, each at the lowest, then leftmost,
+	// position on the first sheet it fits on. Every sheet keeps a skyline of the tops of the parts below it, so a
+	// candidate position costs one sliding window over the skyline rather than a test against every placed part.
+	class Nesting {
+	public:
+		static NestResult pack(const std::vector<NestPart>& parts, double sheetWidth, double sheetHeight, double kerf, bool rotate, int workers = 0);
+	};
+}
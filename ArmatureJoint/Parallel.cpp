@@ -0,0 +1,83 @@
+#include "Parallel.h"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ArmatureJoint {
+	int Parallel::workers(int requested) {
+		if (requested > 0)
+			return requested;
+
+		return std::max(1, (int)std::thread::hardware_concurrency());
+	}
+
+	void Parallel::forEach(size_t count, const std::function<void(size_t item, int worker)>& body, int requested) {
+		auto threads = (int)std::min((size_t)workers(requested), std::max((size_t)1, count));
+
+		struct Run {
+			std::mutex lock;
+			size_t begin;
+			size_t end;
+		};
+
+		std::unique_ptr<Run[]> runs(new Run[threads]);
+		for (auto worker = 0; worker < threads; worker++) {
+			runs[worker].begin = (count * worker) / threads;
+			runs[worker].end = (count * (worker + 1)) / threads;
+		}
+
+		auto take = [&](int worker, size_t& item) {
+			std::lock_guard<std::mutex> guard(runs[worker].lock);
+			if (runs[worker].begin == runs[worker].end)
+				return false;
+
+			item = runs[worker].begin++;
+			return true;
+		};
+
+		// An idle worker takes the back half of the first run it finds unfinished. A pass can miss items another thief is
+		// moving, but that thief goes on to work through them, so a worker that finds nothing leaves without losing any.
+		auto steal = [&](int worker) {
+			for (auto i = 1; i < threads; i++) {
+				auto& victim = runs[(worker + i) % threads];
+
+				size_t begin, end;
+				{
+					std::lock_guard<std::mutex> guard(victim.lock);
+					if (victim.begin == victim.end)
+						continue;
+
+					begin = victim.end - ((victim.end - victim.begin + 1) / 2);
+					end = victim.end;
+					victim.end = begin;
+				}
+
+				std::lock_guard<std::mutex> guard(runs[worker].lock);
+				runs[worker].begin = begin;
+				runs[worker].end = end;
+				return true;
+			}
+			return false;
+		};
+
+		auto run = [&](int worker) {
+			size_t item;
+			do {
+				while (take(worker, item))
+					body(item, worker);
+			} while (steal(worker));
+		};
+
+		std::vector<std::thread> pool;
+		for (auto worker = 1; worker < threads; worker++)
+			pool.push_back(std::thread(run, worker));
+
+		run(0);
+
+		for (auto& thread : pool)
+			thread.join();
+	}
+}
@@ -0,0 +1,15 @@
+#pragma once
+
+#include <stddef.h>
+#include <functional>
+
+namespace ArmatureJoint {
+	// Runs independent work items on all cores. Each worker starts on its own run of consecutive items and, when that
+	// runs out, steals the back half of another worker's run, so uneven items still balance without every item going
+	// through one shared counter. Each call gets the index of the worker running it for per-worker accumulators.
+	class Parallel {
+	public:
+		static int workers(int requested = 0);
+		static void forEach(size_t count, const std::function<void(size_t item, int worker)>& body, int requested = 0);
+	};
+}
@@ -0,0 +1,157 @@
+#include "PlateDxf.h"
+
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		const double millimetres = (1_cm).millimetres();
+		const double labelHeight = 2;
+		const double labelGap = 1;
+
+		// R12 has no drawing units variable, so the millimetres are only a convention the cutter has to be told about.
+		const char* header =
+			"0\nSECTION\n2\nHEADER\n9\n$ACADVER\n1\nAC1009\n0\nENDSEC\n"
+			"0\nSECTION\n2\nTABLES\n"
+			"0\nTABLE\n2\nLTYPE\n70\n1\n0\nLTYPE\n2\nCONTINUOUS\n70\n0\n3\nSolid line\n72\n65\n73\n0\n40\n0.0\n0\nENDTAB\n"
+			"0\nTABLE\n2\nLAYER\n70\n4\n"
+			"0\nLAYER\n2\nCUT\n70\n0\n62\n7\n6\nCONTINUOUS\n"
+			"0\nLAYER\n2\nCHAMFER\n70\n0\n62\n1\n6\nCONTINUOUS\n"
+			"0\nLAYER\n2\nMARK\n70\n0\n62\n3\n6\nCONTINUOUS\n"
+			"0\nLAYER\n2\nSHEET\n70\n0\n62\n8\n6\nCONTINUOUS\n"
+			"0\nENDTAB\n0\nENDSEC\n"
+			"0\nSECTION\n2\nENTITIES\n";
+
+		const char* footer = "0\nENDSEC\n0\nEOF\n";
+	}
+
+	std::shared_ptr<PlateDxf> PlateDxf::create(const std::string& path) {
+		auto dxf = std::shared_ptr<PlateDxf>(new PlateDxf());
+
+		dxf->file.open(path, std::ios::binary | std::ios::trunc);
+		if (!dxf->file)
+			return nullptr;
+
+		dxf->file << header;
+		if (!dxf->file)
+			return nullptr;
+
+		return dxf;
+	}
+
+	double PlateDxf::width(const Layout& layout) {
+		return layout.length() * millimetres;
+	}
+
+	double PlateDxf::height(const Layout& layout) {
+		return (layout.width() * millimetres) + labelGap + labelHeight;
+	}
+
+	bool PlateDxf::add(const Layout& layout, bool top, double x, double y, bool rotated) {
+		auto length = layout.length() * millimetres;
+		auto width = layout.width() * millimetres;
+		auto fillet = std::min(layout.ballRadius() * millimetres, std::min(length, width) / 2);
+
+		// Positions (u, v) within the plate's space, with the plate above its label, turned onto the sheet.
+		auto spaceHeight = height(layout);
+		auto turn = rotated ? 90.0 : 0.0;
+		auto at = [&](double u, double v, double& px, double& py) {
+			px = rotated ? x + spaceHeight - v : x + u;
+			py = rotated ? y + u : y + v;
+		};
+
+		auto bottom = labelHeight + labelGap;
+		auto topEdge = bottom + width;
+		const double corners[4][2] = { { 0, bottom }, { length, bottom }, { length, topEdge }, { 0, topEdge } };
+		const double centres[4][2] = { { length - fillet, bottom + fillet }, { length - fillet, topEdge - fillet }, { fillet, topEdge - fillet }, { fillet, bottom + fillet } };
+
+		// Sides run corner to corner, less the fillets, then a quarter arc turns each corner.
+		for (auto side = 0; side < 4; side++) {
+			auto& from = corners[side];
+			auto& to = corners[(side + 1) % 4];
+			auto dx = (to[0] - from[0]) == 0 ? 0 : ((to[0] - from[0]) > 0 ? fillet : -fillet);
+			auto dy = (to[1] - from[1]) == 0 ? 0 : ((to[1] - from[1]) > 0 ? fillet : -fillet);
+
+			double x0, y0, x1, y1;
+			at(from[0] + dx, from[1] + dy, x0, y0);
+			at(to[0] - dx, to[1] - dy, x1, y1);
+			line("CUT", x0, y0, x1, y1);
+
+			if (fillet > 0) {
+				double cx, cy;
+				at(centres[side][0], centres[side][1], cx, cy);
+				auto start = fmod((side * 90.0) + 270 + turn, 360.0);
+				arc(cx, cy, fillet, start, start + 90);
+			}
+		}
+
+		auto place = [&](double sketchX, double sketchY, double& px, double& py) {
+			auto along = sketchX * millimetres;
+			at(top ? length - along : along, topEdge + (sketchY * millimetres), px, py);
+		};
+
+		double px, py;
+		place(layout.length() / 2, -layout.width() / 2, px, py);
+		circle("CUT", px, py, layout.boltHoleRadius() * millimetres);
+
+		auto seat = layout.circleRadius() * millimetres;
+		auto mouth = (layout.circleRadius() + std::min(layout.chamferLength(), layout.thickness())) * millimetres;
+		for (auto row = 1; row <= layout.rows(); row++) {
+			for (auto col = 1; col <= layout.cols(); col++) {
+				if (layout.jointType(row, col) != ARMATURE_JOINT_OPTION_BALL)
+					continue;
+
+				place(layout.ballX(col), layout.ballY(row), px, py);
+				circle("CUT", px, py, seat);
+				circle("CHAMFER", px, py, mouth);
+			}
+		}
+
+		at(0, 0, px, py);
+		text(px, py, labelHeight, turn, layout.name() + (top ? " top" : " bottom") + ", chamfer side up");
+
+		return (bool)file;
+	}
+
+	bool PlateDxf::sheet(double x, double y, double width, double height) {
+		line("SHEET", x, y, x + width, y);
+		line("SHEET", x + width, y, x + width, y + height);
+		line("SHEET", x + width, y + height, x, y + height);
+		line("SHEET", x, y + height, x, y);
+
+		return (bool)file;
+	}
+
+	bool PlateDxf::close() {
+		file << footer;
+		file.close();
+		return !file.fail();
+	}
+
+	void PlateDxf::line(const char* layer, double x0, double y0, double x1, double y1) {
+		char entity[160];
+		snprintf(entity, sizeof(entity), "0\nLINE\n8\n%s\n10\n%.4f\n20\n%.4f\n30\n0.0\n11\n%.4f\n21\n%.4f\n31\n0.0\n", layer, x0, y0, x1, y1);
+		file << entity;
+	}
+
+	void PlateDxf::arc(double x, double y, double radius, double start, double end) {
+		char entity[160];
+		snprintf(entity, sizeof(entity), "0\nARC\n8\nCUT\n10\n%.4f\n20\n%.4f\n30\n0.0\n40\n%.4f\n50\n%.1f\n51\n%.1f\n", x, y, radius, start, end);
+		file << entity;
+	}
+
+	void PlateDxf::circle(const char* layer, double x, double y, double radius) {
+		char entity[160];
+		snprintf(entity, sizeof(entity), "0\nCIRCLE\n8\n%s\n10\n%.4f\n20\n%.4f\n30\n0.0\n40\n%.4f\n", layer, x, y, radius);
+		file << entity;
+	}
+
+	void PlateDxf::text(double x, double y, double height, double angle, const std::string& value) {
+		char entity[112];
+		snprintf(entity, sizeof(entity), "0\nTEXT\n8\nMARK\n10\n%.4f\n20\n%.4f\n30\n0.0\n40\n%.4f\n50\n%.1f\n1\n", x, y, height, angle);
+		file << entity << value << "\n";
+	}
+}
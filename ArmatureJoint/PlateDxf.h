@@ -0,0 +1,35 @@
+#pragma once
+
+#include <fstream>
+#include <memory>
+#include <string>
+
+#include "Layout.h"
+
+namespace ArmatureJoint {
+	// Writes plate cutting profiles to an R12 DXF in millimetres as plates are added, straight from their layouts.
+	// CUT holds the through cuts JointPlate::plateSketch draws, CHAMFER the seat chamfers' outer edges, MARK the
+	// labels and SHEET the stock outlines. Every plate is drawn chamfer side up, so top plates are mirrored and both
+	// kinds read the same way.
+	class PlateDxf {
+	public:
+		static std::shared_ptr<PlateDxf> create(const std::string& path);
+
+		// The space a plate and its label take on the sheet, in millimetres.
+		static double width(const Layout& layout);
+		static double height(const Layout& layout);
+
+		// Adds a plate with the bottom left of its space at (x, y), turned a quarter anticlockwise when rotated.
+		bool add(const Layout& layout, bool top, double x, double y, bool rotated = false);
+		bool sheet(double x, double y, double width, double height);
+		bool close();
+
+	private:
+		std::ofstream file;
+
+		void line(const char* layer, double x0, double y0, double x1, double y1);
+		void arc(double x, double y, double radius, double start, double end);
+		void circle(const char* layer, double x, double y, double radius);
+		void text(double x, double y, double height, double angle, const std::string& value);
+	};
+}
@@ -0,0 +1,301 @@
+#include "PlateMachining.h"
+
+#include <math.h>
+#include <map>
+
+#include "JointAttributes.h"
+#include "Json.h"
+#include "Nesting.h"
+#include "Units.h"
+
+namespace ArmatureJoint {
+	namespace {
+		struct Plate {
+			size_t layout;
+			bool top;
+			Ptr<BRepBody> body;
+			std::string name;
+		};
+
+		// Parameters the running version of Fusion does not have are left alone.
+		bool setParameter(Ptr<adsk::cam::OperationBase> operation, const std::string& name, const std::string& expression) {
+			auto parameters = operation->parameters();
+			auto parameter = parameters ? parameters->itemByName(name) : nullptr;
+			return !parameter || parameter->expression(expression);
+		}
+
+		std::string centimetres(double value) {
+			return Json(value).dump() + " cm";
+		}
+	}
+
+	shared_ptr<PlateMachining> PlateMachining::create(Ptr<Design> design, Ptr<adsk::cam::CAM> cam) {
+		if (!design || !cam)
+			return nullptr;
+
+		auto machining = shared_ptr<PlateMachining>(new PlateMachining(design, cam));
+
+		machining->rootComponent = design->rootComponent();
+		if (!machining->rootComponent)
+			return nullptr;
+
+		return machining;
+	}
+
+	// Bottom plates already have their chamfers facing away from the sketch plane. Top plates are turned over
+	// about the length, which is a rotation rather than a mirror, so the copies stay solid.
+	std::array<double, 16> PlateMachining::flatten(const Layout& layout, bool top, double x, double y, bool rotated) {
+		auto width = layout.width();
+		auto topOffset = layout.ballZ() + layout.plateOffset();
+
+		const double bottomRows[3][4] = { { 1, 0, 0, 0 }, { 0, 0, -1, width }, { 0, 1, 0, 0 } };
+		const double topRows[3][4] = { { 1, 0, 0, 0 }, { 0, 0, 1, 0 }, { 0, -1, 0, topOffset + layout.thickness() } };
+		auto& flat = top ? topRows : bottomRows;
+
+		std::array<double, 16> matrix = { {
+			flat[0][0], flat[0][1], flat[0][2], flat[0][3] + x,
+			flat[1][0], flat[1][1], flat[1][2], flat[1][3] + y,
+			flat[2][0], flat[2][1], flat[2][2], flat[2][3],
+			0, 0, 0, 1,
+		} };
+
+		if (rotated) {
+			for (auto col = 0; col < 4; col++) {
+				matrix[col] = -flat[1][col];
+				matrix[4 + col] = flat[0][col];
+			}
+			matrix[3] += x + width;
+			matrix[7] += y;
+		}
+
+		return matrix;
+	}
+
+	bool PlateMachining::layOut(double _sheetWidth, double _sheetHeight, double spacing, bool rotate) {
+		sheetWidth = _sheetWidth;
+		sheetHeight = _sheetHeight;
+
+		// Every occurrence needs its own pair of plates.
+		vector<Layout> layouts;
+		vector<Plate> plates;
+		for (auto& component : JointAttributes::joints(design)) {
+			JointSpec spec;
+			if (!JointAttributes::readSpec(component, spec))
+				continue;
+
+			auto occurrences = rootComponent->allOccurrencesByComponent(component);
+			if (!occurrences || occurrences->count() == 0)
+				continue;
+
+			// A joint whose plate bodies have been deleted or replaced is left out rather than stopping the others.
+			auto roles = JointAttributes::roles(component);
+			Ptr<BRepBody> bodies[2];
+			for (auto top : { false, true }) {
+				auto found = roles.find(top ? "topPlate.body" : "bottomPlate.body");
+				if (found != roles.end())
+					bodies[top] = static_cast<Ptr<BRepBody>>(found->second);
+			}
+
+			if (!bodies[0] || !bodies[1]) {
+				_skipped.push_back(spec.name);
+				continue;
+			}
+
+			layouts.push_back(Layout(spec));
+			for (auto top : { false, true }) {
+				Plate plate = { layouts.size() - 1, top, bodies[top], spec.name + (top ? " Top" : " Bottom") };
+				for (size_t i = 0; i < occurrences->count(); i++)
+					plates.push_back(plate);
+			}
+		}
+
+		// Plates are grouped by thickness, as the stock is, and each group is nested on sheets of its own.
+		std::map<long long, vector<size_t>> groups;
+		for (size_t i = 0; i < plates.size(); i++)
+			groups[llround(layouts[plates[i].layout].thickness() * 1e4)].push_back(i);
+
+		auto manager = TemporaryBRepManager::get();
+		if (!manager)
+			return false;
+
+		for (auto& group : groups) {
+			vector<NestPart> parts;
+			for (auto i : group.second) {
+				auto& layout = layouts[plates[i].layout];
+				NestPart part = { layout.length(), layout.width() };
+				parts.push_back(part);
+			}
+
+			auto nest = Nesting::pack(parts, sheetWidth, sheetHeight, spacing, rotate);
+			_unplaced += nest.unplaced;
+
+			vector<vector<Ptr<BRepBody>>> bodies(nest.sheets);
+			vector<vector<std::string>> names(nest.sheets);
+			for (size_t k = 0; k < group.second.size(); k++) {
+				auto& placement = nest.placements[k];
+				if (placement.sheet < 0)
+					continue;
+
+				auto& plate = plates[group.second[k]];
+				auto flat = flatten(layouts[plate.layout], plate.top, placement.x, placement.y, placement.rotated);
+
+				auto matrix = Matrix3D::create();
+				if (!matrix || !matrix->setWithArray(std::vector<double>(flat.begin(), flat.end())))
+					return false;
+
+				auto copy = manager->copy(plate.body);
+				if (!copy || !manager->transform(copy, matrix))
+					return false;
+
+				bodies[placement.sheet].push_back(copy);
+				names[placement.sheet].push_back(plate.name);
+				_plates++;
+			}
+
+			char thickness[32];
+			snprintf(thickness, sizeof(thickness), "%g mm", Length::fromCentimetres(group.first / 1e4).millimetres());
+
+			for (auto sheet = 0; sheet < nest.sheets; sheet++) {
+				auto name = "Plate Sheet " + std::to_string(_sheets.size() + 1) + " (" + thickness + ")";
+				if (!addSheet(name, group.first / 1e4, _sheets.size() * sheetWidth * 1.1, bodies[sheet], names[sheet]))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Sheets sit side by side along x, a tenth of a sheet apart.
+	bool PlateMachining::addSheet(const std::string& name, double thickness, double x, const vector<Ptr<BRepBody>>& bodies, const vector<std::string>& names) {
+		auto matrix = Matrix3D::create();
+		if (!matrix || !matrix->setWithArray({ 1, 0, 0, x, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 }))
+			return false;
+
+		auto occurrences = rootComponent->occurrences();
+		auto occurrence = occurrences ? occurrences->addNewComponent(matrix) : nullptr;
+		if (!occurrence)
+			return false;
+
+		auto component = occurrence->component();
+		if (!component || !component->name(name))
+			return false;
+
+		auto target = component->bRepBodies();
+		if (!target)
+			return false;
+
+		// Parametric designs only take bodies inside a base feature.
+		Ptr<BaseFeature> base;
+		if (design->designType() == DesignTypes::ParametricDesignType) {
+			auto features = component->features();
+			auto baseFeatures = features ? features->baseFeatures() : nullptr;
+			base = baseFeatures ? baseFeatures->add() : nullptr;
+			if (!base || !base->startEdit())
+				return false;
+		}
+
+		vector<Ptr<BRepBody>> added;
+		for (size_t i = 0; i < bodies.size(); i++) {
+			auto body = target->add(bodies[i], base);
+			if (!body)
+				return false;
+
+			body->name(names[i]);
+			added.push_back(body);
+		}
+
+		if (base) {
+			if (!base->finishEdit())
+				return false;
+
+			auto baseBodies = base->bodies();
+			if (!baseBodies)
+				return false;
+
+			added.clear();
+			for (size_t i = 0; i < baseBodies->count(); i++)
+				added.push_back(baseBodies->item(i));
+		}
+
+		PlateSheet sheet;
+		sheet.occurrence = occurrence;
+		sheet.thickness = thickness;
+		for (auto& body : added) {
+			auto proxy = body ? body->createForAssemblyContext(occurrence) : nullptr;
+			if (!proxy)
+				return false;
+
+			sheet.bodies.push_back(proxy);
+		}
+
+		_sheets.push_back(sheet);
+		return true;
+	}
+
+	bool PlateMachining::addSetups(Ptr<adsk::cam::CAMTemplate> operations) {
+		auto all = cam->setups();
+		if (!all)
+			return false;
+
+		for (auto& sheet : _sheets) {
+			auto input = all->createInput(adsk::cam::OperationTypes::MillingOperation);
+			if (!input || !input->models(vector<Ptr<Base>>(sheet.bodies.begin(), sheet.bodies.end())))
+				return false;
+
+			auto setup = all->add(input);
+			if (!setup)
+				return false;
+
+			setup->name(sheet.occurrence->component()->name());
+
+			// The stock is the sheet: a fixed box as thick as its plates.
+			if (!setParameter(setup, "job_stockMode", "'fixedbox'") ||
+				!setParameter(setup, "job_stockFixedX", centimetres(sheetWidth)) ||
+				!setParameter(setup, "job_stockFixedY", centimetres(sheetHeight)) ||
+				!setParameter(setup, "job_stockFixedZ", centimetres(sheet.thickness)))
+				return false;
+
+			if (operations && setup->createFromCAMTemplate(operations).empty())
+				_withoutOperations++;
+
+			setups.push_back(setup);
+		}
+
+		return true;
+	}
+
+	// One request for every new setup, so Fusion generates them together in the background.
+	Ptr<adsk::cam::GenerateToolpathFuture> PlateMachining::generate() {
+		auto operations = ObjectCollection::create();
+		if (!operations)
+			return nullptr;
+
+		for (auto& setup : setups)
+			operations->add(setup);
+
+		if (operations->count() == 0)
+			return nullptr;
+
+		return cam->generateToolpath(operations);
+	}
+
+	const vector<PlateSheet>& PlateMachining::sheets() const {
+		return _sheets;
+	}
+
+	int PlateMachining::plates() const {
+		return _plates;
+	}
+
+	int PlateMachining::unplaced() const {
+		return _unplaced;
+	}
+
+	const vector<std::string>& PlateMachining::skipped() const {
+		return _skipped;
+	}
+
+	int PlateMachining::withoutOperations() const {
+		return _withoutOperations;
+	}
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+#include <CAM/CAMAll.h>
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "Layout.h"
+
+#define ARMATURE_JOINT_ATTRIBUTE_CAM_TEMPLATE "camTemplate"
+
+using namespace std;
+using namespace adsk::core;
+using namespace adsk::fusion;
+
+namespace ArmatureJoint {
+	// A stock sheet of plates laid flat for machining, in a component of its own.
+	struct PlateSheet {
+		Ptr<Occurrence> occurrence;
+		double thickness;
+		vector<Ptr<BRepBody>> bodies; // in the context of the occurrence
+	};
+
+	// Lays every generated plate flat, chamfer side up, on stock sheets packed by Nesting, then makes one milling
+	// setup per sheet from an operation template and generates all of their toolpaths as one job. Plates only share
+	// a sheet with plates of the same thickness. Sheets hold copies, so joints changed later need laying out again.
+	class PlateMachining {
+	public:
+		static shared_ptr<PlateMachining> create(Ptr<Design> design, Ptr<adsk::cam::CAM> cam);
+
+		bool layOut(double _sheetWidth, double _sheetHeight, double spacing, bool rotate);
+		bool addSetups(Ptr<adsk::cam::CAMTemplate> operations);
+		Ptr<adsk::cam::GenerateToolpathFuture> generate();
+
+		const vector<PlateSheet>& sheets() const;
+		int plates() const;
+		int unplaced() const;
+
+		// Joints left out because their plate bodies are missing, and setups the template added no operations to.
+		const vector<std::string>& skipped() const;
+		int withoutOperations() const;
+
+		// Where a plate goes from its joint component's space: flat on the sheet with its chamfers up, the bottom left
+		// of its space at (x, y) and turned a quarter anticlockwise when rotated. Row major, as Matrix3D::asArray.
+		static std::array<double, 16> flatten(const Layout& layout, bool top, double x, double y, bool rotated);
+
+	private:
+		Ptr<Design> design;
+		Ptr<Component> rootComponent;
+		Ptr<adsk::cam::CAM> cam;
+		vector<PlateSheet> _sheets;
+		vector<Ptr<adsk::cam::Setup>> setups;
+		double sheetWidth;
+		double sheetHeight;
+		int _plates;
+		int _unplaced;
+		vector<std::string> _skipped;
+		int _withoutOperations;
+
+		PlateMachining(Ptr<Design> _design, Ptr<adsk::cam::CAM> _cam) {
+			design = _design;
+			cam = _cam;
+			sheetWidth = 0;
+			sheetHeight = 0;
+			_plates = 0;
+			_unplaced = 0;
+			_withoutOperations = 0;
+		}
+
+		bool addSheet(const std::string& name, double thickness, double x, const vector<Ptr<BRepBody>>& bodies, const vector<std::string>& names);
+	};
+}
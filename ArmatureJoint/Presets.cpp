@@ -0,0 +1,341 @@
+#include "Presets.h"
+
+#include <math.h>
+#include <string.h>
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <map>
+
+#include "Parallel.h"
+#include "UI.h"
+#include "Units.h"
+#include "Validator.h"
+
+namespace ArmatureJoint {
+	namespace {
+		const char magic[8] = { 'A', 'J', 'P', 'R', 'E', 'S', 'E', 'T' };
+		const uint32_t version = 2;
+
+		struct Header {
+			char magic[8];
+			uint32_t version;
+			uint32_t count;
+			uint32_t recordSize;
+			uint32_t snapshotSize;
+			uint32_t byNameOffset;
+			uint32_t namesOffset;
+			uint32_t namesSize;
+			uint32_t reserved;
+		};
+
+		struct Size {
+			const char* name;
+			Length value;
+		};
+
+		// Steel and brass ball bearings sold for armatures, K&S brass sheet gauges, and the screws that clamp them.
+		const Size balls[] = {
+			{ "1/8 in", 1_in / 8 }, { "5/32 in", 5_in / 32 }, { "3/16 in", 3_in / 16 }, { "7/32 in", 7_in / 32 },
+			{ "1/4 in", 1_in / 4 }, { "5/16 in", 5_in / 16 }, { "3/8 in", 3_in / 8 }, { "1/2 in", 1_in / 2 },
+			{ "3 mm", 3_mm }, { "4 mm", 4_mm }, { "5 mm", 5_mm }, { "6 mm", 6_mm }, { "8 mm", 8_mm }, { "10 mm", 10_mm },
+		};
+
+		const Size plates[] = {
+			{ "0.032 in", 0.032_in }, { "0.064 in", 0.064_in }, { "3/32 in", 3_in / 32 }, { "1/8 in", 1_in / 8 },
+			{ "1.5 mm", 1.5_mm }, { "2 mm", 2_mm }, { "3 mm", 3_mm },
+		};
+
+		const Size bolts[] = {
+			{ "M2", 2.2_mm }, { "M2.5", 2.7_mm }, { "M3", 3.2_mm }, { "2-56", 0.096_in }, { "4-40", 0.12_in },
+		};
+
+		const int grids[][2] = { { 2, 1 }, { 1, 2 }, { 2, 2 } };
+
+		const Length step = 0.5_mm;
+		const int maxSteps = 200;
+		const Length resolution = 0.01_mm;
+
+		double roundUp(double value) {
+			return ceil((value / step.centimetres()) - 1e-9) * step.centimetres();
+		}
+
+		// The smallest plate on the step grid that validates, or false when none within reach does.
+		bool smallestPlate(JointSpec& spec) {
+			auto best = HUGE_VAL;
+			JointSpec trial = spec;
+			Layout layout(trial);
+
+			auto minWidth = roundUp(layout.minWidth());
+			auto minLength = roundUp(layout.minLength());
+
+			std::string error;
+			for (auto w = 0; w < maxSteps; w++) {
+				trial.width = minWidth + (w * step.centimetres());
+				if (trial.width * minLength >= best)
+					break;
+
+				for (auto l = 0; l < maxSteps; l++) {
+					trial.length = minLength + (l * step.centimetres());
+					if (trial.length * trial.width >= best)
+						break;
+
+					layout.spec(trial);
+					if (Validator::validate(layout, error)) {
+						best = trial.length * trial.width;
+						spec.length = trial.length;
+						spec.width = trial.width;
+						break;
+					}
+				}
+			}
+
+			return best < HUGE_VAL;
+		}
+
+		// How far one size can go from a spec that validates towards one that does not, to within resolution, with
+		// everything else as it is.
+		double furthest(const JointSpec& spec, double from, double to, const std::function<void(JointSpec&, double)>& set) {
+			JointSpec trial = spec;
+			Layout layout(trial);
+			std::string error;
+
+			auto good = from;
+			auto bad = to;
+			while (fabs(bad - good) > resolution.centimetres()) {
+				auto middle = (good + bad) / 2;
+				set(trial, middle);
+				layout.spec(trial);
+				if (Validator::validate(layout, error))
+					good = middle;
+				else
+					bad = middle;
+			}
+
+			return good;
+		}
+	}
+
+	PresetLibrary::PresetLibrary() : records(nullptr), byName(nullptr), names(nullptr), namesSize(0), count(0) {
+	}
+
+	std::shared_ptr<PresetLibrary> PresetLibrary::open(const std::string& path) {
+		auto library = std::shared_ptr<PresetLibrary>(new PresetLibrary());
+		library->file = MappedFile::open(path);
+		if (!library->file || library->file->size() < sizeof(Header))
+			return nullptr;
+
+		auto data = library->file->data();
+
+		// Only the header and the section bounds are checked here, so opening does not grow with the catalogue.
+		auto header = (const Header*)data;
+		if (memcmp(header->magic, magic, sizeof(magic)) != 0 || header->version != version)
+			return nullptr;
+
+		if (header->recordSize != sizeof(PresetRecord) || header->snapshotSize != Layout::snapshotSize)
+			return nullptr;
+
+		auto recordsEnd = sizeof(Header) + ((size_t)header->count * sizeof(PresetRecord));
+		if (header->byNameOffset < recordsEnd || header->byNameOffset + ((size_t)header->count * sizeof(uint32_t)) > header->namesOffset)
+			return nullptr;
+
+		if ((size_t)header->namesOffset + header->namesSize > library->file->size())
+			return nullptr;
+
+		library->count = header->count;
+		library->records = (const PresetRecord*)(data + sizeof(Header));
+		library->byName = (const uint32_t*)(data + header->byNameOffset);
+		library->names = data + header->namesOffset;
+		library->namesSize = header->namesSize;
+
+		return library;
+	}
+
+	bool PresetLibrary::write(const std::string& path, const std::vector<JointSpec>& specs, std::string& error, int workers) {
+		std::vector<PresetRecord> records(specs.size());
+		std::vector<std::string> errors(specs.size());
+
+		Parallel::forEach(specs.size(), [&](size_t i, int) {
+			auto& spec = specs[i];
+			auto& record = records[i];
+			memset(&record, 0, sizeof(record));
+
+			Layout layout(spec);
+			if (!Validator::validate(layout, errors[i]))
+				return;
+
+			record.rows = spec.rows;
+			record.cols = spec.cols;
+			record.length = spec.length;
+			record.width = spec.width;
+			record.thickness = spec.thickness;
+			record.ballDiameter = spec.ballDiameter;
+			record.boltHoleDiameter = spec.boltHoleDiameter;
+			record.holeDiameter = spec.cells.empty() ? 0 : spec.cells[0].holeDiameter;
+			record.minLength = layout.minLength();
+			record.minWidth = layout.minWidth();
+			record.minThickness = furthest(spec, spec.thickness, 0, [](JointSpec& trial, double thickness) {
+				trial.thickness = thickness;
+			});
+			record.maxHoleDiameter = furthest(spec, record.holeDiameter, spec.ballDiameter, [](JointSpec& trial, double diameter) {
+				for (auto& cell : trial.cells)
+					cell.holeDiameter = diameter;
+			});
+			record.maxBallDiameter = layout.maxBallDiameter();
+			layout.snapshot(record.layout);
+		}, workers);
+
+		std::string names;
+		for (size_t i = 0; i < specs.size(); i++) {
+			if (!errors[i].empty()) {
+				error = specs[i].name + ": " + errors[i];
+				return false;
+			}
+
+			records[i].nameOffset = (uint32_t)names.size();
+			records[i].nameLength = (uint32_t)specs[i].name.size();
+			names += specs[i].name;
+		}
+
+		std::vector<uint32_t> byName(specs.size());
+		for (size_t i = 0; i < byName.size(); i++)
+			byName[i] = (uint32_t)i;
+		std::sort(byName.begin(), byName.end(), [&](uint32_t a, uint32_t b) { return specs[a].name < specs[b].name; });
+
+		Header header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, magic, sizeof(magic));
+		header.version = version;
+		header.count = (uint32_t)records.size();
+		header.recordSize = sizeof(PresetRecord);
+		header.snapshotSize = Layout::snapshotSize;
+		header.byNameOffset = (uint32_t)(sizeof(Header) + (records.size() * sizeof(PresetRecord)));
+		header.namesOffset = (uint32_t)(header.byNameOffset + (byName.size() * sizeof(uint32_t)));
+		header.namesSize = (uint32_t)names.size();
+
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			error = "could not open " + path;
+			return false;
+		}
+
+		file.write((const char*)&header, sizeof(header));
+		file.write((const char*)records.data(), records.size() * sizeof(PresetRecord));
+		file.write((const char*)byName.data(), byName.size() * sizeof(uint32_t));
+		file.write(names.data(), names.size());
+		file.close();
+
+		if (file.fail()) {
+			error = "could not write " + path;
+			return false;
+		}
+
+		return true;
+	}
+
+	std::vector<JointSpec> PresetLibrary::catalogue(int workers) {
+		std::vector<JointSpec> candidates;
+		for (auto& ball : balls) {
+			for (auto& plate : plates) {
+				for (auto& bolt : bolts) {
+					for (auto& grid : grids) {
+						JointSpec spec;
+						spec.name = ball.name + std::string(" ball, ") + plate.name + " plate, " + bolt.name + ", " + std::to_string(grid[0]) + "x" + std::to_string(grid[1]);
+						spec.thickness = plate.value.centimetres();
+						spec.ballDiameter = ball.value.centimetres();
+						spec.boltHoleDiameter = bolt.value.centimetres();
+
+						// Screw holes a little under half the ball, rounded down to a tenth of a millimetre.
+						JointCell cell = { ARMATURE_JOINT_OPTION_BALL, floor((ball.value * 0.45).millimetres() * 10) / 100 };
+						spec.resize(grid[0], grid[1], cell);
+						candidates.push_back(spec);
+					}
+				}
+			}
+		}
+
+		std::vector<char> feasible(candidates.size(), 0);
+		Parallel::forEach(candidates.size(), [&](size_t i, int) {
+			feasible[i] = smallestPlate(candidates[i]);
+		}, workers);
+
+		std::vector<JointSpec> specs;
+		for (size_t i = 0; i < candidates.size(); i++) {
+			if (feasible[i])
+				specs.push_back(candidates[i]);
+		}
+
+		return specs;
+	}
+
+	size_t PresetLibrary::size() const {
+		return count;
+	}
+
+	std::string PresetLibrary::name(size_t index) const {
+		auto& record = records[index];
+		if ((size_t)record.nameOffset + record.nameLength > namesSize)
+			return "";
+
+		return std::string(names + record.nameOffset, record.nameLength);
+	}
+
+	const PresetRecord& PresetLibrary::record(size_t index) const {
+		return records[index];
+	}
+
+	JointSpec PresetLibrary::spec(size_t index) const {
+		auto& record = records[index];
+
+		JointSpec spec;
+		spec.name = name(index);
+		spec.length = record.length;
+		spec.width = record.width;
+		spec.thickness = record.thickness;
+		spec.ballDiameter = record.ballDiameter;
+		spec.boltHoleDiameter = record.boltHoleDiameter;
+
+		// The grid comes straight from the file, so it is held to what the dialog can show.
+		JointCell cell = { ARMATURE_JOINT_OPTION_BALL, record.holeDiameter };
+		spec.resize(std::min(std::max((int)record.rows, 1), Defaults::maxRows), std::min(std::max((int)record.cols, 1), Defaults::maxCols), cell);
+		return spec;
+	}
+
+	Layout PresetLibrary::layout(size_t index) const {
+		Layout layout(spec(index));
+		layout.restore(records[index].layout);
+		return layout;
+	}
+
+	bool PresetLibrary::find(const std::string& name, size_t& index) const {
+		auto compare = [&](uint32_t i, const std::string& key) {
+			return i < count && this->name(i) < key;
+		};
+
+		auto found = std::lower_bound(byName, byName + count, name, compare);
+		if (found == byName + count || *found >= count || this->name(*found) != name)
+			return false;
+
+		index = *found;
+		return true;
+	}
+
+	const std::vector<PresetGroup>& PresetLibrary::groups() const {
+		std::call_once(grouped, [&]() {
+			std::map<std::string, size_t> indices;
+			for (size_t i = 0; i < count; i++) {
+				auto name = this->name(i);
+				auto group = name.substr(0, name.find(','));
+
+				auto found = indices.find(group);
+				if (found == indices.end()) {
+					found = indices.insert(std::make_pair(group, groupList.size())).first;
+					PresetGroup added = { group, std::vector<size_t>() };
+					groupList.push_back(added);
+				}
+				groupList[found->second].presets.push_back(i);
+			}
+		});
+		return groupList;
+	}
+}
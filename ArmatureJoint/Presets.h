@@ -0,0 +1,75 @@
+#pragma once
+
+#include <stdint.h>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "JointSpec.h"
+#include "Layout.h"
+#include "MappedFile.h"
+
+namespace ArmatureJoint {
+	// One preset as stored in the file, in centimetres. Every preset is a grid of balls with the same screw hole.
+	// The envelope is how far each size can go, with the others as they are, before the layout stops validating.
+	struct PresetRecord {
+		uint32_t nameOffset;
+		uint32_t nameLength;
+		int32_t rows;
+		int32_t cols;
+		double length;
+		double width;
+		double thickness;
+		double ballDiameter;
+		double boltHoleDiameter;
+		double holeDiameter;
+		double minLength;
+		double minWidth;
+		double minThickness;
+		double maxHoleDiameter;
+		double maxBallDiameter;
+		double layout[Layout::snapshotSize];
+	};
+
+	// Presets whose names share the part before the first comma, the ball size in the standard catalogue.
+	struct PresetGroup {
+		std::string name;
+		std::vector<size_t> presets; // in catalogue order
+	};
+
+	// A catalogue of presets with their layouts worked out ahead of time, read straight from a memory mapped file so
+	// opening it costs the same for ten entries or ten thousand. The file is a header, the records in catalogue
+	// order, their indices sorted by name, then the names. Values are little endian.
+	class PresetLibrary {
+	public:
+		static std::shared_ptr<PresetLibrary> open(const std::string& path);
+		static bool write(const std::string& path, const std::vector<JointSpec>& specs, std::string& error, int workers = 0);
+
+		// Standard ball, plate and bolt sizes, each on the smallest plate in half millimetre steps that validates.
+		static std::vector<JointSpec> catalogue(int workers = 0);
+
+		size_t size() const;
+		std::string name(size_t index) const;
+		const PresetRecord& record(size_t index) const;
+		JointSpec spec(size_t index) const;
+		Layout layout(size_t index) const;
+		bool find(const std::string& name, size_t& index) const;
+
+		// Worked out on first use and kept, so the dialog can list one group at a time.
+		const std::vector<PresetGroup>& groups() const;
+
+	private:
+		PresetLibrary();
+
+		std::unique_ptr<MappedFile> file;
+		const PresetRecord* records;
+		const uint32_t* byName;
+		const char* names;
+		size_t namesSize;
+		size_t count;
+
+		mutable std::once_flag grouped;
+		mutable std::vector<PresetGroup> groupList;
+	};
+}
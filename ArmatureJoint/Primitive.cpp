@@ -0,0 +1,296 @@
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include "Primitive.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		const int maxIterations = 64;
+		const double tolerance = 1e-12;
+
+		// Points of the Minkowski difference spanning the current GJK simplex.
+		struct Simplex {
+			Vector3 p[4];
+			int n;
+		};
+
+		Vector3 closestOnSegment(Simplex& s) {
+			auto a = s.p[0];
+			auto ab = s.p[1] - a;
+
+			auto lengthSquared = ab.lengthSquared();
+			auto t = lengthSquared > 0 ? -a.dot(ab) / lengthSquared : 0;
+			if (t <= 0) {
+				s.n = 1;
+				return a;
+			}
+			if (t >= 1) {
+				s.p[0] = s.p[1];
+				s.n = 1;
+				return s.p[0];
+			}
+			return a + (ab * t);
+		}
+
+		// Closest point of a triangle to the origin by Voronoi regions, keeping only the vertices of the closest feature.
+		Vector3 closestOnTriangle(Simplex& s) {
+			auto a = s.p[0];
+			auto b = s.p[1];
+			auto c = s.p[2];
+			auto ab = b - a;
+			auto ac = c - a;
+
+			auto d1 = ab.dot(-a);
+			auto d2 = ac.dot(-a);
+			if (d1 <= 0 && d2 <= 0) {
+				s.n = 1;
+				return a;
+			}
+
+			auto d3 = ab.dot(-b);
+			auto d4 = ac.dot(-b);
+			if (d3 >= 0 && d4 <= d3) {
+				s.p[0] = b;
+				s.n = 1;
+				return b;
+			}
+
+			auto vc = (d1 * d4) - (d3 * d2);
+			if (vc <= 0 && d1 >= 0 && d3 <= 0) {
+				s.n = 2;
+				return a + (ab * (d1 / (d1 - d3)));
+			}
+
+			auto d5 = ab.dot(-c);
+			auto d6 = ac.dot(-c);
+			if (d6 >= 0 && d5 <= d6) {
+				s.p[0] = c;
+				s.n = 1;
+				return c;
+			}
+
+			auto vb = (d5 * d2) - (d1 * d6);
+			if (vb <= 0 && d2 >= 0 && d6 <= 0) {
+				s.p[1] = c;
+				s.n = 2;
+				return a + (ac * (d2 / (d2 - d6)));
+			}
+
+			auto va = (d3 * d6) - (d5 * d4);
+			if (va <= 0 && (d4 - d3) >= 0 && (d5 - d6) >= 0) {
+				s.p[0] = b;
+				s.p[1] = c;
+				s.n = 2;
+				return b + ((c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6))));
+			}
+
+			auto denominator = 1 / (va + vb + vc);
+			return a + (ab * (vb * denominator)) + (ac * (vc * denominator));
+		}
+
+		// Closest point of a tetrahedron to the origin, from the faces the origin lies outside of.
+		Vector3 closestOnTetrahedron(Simplex& s, bool& inside) {
+			static const int faces[4][4] = { { 0, 1, 2, 3 }, { 0, 2, 3, 1 }, { 0, 3, 1, 2 }, { 1, 3, 2, 0 } };
+
+			auto best = HUGE_VAL;
+			Vector3 closest;
+			Simplex reduced = s;
+			inside = true;
+
+			for (auto& face : faces) {
+				auto a = s.p[face[0]];
+				auto normal = (s.p[face[1]] - a).cross(s.p[face[2]] - a);
+				auto opposite = normal.dot(s.p[face[3]] - a);
+				auto origin = normal.dot(-a);
+
+				// A flat tetrahedron has no inside, so each of its faces is a candidate.
+				if (fabs(opposite) > tolerance * tolerance && origin * opposite >= 0)
+					continue;
+
+				inside = false;
+
+				Simplex triangle;
+				triangle.p[0] = a;
+				triangle.p[1] = s.p[face[1]];
+				triangle.p[2] = s.p[face[2]];
+				triangle.n = 3;
+
+				auto point = closestOnTriangle(triangle);
+				if (point.lengthSquared() < best) {
+					best = point.lengthSquared();
+					closest = point;
+					reduced = triangle;
+				}
+			}
+
+			s = reduced;
+			return closest;
+		}
+	}
+
+	Primitive::Primitive() : joint(0), part(Ball), core(Point), radius(0) {
+		axes = { { Vector3(1, 0, 0), Vector3(0, 1, 0), Vector3(0, 0, 1) } };
+	}
+
+	Vector3 Primitive::support(const Vector3& direction) const {
+		switch (core) {
+		case Segment:
+			return centre + (axes[0] * (direction.dot(axes[0]) < 0 ? -halfExtents.x : halfExtents.x));
+		case Box: {
+			auto point = centre;
+			for (auto i = 0; i < 3; i++)
+				point = point + (axes[i] * (direction.dot(axes[i]) < 0 ? -halfExtents[i] : halfExtents[i]));
+			return point;
+		}
+		default:
+			return centre;
+		}
+	}
+
+	Aabb Primitive::bounds(double margin) const {
+		auto reach = radius + margin;
+
+		Vector3 extent;
+		if (core == Segment) {
+			extent = Vector3(fabs(axes[0].x), fabs(axes[0].y), fabs(axes[0].z)) * halfExtents.x;
+		}
+		else if (core == Box) {
+			for (auto i = 0; i < 3; i++)
+				extent = extent + (Vector3(fabs(axes[i].x), fabs(axes[i].y), fabs(axes[i].z)) * halfExtents[i]);
+		}
+
+		extent = extent + Vector3(reach, reach, reach);
+		return Aabb(centre - extent, centre + extent);
+	}
+
+	Primitive Primitive::transformed(const Transform& transform) const {
+		auto primitive = *this;
+		primitive.centre = transform.point(centre);
+		for (auto i = 0; i < 3; i++)
+			primitive.axes[i] = transform.vector(axes[i]);
+		return primitive;
+	}
+
+	// GJK on the Minkowski difference of the two cores.
+	double Primitive::distance(const Primitive& a, const Primitive& b, bool& overlapping) {
+		overlapping = false;
+
+		Simplex simplex;
+		simplex.n = 0;
+
+		auto v = a.centre - b.centre;
+		if (v.lengthSquared() < tolerance)
+			v = a.support(Vector3(1, 0, 0)) - b.support(Vector3(-1, 0, 0));
+
+		auto inside = false;
+		for (auto i = 0; i < maxIterations; i++) {
+			auto w = a.support(-v) - b.support(v);
+
+			// No support point gets any closer to the origin, so v is the closest point.
+			auto vv = v.lengthSquared();
+			if (simplex.n > 0 && vv - v.dot(w) <= tolerance * vv)
+				break;
+
+			auto duplicate = false;
+			for (auto j = 0; j < simplex.n; j++)
+				duplicate = duplicate || (simplex.p[j] - w).lengthSquared() < tolerance * tolerance;
+			if (duplicate)
+				break;
+
+			simplex.p[simplex.n++] = w;
+
+			switch (simplex.n) {
+			case 1: v = w; break;
+			case 2: v = closestOnSegment(simplex); break;
+			case 3: v = closestOnTriangle(simplex); break;
+			default: v = closestOnTetrahedron(simplex, inside); break;
+			}
+
+			if (inside) {
+				v = Vector3();
+				break;
+			}
+
+			if (v.lengthSquared() < tolerance)
+				break;
+		}
+
+		// Touching within tolerance counts as overlapping.
+		if (v.lengthSquared() < tolerance) {
+			overlapping = true;
+			return 0;
+		}
+
+		return v.length();
+	}
+
+	// Local joint coordinates follow the generated model: x along the joint length, y up through the plates and z across
+	// the width, so a sketch point (x, y) on the bottom plate sits at (x, height, -y).
+	void Primitive::fromLayout(const Layout& layout, int joint, std::vector<Primitive>& primitives) {
+		Primitive plate;
+		plate.joint = joint;
+		plate.part = Plate;
+		plate.core = Box;
+		plate.halfExtents = Vector3(layout.length() / 2, layout.thickness() / 2, layout.width() / 2);
+
+		auto topBase = layout.ballZ() + layout.plateOffset();
+
+		plate.centre = Vector3(layout.length() / 2, layout.thickness() / 2, layout.width() / 2);
+		primitives.push_back(plate);
+
+		plate.centre = Vector3(layout.length() / 2, topBase + (layout.thickness() / 2), layout.width() / 2);
+		primitives.push_back(plate);
+
+		auto nutSpan = 2 * layout.ballOffset() * tan(M_PI / 6);
+
+		for (auto row = 1; row <= layout.rows(); row++) {
+			for (auto col = 1; col <= layout.cols(); col++) {
+				Primitive primitive;
+				primitive.joint = joint;
+				primitive.centre = Vector3(layout.ballX(col), layout.ballZ(), -layout.ballY(row));
+
+				auto type = layout.jointType(row, col);
+				if (type == ARMATURE_JOINT_OPTION_BALL) {
+					primitive.part = Ball;
+					primitive.core = Point;
+					primitive.radius = layout.ballRadius();
+				}
+				else if (type == ARMATURE_JOINT_OPTION_NUT) {
+					// The hex prism is bounded by its across-corners box.
+					primitive.part = Nut;
+					primitive.core = Box;
+					primitive.halfExtents = Vector3(layout.ballRadius() / 2, layout.ballOffset(), nutSpan);
+				}
+				else {
+					continue;
+				}
+
+				primitives.push_back(primitive);
+			}
+		}
+
+		// The clamping bolt runs up through both plates with a socket head under the bottom plate, sized as ISO 4762
+		// (head 1.75 d across, d high). It sticks out one diameter above the top plate for the nut.
+		auto d = layout.boltHoleDiameter();
+		auto top = topBase + layout.thickness() + d;
+
+		Primitive shaft;
+		shaft.joint = joint;
+		shaft.part = Bolt;
+		shaft.core = Segment;
+		shaft.axes = { { Vector3(0, 1, 0), Vector3(0, 0, 1), Vector3(1, 0, 0) } };
+		shaft.centre = Vector3(layout.length() / 2, top / 2, layout.width() / 2);
+		shaft.halfExtents = Vector3(top / 2, 0, 0);
+		shaft.radius = layout.boltHoleRadius();
+		primitives.push_back(shaft);
+
+		Primitive head;
+		head.joint = joint;
+		head.part = Bolt;
+		head.core = Box;
+		head.centre = Vector3(layout.length() / 2, -d / 2, layout.width() / 2);
+		head.halfExtents = Vector3(0.875 * d, d / 2, 0.875 * d);
+		primitives.push_back(head);
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include "Geometry.h"
+#include "Layout.h"
+
+namespace ArmatureJoint {
+	// A convex core (point, segment or box) swept by a radius. Every solid of a joint is described this way, so any
+	// two of them can be measured with the same GJK distance query.
+	struct Primitive {
+		enum Core { Point, Segment, Box };
+		enum Part { Ball, Plate, Nut, Bolt };
+
+		int joint;
+		Part part;
+		Core core;
+		Vector3 centre;
+		std::array<Vector3, 3> axes; // unit axes; a segment runs along axes[0]
+		Vector3 halfExtents; // along each axis; a segment only uses x
+		double radius;
+
+		Primitive();
+
+		Vector3 support(const Vector3& direction) const;
+		Aabb bounds(double margin) const;
+		Primitive transformed(const Transform& transform) const;
+
+		// Distance between the cores, zero when they overlap. Subtract both radii for the clearance between the solids.
+		static double distance(const Primitive& a, const Primitive& b, bool& overlapping);
+
+		// The solids of a generated joint in its own coordinates: balls, both plates, nuts and the clamping bolt.
+		static void fromLayout(const Layout& layout, int joint, std::vector<Primitive>& primitives);
+	};
+}
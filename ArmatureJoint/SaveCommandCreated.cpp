@@ -0,0 +1,28 @@
+#include "SaveCommandCreated.h"
+
+namespace ArmatureJoint {
+	void SaveCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		// Everything is saved, so there is nothing to ask before the file dialog.
+		cmd->isAutoExecute(true);
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "SaveCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class SaveCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<SaveCommandExecuted> _onExecute;
+
+	public:
+		SaveCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<SaveCommandExecuted>(new SaveCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
@@ -0,0 +1,80 @@
+#include "SaveCommandExecuted.h"
+
+#include <set>
+
+#include "JointAttributes.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	void SaveCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto root = design->rootComponent();
+		if (!root)
+			return;
+
+		auto ui = app->userInterface();
+		if (!ui)
+			return;
+
+		// One spec per occurrence, at its placement. Names must be unique in a file, so repeats are numbered the way
+		// they would be read back: loading the file and saving again gives the same names.
+		std::vector<JointSpec> specs;
+		std::set<std::string> names;
+		for (auto& component : JointAttributes::joints(design)) {
+			JointSpec spec;
+			if (!JointAttributes::readSpec(component, spec))
+				continue;
+
+			auto occurrences = root->allOccurrencesByComponent(component);
+			for (size_t i = 0; occurrences && i < occurrences->count(); i++) {
+				auto occurrence = occurrences->item(i);
+				if (!occurrence || !occurrence->transform2())
+					continue;
+
+				auto matrix = occurrence->transform2()->asArray();
+				if (matrix.size() != 16)
+					continue;
+
+				JointSpec placed = spec;
+				std::copy(matrix.begin(), matrix.end(), placed.transform.begin());
+				for (auto n = 2; !names.insert(placed.name).second; n++)
+					placed.name = spec.name + " " + std::to_string(n);
+
+				specs.push_back(placed);
+			}
+		}
+
+		if (specs.empty()) {
+			ui->messageBox("There are no armature joints in the design.", "Save Armature");
+			return;
+		}
+
+		auto fileDialog = ui->createFileDialog();
+		if (!fileDialog)
+			return;
+
+		fileDialog->title("Save Armature");
+		fileDialog->filter(ARMATURE_JOINT_SAVE_FILE_FILTER);
+
+		if (fileDialog->showSave() != DialogResults::DialogOK)
+			return;
+
+		std::string error;
+		if (!JointSpecFile::write(fileDialog->filename(), specs, error)) {
+			ui->messageBox(error, "Save Armature");
+			return;
+		}
+
+		ui->messageBox("Saved " + std::to_string(specs.size()) + " joints.", "Save Armature");
+	}
+}
@@ -0,0 +1,306 @@
+#include "Skeleton.h"
+
+#include <math.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <algorithm>
+#include <numeric>
+#include <sstream>
+#include <unordered_map>
+
+#include "Layout.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		struct BvhNode {
+			std::string name;
+			Vector3 position;
+			bool placed;
+		};
+
+		bool readNumber(std::istringstream& tokens, double& value) {
+			std::string token;
+			if (!(tokens >> token))
+				return false;
+
+			char* end;
+			value = strtod(token.c_str(), &end);
+			return *end == 0;
+		}
+
+		uint64_t cellKey(int64_t x, int64_t y, int64_t z) {
+			return ((uint64_t)x * 73856093) ^ ((uint64_t)y * 19349663) ^ ((uint64_t)z * 83492791);
+		}
+
+		int findRoot(std::vector<int>& parents, int i) {
+			while (parents[i] != i) {
+				parents[i] = parents[parents[i]];
+				i = parents[i];
+			}
+			return i;
+		}
+	}
+
+	// The rest pose is the hierarchy's offsets alone, so the MOTION section is never read. BVH is y up with the
+	// character facing +z, and its plates are laid in the frontal plane.
+	bool Skeleton::readBvh(const std::string& text, double unitScale, Skeleton& skeleton, std::string& error) {
+		std::istringstream tokens(text);
+		std::string token;
+		if (!(tokens >> token) || token != "HIERARCHY") {
+			error = "not a BVH file";
+			return false;
+		}
+
+		std::vector<BvhNode> stack;
+		std::string name;
+		while (tokens >> token && token != "MOTION") {
+			if (token == "ROOT" || token == "JOINT") {
+				if (!(tokens >> name)) {
+					error = "missing joint name";
+					return false;
+				}
+			}
+			else if (token == "End") {
+				tokens >> token;
+				name = "End";
+			}
+			else if (token == "{") {
+				BvhNode node;
+				node.name = name;
+				node.position = stack.empty() ? Vector3() : stack.back().position;
+				node.placed = false;
+				stack.push_back(node);
+			}
+			else if (token == "}") {
+				if (stack.empty()) {
+					error = "unbalanced braces";
+					return false;
+				}
+				stack.pop_back();
+			}
+			else if (token == "OFFSET") {
+				Vector3 offset;
+				if (stack.empty() || stack.back().placed || !readNumber(tokens, offset.x) || !readNumber(tokens, offset.y) || !readNumber(tokens, offset.z)) {
+					error = "bad OFFSET";
+					return false;
+				}
+
+				auto& node = stack.back();
+				node.position = node.position + (offset * unitScale);
+				node.placed = true;
+
+				// Each segment is named after the joints at both ends, since a joint may have several children.
+				if (stack.size() > 1) {
+					auto& parent = stack[stack.size() - 2];
+					skeleton.add(parent.name + "-" + node.name, parent.position, node.position, Vector3(0, 0, 1));
+				}
+			}
+			else if (token == "CHANNELS") {
+				double count;
+				if (!readNumber(tokens, count) || count < 0) {
+					error = "bad CHANNELS";
+					return false;
+				}
+				for (auto i = 0; i < (int)count; i++)
+					tokens >> token;
+			}
+		}
+
+		if (!stack.empty()) {
+			error = "unbalanced braces";
+			return false;
+		}
+
+		if (skeleton.bones().empty()) {
+			error = "no bones in the hierarchy";
+			return false;
+		}
+
+		return true;
+	}
+
+	void Skeleton::add(const std::string& name, const Vector3& start, const Vector3& end, const Vector3& up) {
+		Bone bone;
+		bone.name = name;
+		bone.start = start;
+		bone.end = end;
+		bone.up = up;
+		bone.junctions[0] = -1;
+		bone.junctions[1] = -1;
+		_bones.push_back(bone);
+	}
+
+	void Skeleton::connect(double tolerance) {
+		tolerance = std::max(tolerance, 1e-9);
+
+		// Bones no longer than the tolerance would join themselves.
+		_bones.erase(std::remove_if(_bones.begin(), _bones.end(), [&](const Bone& bone) {
+			return (bone.end - bone.start).length() <= tolerance;
+		}), _bones.end());
+
+		auto endCount = (int)_bones.size() * 2;
+		auto position = [&](int end) -> const Vector3& { return end % 2 ? _bones[end / 2].end : _bones[end / 2].start; };
+
+		// Cells as wide as the tolerance, so any end within reach of another is in one of the 27 cells around it.
+		// Colliding keys only cost a few extra distance checks.
+		std::unordered_map<uint64_t, std::vector<int>> cells;
+		cells.reserve(endCount);
+
+		std::vector<int> parents(endCount);
+		std::iota(parents.begin(), parents.end(), 0);
+
+		for (auto i = 0; i < endCount; i++) {
+			auto& p = position(i);
+			auto x = (int64_t)floor(p.x / tolerance);
+			auto y = (int64_t)floor(p.y / tolerance);
+			auto z = (int64_t)floor(p.z / tolerance);
+
+			for (auto dx = -1; dx <= 1; dx++) {
+				for (auto dy = -1; dy <= 1; dy++) {
+					for (auto dz = -1; dz <= 1; dz++) {
+						auto found = cells.find(cellKey(x + dx, y + dy, z + dz));
+						if (found == cells.end())
+							continue;
+
+						for (auto j : found->second) {
+							if ((position(j) - p).lengthSquared() <= tolerance * tolerance)
+								parents[findRoot(parents, j)] = findRoot(parents, i);
+						}
+					}
+				}
+			}
+
+			cells[cellKey(x, y, z)].push_back(i);
+		}
+
+		std::vector<int> sizes(endCount, 0);
+		for (auto i = 0; i < endCount; i++)
+			sizes[findRoot(parents, i)]++;
+
+		_junctions.clear();
+		std::vector<int> junctionOf(endCount, -1);
+		for (auto i = 0; i < endCount; i++) {
+			auto root = findRoot(parents, i);
+			if (sizes[root] < 2)
+				continue;
+
+			if (junctionOf[root] < 0) {
+				junctionOf[root] = (int)_junctions.size();
+				_junctions.push_back(Junction());
+			}
+
+			auto& junction = _junctions[junctionOf[root]];
+			junction.position = junction.position + (position(i) * (1.0 / sizes[root]));
+			junction.ends.push_back(i);
+			_bones[i / 2].junctions[i % 2] = junctionOf[root];
+		}
+
+		orient();
+	}
+
+	void Skeleton::orient() {
+		std::vector<int> order(_junctions.size());
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return _junctions[a].ends.size() > _junctions[b].ends.size(); });
+
+		std::vector<char> visited(_junctions.size(), 0);
+		std::vector<char> oriented(_bones.size(), 0);
+		std::vector<int> queue;
+
+		for (auto root : order) {
+			if (visited[root])
+				continue;
+
+			visited[root] = 1;
+			queue.assign(1, root);
+			for (size_t next = 0; next < queue.size(); next++) {
+				for (auto end : _junctions[queue[next]].ends) {
+					auto& bone = _bones[end / 2];
+					if (oriented[end / 2])
+						continue;
+
+					oriented[end / 2] = 1;
+					if (end % 2) {
+						std::swap(bone.start, bone.end);
+						std::swap(bone.junctions[0], bone.junctions[1]);
+					}
+
+					auto reached = bone.junctions[1];
+					if (reached >= 0 && !visited[reached]) {
+						visited[reached] = 1;
+						queue.push_back(reached);
+					}
+				}
+			}
+		}
+
+		for (auto& junction : _junctions)
+			junction.ends.clear();
+		for (size_t b = 0; b < _bones.size(); b++) {
+			for (auto side = 0; side < 2; side++) {
+				if (_bones[b].junctions[side] >= 0)
+					_junctions[_bones[b].junctions[side]].ends.push_back((int)(b * 2) + side);
+			}
+		}
+	}
+
+	const std::vector<Bone>& Skeleton::bones() const {
+		return _bones;
+	}
+
+	const std::vector<Junction>& Skeleton::junctions() const {
+		return _junctions;
+	}
+
+	// Joint coordinates follow the generated model (see Primitive::fromLayout): x along the plates, y up through them
+	// and z across, with the first ball at (ballX(1), ballZ, width / 2).
+	std::vector<JointSpec> Skeleton::place(const JointSpec& base, const JointCell& cell) const {
+		std::vector<JointSpec> specs;
+		specs.reserve(_bones.size());
+
+		for (auto& bone : _bones) {
+			auto start = bone.junctions[0] >= 0 ? _junctions[bone.junctions[0]].position : bone.start;
+			auto end = bone.junctions[1] >= 0 ? _junctions[bone.junctions[1]].position : bone.end;
+			auto span = (end - start).length();
+			if (span <= 0)
+				continue;
+
+			JointSpec spec = base;
+			spec.name = bone.name;
+			spec.cells.clear();
+			spec.rows = 0;
+			spec.cols = 0;
+			spec.resize(1, 2, cell);
+			spec.cell(1, 1).type = ARMATURE_JOINT_OPTION_NUT;
+			spec.cell(1, 2).type = bone.junctions[1] >= 0 ? ARMATURE_JOINT_OPTION_BALL : ARMATURE_JOINT_OPTION_NUT;
+
+			Layout layout(spec);
+			layout.length(span + (2 * (layout.ballRadius() / 1.25)));
+			layout.width(std::max(spec.width, layout.minWidth()));
+
+			auto x = (end - start) * (1 / span);
+			auto y = bone.up - (x * x.dot(bone.up));
+			if (y.length() < 1e-6) {
+				auto axis = fabs(x.x) <= fabs(x.y) && fabs(x.x) <= fabs(x.z) ? Vector3(1, 0, 0) : fabs(x.y) <= fabs(x.z) ? Vector3(0, 1, 0) : Vector3(0, 0, 1);
+				y = axis - (x * x.dot(axis));
+			}
+			y = y * (1 / y.length());
+			auto z = x.cross(y);
+
+			auto first = Vector3(layout.ballX(1), layout.ballZ(), -layout.ballY(1));
+			auto origin = start - ((x * first.x) + (y * first.y) + (z * first.z));
+
+			spec = layout.spec();
+			spec.transform = { {
+				x.x, y.x, z.x, origin.x,
+				x.y, y.y, z.y, origin.y,
+				x.z, y.z, z.z, origin.z,
+				0, 0, 0, 1,
+			} };
+			specs.push_back(spec);
+		}
+
+		return specs;
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "Geometry.h"
+#include "JointSpec.h"
+
+namespace ArmatureJoint {
+	struct Bone {
+		std::string name;
+		Vector3 start;
+		Vector3 end;
+		Vector3 up; // plates lie across this direction, as near as the bone allows
+		int junctions[2]; // at the start and end, or -1 for a free end
+	};
+
+	struct Junction {
+		Vector3 position;
+		std::vector<int> ends; // bone * 2 + 0 for its start, 1 for its end
+	};
+
+	// Bone lines, from a sketch or a BVH rest pose, and the junctions where they meet. Each bone becomes a pair of
+	// plates along it with a ball or nut at either end.
+	class Skeleton {
+	public:
+		static bool readBvh(const std::string& text, double unitScale, Skeleton& skeleton, std::string& error);
+
+		void add(const std::string& name, const Vector3& start, const Vector3& end, const Vector3& up);
+
+		// Bone ends within tolerance of each other meet at a junction, found through a spatial hash of the ends so
+		// each end is only compared with those in neighbouring cells. Bones are then turned to point away from the
+		// junction where most meet, so every other junction is reached by exactly one bone in a tree.
+		void connect(double tolerance);
+
+		const std::vector<Bone>& bones() const;
+		const std::vector<Junction>& junctions() const;
+
+		// One joint per bone, sized from the base spec with the plates as long as the bone between ball centres. The
+		// bone reaching a junction holds its ball and the bones leaving it hold the nuts its stem screws into; free
+		// ends get a nut so a hand, foot or head can be screwed on.
+		std::vector<JointSpec> place(const JointSpec& base, const JointCell& cell) const;
+
+	private:
+		std::vector<Bone> _bones;
+		std::vector<Junction> _junctions;
+
+		void orient();
+	};
+}
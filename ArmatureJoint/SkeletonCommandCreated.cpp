@@ -0,0 +1,96 @@
+#include "SkeletonCommandCreated.h"
+
+#include "JointParameters.h"
+#include "JointSpec.h"
+#include "UI.h"
+#include "Units.h"
+
+namespace ArmatureJoint {
+	void SkeletonCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto inputs = cmd->commandInputs();
+		if (!inputs)
+			return;
+
+		auto bonesInput = inputs->addSelectionInput(
+			ARMATURE_JOINT_SKELETON_BONES_INPUT_ID,
+			"Bones",
+			"Select the sketch lines of the skeleton"
+		);
+		if (!bonesInput)
+			return;
+
+		bonesInput->addSelectionFilter("SketchLines");
+		bonesInput->setSelectionLimits(0);
+
+		auto bvhInput = inputs->addBoolValueInput(ARMATURE_JOINT_SKELETON_BVH_INPUT_ID, "Import BVH Rest Pose", true, "", false);
+		if (!bvhInput)
+			return;
+
+		bvhInput->tooltip("Reads the bones from a motion capture file instead of the selected lines");
+
+		auto unitInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_SKELETON_BVH_UNIT_INPUT_ID,
+			"BVH Unit",
+			ValueInput::createByReal((1_cm).centimetres())
+		);
+		if (!unitInput)
+			return;
+
+		unitInput->tooltip("The length of one unit in the BVH file");
+
+		auto toleranceInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_SKELETON_TOLERANCE_INPUT_ID,
+			"Junction Tolerance",
+			ValueInput::createByReal((0.5_mm).centimetres())
+		);
+		if (!toleranceInput)
+			return;
+
+		toleranceInput->tooltip("Bone ends closer than this meet at one junction");
+
+		auto ballInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_SKELETON_BALL_DIAMETER_INPUT_ID,
+			"Ball Diameter",
+			ValueInput::createByReal(Defaults::ballDiameter.centimetres())
+		);
+		if (!ballInput)
+			return;
+
+		auto thicknessInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_SKELETON_THICKNESS_INPUT_ID,
+			"Plate Thickness",
+			ValueInput::createByReal(Defaults::thickness.centimetres())
+		);
+		if (!thicknessInput)
+			return;
+
+		if (!JointParameters::addInput(inputs, ARMATURE_JOINT_SKELETON_PARAMETERS_INPUT_ID))
+			return;
+
+		auto leanInput = inputs->addBoolValueInput(ARMATURE_JOINT_SKELETON_LEAN_INPUT_ID, "Lean Output", true, "", false);
+		if (!leanInput)
+			return;
+
+		leanInput->tooltip("Keeps only each joint's bodies, without its planes, sketches and features, so large designs open and recompute faster");
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
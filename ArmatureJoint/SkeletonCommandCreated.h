@@ -0,0 +1,19 @@
+#pragma once
+
+#include "SkeletonCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class SkeletonCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<SkeletonCommandExecuted> _onExecute;
+
+	public:
+		SkeletonCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<SkeletonCommandExecuted>(new SkeletonCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
@@ -0,0 +1,133 @@
+#include "SkeletonCommandExecuted.h"
+
+#include <chrono>
+#include <fstream>
+#include <sstream>
+
+#include "JointBuilder.h"
+#include "Skeleton.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	void SkeletonCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto command = eventArgs->command();
+		if (!command)
+			return;
+
+		auto inputs = command->commandInputs();
+		if (!inputs)
+			return;
+
+		auto bonesInput = static_cast<Ptr<SelectionCommandInput>>(inputs->itemById(ARMATURE_JOINT_SKELETON_BONES_INPUT_ID));
+		auto bvhInput = static_cast<Ptr<BoolValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_SKELETON_BVH_INPUT_ID));
+		auto unitInput = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_SKELETON_BVH_UNIT_INPUT_ID));
+		auto toleranceInput = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_SKELETON_TOLERANCE_INPUT_ID));
+		auto ballInput = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_SKELETON_BALL_DIAMETER_INPUT_ID));
+		auto thicknessInput = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_SKELETON_THICKNESS_INPUT_ID));
+		auto leanInput = static_cast<Ptr<BoolValueCommandInput>>(inputs->itemById(ARMATURE_JOINT_SKELETON_LEAN_INPUT_ID));
+		if (!bonesInput || !bvhInput || !unitInput || !toleranceInput || !ballInput || !thicknessInput || !leanInput)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto ui = app->userInterface();
+		if (!ui)
+			return;
+
+		Skeleton skeleton;
+		if (bvhInput->value()) {
+			auto fileDialog = ui->createFileDialog();
+			if (!fileDialog)
+				return;
+
+			fileDialog->title("Select BVH File");
+			fileDialog->filter(ARMATURE_JOINT_SKELETON_FILE_FILTER);
+			fileDialog->isMultiSelectEnabled(false);
+
+			if (fileDialog->showOpen() != DialogResults::DialogOK)
+				return;
+
+			std::ifstream file(fileDialog->filename(), std::ios::in | std::ios::binary);
+			std::stringstream text;
+			text << file.rdbuf();
+
+			std::string error;
+			if (!file || !Skeleton::readBvh(text.str(), unitInput->value(), skeleton, error)) {
+				ui->messageBox("Could not read " + fileDialog->filename() + (error.empty() ? "" : ": " + error), "Armature From Skeleton");
+				return;
+			}
+		}
+		else {
+			// Plates lie flat in the plane of the sketch each line was drawn on.
+			for (size_t i = 0; i < bonesInput->selectionCount(); i++) {
+				auto line = static_cast<Ptr<SketchLine>>(bonesInput->selection(i)->entity());
+				if (!line || !line->startSketchPoint() || !line->endSketchPoint() || !line->parentSketch())
+					continue;
+
+				auto start = line->startSketchPoint()->worldGeometry();
+				auto end = line->endSketchPoint()->worldGeometry();
+				auto transform = line->parentSketch()->transform();
+				if (!start || !end || !transform)
+					continue;
+
+				auto matrix = transform->asArray();
+				if (matrix.size() != 16)
+					continue;
+
+				skeleton.add(
+					"Bone " + std::to_string(i + 1),
+					Vector3(start->x(), start->y(), start->z()),
+					Vector3(end->x(), end->y(), end->z()),
+					Vector3(matrix[2], matrix[6], matrix[10])
+				);
+			}
+		}
+
+		if (skeleton.bones().empty()) {
+			ui->messageBox("Select the sketch lines of a skeleton, or import a BVH rest pose.", "Armature From Skeleton");
+			return;
+		}
+
+		// Screw holes keep the default joint's proportion to its ball.
+		auto base = JointSpec::defaults();
+		base.ballDiameter = ballInput->value();
+		base.thickness = thicknessInput->value();
+
+		auto cell = JointCell::defaults();
+		cell.holeDiameter = base.ballDiameter * (Defaults::holeDiameter / Defaults::ballDiameter);
+
+		auto start = std::chrono::steady_clock::now();
+		skeleton.connect(toleranceInput->value());
+		auto specs = skeleton.place(base, cell);
+		auto milliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+		auto builder = JointBuilder::create(design);
+		if (!builder)
+			return;
+
+		builder->parameters(JointParameters::mode(inputs, ARMATURE_JOINT_SKELETON_PARAMETERS_INPUT_ID));
+		builder->lean(leanInput->value());
+		auto failed = builder->build(specs);
+
+		char elapsed[32];
+		snprintf(elapsed, sizeof(elapsed), "%.1f", milliseconds);
+
+		auto message = "Placed " + std::to_string(specs.size()) + " joints at " + std::to_string(skeleton.junctions().size()) + " junctions in " + elapsed + " ms.";
+		if (builder->collapsed() > 0)
+			message += " Lean output left out " + std::to_string(builder->collapsed()) + " history items.";
+
+		if (!failed.empty())
+			message += "\n\nThese joints could not be generated:" + failed;
+
+		ui->messageBox(message, "Armature From Skeleton");
+	}
+}
@@ -0,0 +1,330 @@
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include <algorithm>
+#include <memory>
+#include <sstream>
+
+#include "Sweep.h"
+#include "Clamping.h"
+#include "Layout.h"
+#include "Parallel.h"
+#include "UI.h"
+#include "Validator.h"
+
+namespace ArmatureJoint {
+	namespace {
+		double mm(double centimetres) {
+			return Length::fromCentimetres(centimetres).millimetres();
+		}
+
+		const size_t batchSize = 4096;
+		const size_t frontCompaction = 1 << 16;
+
+		// The ratios Layout derives the seat geometry from, for a ball of radius 1.
+		const double ballOffsetRatio = 1 / 1.2;
+		const double ballInsetRatio = 1 / 1.25;
+		const double chamferRatio = 1.0 / 6.0;
+		const double seatGap = 0.05;
+		const double clearance = 1e-4;
+
+		struct Batch {
+			double length[batchSize];
+			double width[batchSize];
+			double thickness[batchSize];
+			double ballDiameter[batchSize];
+			double holeDiameter[batchSize];
+			double rows[batchSize];
+			double cols[batchSize];
+			double evenRows[batchSize]; // 1 for an even count, else 0
+			double evenCols[batchSize];
+			double material[batchSize];
+			double contactArea[batchSize];
+			double feasible[batchSize]; // 1 or 0, a double so the whole kernel keeps one vector width
+			ClampingBatch clamping;
+		};
+
+		struct Worker {
+			std::vector<SweepPoint> front;
+			std::vector<SweepEnvelope> envelope;
+			uint64_t feasible;
+
+			// Scratch reused by every batch the worker runs.
+			std::unique_ptr<Batch> batch;
+			std::vector<int> ballSteps;
+		};
+
+		// Keeps the points no other point beats on both material and contact area.
+		void paretoFront(std::vector<SweepPoint>& points) {
+			std::sort(points.begin(), points.end(), [](const SweepPoint& a, const SweepPoint& b) {
+				if (a.material != b.material)
+					return a.material < b.material;
+				return a.contactArea > b.contactArea;
+			});
+
+			std::vector<SweepPoint> front;
+			auto best = -HUGE_VAL;
+			for (auto& point : points) {
+				if (point.contactArea > best) {
+					front.push_back(point);
+					best = point.contactArea;
+				}
+			}
+			points.swap(front);
+		}
+
+		void decode(const SweepRanges& ranges, uint64_t index, int* step) {
+			int sizes[] = {
+				ranges.length.steps, ranges.width.steps, ranges.thickness.steps, ranges.holeDiameter.steps,
+				ranges.ballDiameter.steps, ranges.maxRows - ranges.minRows + 1, ranges.maxCols - ranges.minCols + 1
+			};
+			for (auto i = 0; i < 7; i++) {
+				step[i] = (int)(index % sizes[i]);
+				index /= sizes[i];
+			}
+		}
+
+		void evaluate(Batch& b, size_t n, double boltRadius, const ClampingSpec& clamping) {
+			auto boltArea = M_PI * boltRadius * boltRadius;
+			auto seatRatio = sqrt(1 - (ballOffsetRatio * ballOffsetRatio));
+			auto chamferSine = sin((45_deg).radians());
+
+			for (size_t i = 0; i < n; i++) {
+				auto rows = b.rows[i];
+				auto cols = b.cols[i];
+				auto r = b.ballDiameter[i] / 2;
+				auto seat = r * seatRatio;
+				auto chamfer = r * chamferRatio;
+				auto rowSize = b.width[i] / rows;
+				auto inset = r * ballInsetRatio;
+				auto single = std::max(2 - cols, 0.0); // 1 for a lone column, else 0
+				auto pitch = (b.length[i] - (2 * inset * (1 - single))) / std::max(cols - 1, 1.0); // a lone column spans the plate
+				auto balls = rows * cols;
+
+				// The bolt sits in the middle; the nearest seat is half a pitch away, or in line for an odd count.
+				auto boltDx = (single * ((b.length[i] / 2) - inset)) + (b.evenCols[i] * pitch / 2);
+				auto boltDy = b.evenRows[i] * rowSize / 2;
+				auto boltDistance = sqrt((boltDx * boltDx) + (boltDy * boltDy));
+
+				auto maxBall = 2 * sqrt(((rowSize + seatGap) * (rowSize + seatGap)) + (r * ballOffsetRatio * r * ballOffsetRatio));
+				auto minWidth = ((seat * 2) + seatGap) * rows;
+				auto minLength = std::max(minWidth, (2 * inset) + (((seat * 2) + seatGap) * (cols - 1)));
+				auto plateArea = (b.length[i] * b.width[i]) - boltArea - (balls * M_PI * seat * seat);
+
+				// Validator's rules, plus the minimum extents the dialog clamps to, so every point can be entered there.
+				b.feasible[i] =
+					((b.width[i] >= minWidth) &
+					(b.length[i] >= minLength) &
+					(b.ballDiameter[i] <= maxBall) &
+					(chamfer < b.thickness[i]) &
+					(b.holeDiameter[i] < b.ballDiameter[i]) &
+					(rowSize >= (2 * seat) + clearance) &
+					(pitch >= (2 * seat) + clearance) &
+					(boltDistance >= seat + boltRadius + clearance) &
+					(plateArea > 0)) ? 1.0 : 0.0;
+
+				b.material[i] = 2 * b.thickness[i] * plateArea;
+				b.contactArea[i] = 2 * balls * M_PI * ((2 * seat) + chamfer) * chamfer * M_SQRT2;
+
+				auto& c = b.clamping;
+				c.ballRadius[i] = r;
+				c.seatRadius[i] = seat;
+				c.chamferLength[i] = chamfer;
+				c.chamferSine[i] = chamferSine;
+				c.balls[i] = balls;
+				c.boltDiameter[i] = boltRadius * 2;
+				c.grip[i] = 2 * (b.thickness[i] + (r * ballOffsetRatio) - (chamfer / 1.25));
+			}
+
+			Clamping::evaluate(b.clamping, n, clamping);
+		}
+	}
+
+	double SweepAxis::at(int step) const {
+		if (steps <= 1)
+			return min;
+
+		return min + ((max - min) * step / (steps - 1));
+	}
+
+	uint64_t SweepRanges::count() const {
+		if (length.steps < 1 || width.steps < 1 || thickness.steps < 1 || ballDiameter.steps < 1 || holeDiameter.steps < 1 || maxRows < minRows || maxCols < minCols || minRows < 1 || minCols < 1)
+			return 0;
+
+		return (uint64_t)length.steps * width.steps * thickness.steps * ballDiameter.steps * holeDiameter.steps * (maxRows - minRows + 1) * (maxCols - minCols + 1);
+	}
+
+	SweepResult Sweep::run(const SweepRanges& ranges, int workers) {
+		SweepResult result;
+		result.evaluated = ranges.count();
+		result.feasible = 0;
+		if (result.evaluated == 0)
+			return result;
+
+		auto rowCount = ranges.maxRows - ranges.minRows + 1;
+		auto colCount = ranges.maxCols - ranges.minCols + 1;
+		auto envelopeSize = (size_t)ranges.ballDiameter.steps * rowCount * colCount;
+
+		SweepEnvelope empty = { 0, 0, 0, 0, HUGE_VAL, HUGE_VAL, HUGE_VAL, 0 };
+		std::vector<Worker> perWorker(Parallel::workers(workers));
+		for (auto& worker : perWorker) {
+			worker.envelope.assign(envelopeSize, empty);
+			worker.feasible = 0;
+		}
+
+		auto batches = (size_t)((result.evaluated + batchSize - 1) / batchSize);
+		Parallel::forEach(batches, [&](size_t batch, int w) {
+			auto& worker = perWorker[w];
+			if (!worker.batch)
+				worker.batch.reset(new Batch());
+			auto& b = worker.batch;
+
+			auto first = (uint64_t)batch * batchSize;
+			auto n = (size_t)std::min((uint64_t)batchSize, result.evaluated - first);
+
+			int step[7];
+			decode(ranges, first, step);
+
+			auto& ballSteps = worker.ballSteps;
+			ballSteps.resize(n);
+			for (size_t i = 0; i < n; i++) {
+				b->length[i] = ranges.length.at(step[0]);
+				b->width[i] = ranges.width.at(step[1]);
+				b->thickness[i] = ranges.thickness.at(step[2]);
+				b->holeDiameter[i] = ranges.holeDiameter.at(step[3]);
+				b->ballDiameter[i] = ranges.ballDiameter.at(step[4]);
+				auto rows = ranges.minRows + step[5];
+				auto cols = ranges.minCols + step[6];
+				b->rows[i] = rows;
+				b->cols[i] = cols;
+				b->evenRows[i] = (rows & 1) == 0;
+				b->evenCols[i] = (cols & 1) == 0;
+				ballSteps[i] = (step[4] * rowCount + step[5]) * colCount + step[6];
+
+				// Odometer increment, length fastest.
+				int sizes[] = { ranges.length.steps, ranges.width.steps, ranges.thickness.steps, ranges.holeDiameter.steps, ranges.ballDiameter.steps, rowCount, colCount };
+				for (auto d = 0; d < 7 && ++step[d] == sizes[d]; d++)
+					step[d] = 0;
+			}
+
+			evaluate(*b, n, ranges.boltHoleDiameter / 2, ranges.clamping);
+
+			for (size_t i = 0; i < n; i++) {
+				if (!b->feasible[i])
+					continue;
+
+				worker.feasible++;
+
+				SweepPoint point = { b->length[i], b->width[i], b->thickness[i], b->ballDiameter[i], b->holeDiameter[i], (int)b->rows[i], (int)b->cols[i], b->material[i], b->contactArea[i], b->clamping.tiltTorque[i] };
+				worker.front.push_back(point);
+
+				auto& envelope = worker.envelope[ballSteps[i]];
+				envelope.ballDiameter = point.ballDiameter;
+				envelope.rows = point.rows;
+				envelope.cols = point.cols;
+				envelope.feasible++;
+				envelope.minLength = std::min(envelope.minLength, point.length);
+				envelope.minWidth = std::min(envelope.minWidth, point.width);
+				envelope.minThickness = std::min(envelope.minThickness, point.thickness);
+				envelope.maxHoleDiameter = std::max(envelope.maxHoleDiameter, point.holeDiameter);
+			}
+
+			if (worker.front.size() > frontCompaction)
+				paretoFront(worker.front);
+		}, workers);
+
+		std::vector<SweepEnvelope> envelope(envelopeSize, empty);
+		for (auto& worker : perWorker) {
+			result.feasible += worker.feasible;
+			result.front.insert(result.front.end(), worker.front.begin(), worker.front.end());
+
+			for (size_t i = 0; i < envelopeSize; i++) {
+				auto& from = worker.envelope[i];
+				if (from.feasible == 0)
+					continue;
+
+				auto& to = envelope[i];
+				to.ballDiameter = from.ballDiameter;
+				to.rows = from.rows;
+				to.cols = from.cols;
+				to.feasible += from.feasible;
+				to.minLength = std::min(to.minLength, from.minLength);
+				to.minWidth = std::min(to.minWidth, from.minWidth);
+				to.minThickness = std::min(to.minThickness, from.minThickness);
+				to.maxHoleDiameter = std::max(to.maxHoleDiameter, from.maxHoleDiameter);
+			}
+		}
+
+		for (auto& entry : envelope) {
+			if (entry.feasible > 0)
+				result.envelope.push_back(entry);
+		}
+
+		paretoFront(result.front);
+
+		// The batch math mirrors Layout; the few front points are confirmed against the full validator.
+		std::vector<SweepPoint> confirmed;
+		for (auto& point : result.front) {
+			Layout layout(spec(point, ranges.boltHoleDiameter, ""));
+
+			std::string error;
+			if (Validator::validate(layout, error))
+				confirmed.push_back(point);
+		}
+		result.front.swap(confirmed);
+
+		return result;
+	}
+
+	JointSpec Sweep::spec(const SweepPoint& point, double boltHoleDiameter, const std::string& name) {
+		JointSpec spec;
+		spec.name = name;
+		spec.length = point.length;
+		spec.width = point.width;
+		spec.thickness = point.thickness;
+		spec.ballDiameter = point.ballDiameter;
+		spec.boltHoleDiameter = boltHoleDiameter;
+
+		JointCell ball = { ARMATURE_JOINT_OPTION_BALL, point.holeDiameter };
+		spec.resize(point.rows, point.cols, ball);
+		return spec;
+	}
+
+	// The front in the joint specification CSV format, in millimetres, so it can be generated with Armature Joints From File.
+	std::string Sweep::frontCsv(const SweepResult& result, double boltHoleDiameter) {
+		std::ostringstream csv;
+		csv << "name,units,length,width,thickness,ballDiameter,boltHoleDiameter,rows,cols,cells,material,contactArea,holdingTorque\n";
+
+		auto index = 1;
+		for (auto& point : result.front) {
+			std::string row;
+			for (auto c = 1; c <= point.cols; c++)
+				row += std::string(c > 1 ? ";" : "") + ARMATURE_JOINT_OPTION_BALL + ":" + std::to_string(mm(point.holeDiameter));
+
+			std::string cells;
+			for (auto r = 1; r <= point.rows; r++)
+				cells += (r > 1 ? "|" : "") + row;
+
+			csv << "Joint " << index++ << ",mm,"
+				<< mm(point.length) << "," << mm(point.width) << "," << mm(point.thickness) << ","
+				<< mm(point.ballDiameter) << "," << mm(boltHoleDiameter) << ","
+				<< point.rows << "," << point.cols << "," << cells << ","
+				<< point.material * 1000 << "," << point.contactArea * 100 << "," << point.holdingTorque * 1000 << "\n";
+		}
+
+		return csv.str();
+	}
+
+	std::string Sweep::envelopeCsv(const SweepResult& result) {
+		std::ostringstream csv;
+		csv << "ballDiameter,rows,cols,feasible,minLength,minWidth,minThickness,maxHoleDiameter\n";
+
+		for (auto& entry : result.envelope) {
+			csv << mm(entry.ballDiameter) << "," << entry.rows << "," << entry.cols << "," << entry.feasible << ","
+				<< mm(entry.minLength) << "," << mm(entry.minWidth) << "," << mm(entry.minThickness) << ","
+				<< mm(entry.maxHoleDiameter) << "\n";
+		}
+
+		return csv.str();
+	}
+}
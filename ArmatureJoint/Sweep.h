@@ -0,0 +1,81 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "Clamping.h"
+#include "JointSpec.h"
+
+namespace ArmatureJoint {
+	// Evenly spaced values from min to max inclusive.
+	struct SweepAxis {
+		double min;
+		double max;
+		int steps;
+
+		double at(int step) const;
+	};
+
+	struct SweepRanges {
+		SweepAxis length;
+		SweepAxis width;
+		SweepAxis thickness;
+		SweepAxis ballDiameter;
+		SweepAxis holeDiameter;
+		int minRows;
+		int maxRows;
+		int minCols;
+		int maxCols;
+		double boltHoleDiameter;
+		ClampingSpec clamping;
+
+		uint64_t count() const;
+	};
+
+	// One feasible all-ball joint with its metrics: plate material volume for both plates, clamping contact area,
+	// the 45 degree chamfer bands the balls are clamped against in both plates, and the tilt torque each ball holds.
+	struct SweepPoint {
+		double length;
+		double width;
+		double thickness;
+		double ballDiameter;
+		double holeDiameter;
+		int rows;
+		int cols;
+		double material;
+		double contactArea;
+		double holdingTorque;
+	};
+
+	// The smallest feasible plate for one ball diameter and grid.
+	struct SweepEnvelope {
+		double ballDiameter;
+		int rows;
+		int cols;
+		uint64_t feasible;
+		double minLength;
+		double minWidth;
+		double minThickness;
+		double maxHoleDiameter;
+	};
+
+	struct SweepResult {
+		uint64_t evaluated;
+		uint64_t feasible;
+		std::vector<SweepEnvelope> envelope;
+		std::vector<SweepPoint> front; // least material for the most contact area, by increasing material
+	};
+
+	// Evaluates every combination of the ranges for feasibility and metrics. Combinations are decoded into
+	// structure-of-arrays batches, and batches run on all cores. The feasibility loop is branch free and all doubles, so
+	// it vectorises when sqrt need not set errno and selects may evaluate both sides (-fno-math-errno -fno-trapping-math).
+	class Sweep {
+	public:
+		static SweepResult run(const SweepRanges& ranges, int workers = 0);
+
+		static JointSpec spec(const SweepPoint& point, double boltHoleDiameter, const std::string& name);
+		static std::string frontCsv(const SweepResult& result, double boltHoleDiameter);
+		static std::string envelopeCsv(const SweepResult& result);
+	};
+}
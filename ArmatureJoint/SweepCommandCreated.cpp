@@ -0,0 +1,108 @@
+#include "SweepCommandCreated.h"
+
+#include "Clamping.h"
+#include "JointSpec.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		// Adds minimum, maximum and step count inputs for one swept size.
+		bool addAxis(Ptr<CommandInputs> inputs, const std::string& id, const std::string& name, Length min, Length max, int steps) {
+			auto group = inputs->addGroupCommandInput(id, name);
+			if (!group)
+				return false;
+
+			auto children = group->children();
+			if (!children)
+				return false;
+
+			if (!children->addDistanceValueCommandInput(id + ARMATURE_JOINT_SWEEP_MIN_SUFFIX, "From", ValueInput::createByReal(min.centimetres())))
+				return false;
+
+			if (!children->addDistanceValueCommandInput(id + ARMATURE_JOINT_SWEEP_MAX_SUFFIX, "To", ValueInput::createByReal(max.centimetres())))
+				return false;
+
+			return children->addIntegerSpinnerCommandInput(id + ARMATURE_JOINT_SWEEP_STEPS_SUFFIX, "Steps", 1, 1000, 1, steps) != nullptr;
+		}
+
+		bool addCount(Ptr<CommandInputs> inputs, const std::string& id, const std::string& name, int min, int max, int limit) {
+			auto group = inputs->addGroupCommandInput(id, name);
+			if (!group)
+				return false;
+
+			auto children = group->children();
+			if (!children)
+				return false;
+
+			if (!children->addIntegerSpinnerCommandInput(id + ARMATURE_JOINT_SWEEP_MIN_SUFFIX, "From", 1, limit, 1, min))
+				return false;
+
+			return children->addIntegerSpinnerCommandInput(id + ARMATURE_JOINT_SWEEP_MAX_SUFFIX, "To", 1, limit, 1, max) != nullptr;
+		}
+	}
+
+	void SweepCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto inputs = cmd->commandInputs();
+		if (!inputs)
+			return;
+
+		if (!addAxis(inputs, ARMATURE_JOINT_SWEEP_LENGTH_INPUT_ID, "Length", 8_mm, 30_mm, 40))
+			return;
+
+		if (!addAxis(inputs, ARMATURE_JOINT_SWEEP_WIDTH_INPUT_ID, "Width", 3_mm, 20_mm, 40))
+			return;
+
+		if (!addAxis(inputs, ARMATURE_JOINT_SWEEP_THICKNESS_INPUT_ID, "Thickness", 0.5_mm, 4_mm, 12))
+			return;
+
+		if (!addAxis(inputs, ARMATURE_JOINT_SWEEP_BALL_DIAMETER_INPUT_ID, "Ball Diameter", 2_mm, 10_mm, 17))
+			return;
+
+		if (!addAxis(inputs, ARMATURE_JOINT_SWEEP_HOLE_DIAMETER_INPUT_ID, "Ball Hole Diameter", 1_mm, 4_mm, 4))
+			return;
+
+		if (!addCount(inputs, ARMATURE_JOINT_SWEEP_ROWS_INPUT_ID, "Rows", 1, 6, 100))
+			return;
+
+		if (!addCount(inputs, ARMATURE_JOINT_SWEEP_COLS_INPUT_ID, "Columns", 1, 4, 20))
+			return;
+
+		auto boltHoleInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_SWEEP_BOLT_HOLE_DIAMETER_INPUT_ID,
+			"Bolt Hole Diameter",
+			ValueInput::createByReal(Defaults::boltHoleDiameter.centimetres())
+		);
+		if (!boltHoleInput)
+			return;
+
+		auto clamping = ClampingSpec::defaults();
+		auto boltTorqueInput = inputs->addValueInput(ARMATURE_JOINT_SWEEP_BOLT_TORQUE_INPUT_ID, "Bolt Torque (N m)", "", ValueInput::createByReal(clamping.boltTorque));
+		if (!boltTorqueInput)
+			return;
+
+		boltTorqueInput->tooltip("How tightly the bolt is done up, for the holding torque of each joint on the front");
+
+		if (!inputs->addValueInput(ARMATURE_JOINT_SWEEP_FRICTION_INPUT_ID, "Seat Friction", "", ValueInput::createByReal(clamping.friction)))
+			return;
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "SweepCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class SweepCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<SweepCommandExecuted> _onExecute;
+
+	public:
+		SweepCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<SweepCommandExecuted>(new SweepCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
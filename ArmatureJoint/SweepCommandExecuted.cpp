@@ -0,0 +1,118 @@
+#include "SweepCommandExecuted.h"
+
+#include <chrono>
+#include <fstream>
+
+#include "Sweep.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		double distanceValue(Ptr<CommandInputs> inputs, const std::string& id) {
+			auto input = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(id));
+			return input ? input->value() : 0;
+		}
+
+		double realValue(Ptr<CommandInputs> inputs, const std::string& id) {
+			auto input = static_cast<Ptr<ValueCommandInput>>(inputs->itemById(id));
+			return input ? input->value() : 0;
+		}
+
+		int integerValue(Ptr<CommandInputs> inputs, const std::string& id) {
+			auto input = static_cast<Ptr<IntegerSpinnerCommandInput>>(inputs->itemById(id));
+			return input ? input->value() : 0;
+		}
+
+		SweepAxis axis(Ptr<CommandInputs> inputs, const std::string& id) {
+			SweepAxis axis = {
+				distanceValue(inputs, id + ARMATURE_JOINT_SWEEP_MIN_SUFFIX),
+				distanceValue(inputs, id + ARMATURE_JOINT_SWEEP_MAX_SUFFIX),
+				integerValue(inputs, id + ARMATURE_JOINT_SWEEP_STEPS_SUFFIX)
+			};
+			return axis;
+		}
+
+		bool write(const std::string& path, const std::string& text) {
+			std::ofstream file(path, std::ios::binary);
+			if (!file)
+				return false;
+
+			file << text;
+			return (bool)file;
+		}
+	}
+
+	void SweepCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto command = eventArgs->command();
+		if (!command)
+			return;
+
+		auto inputs = command->commandInputs();
+		if (!inputs)
+			return;
+
+		auto ui = app->userInterface();
+		if (!ui)
+			return;
+
+		SweepRanges ranges;
+		ranges.length = axis(inputs, ARMATURE_JOINT_SWEEP_LENGTH_INPUT_ID);
+		ranges.width = axis(inputs, ARMATURE_JOINT_SWEEP_WIDTH_INPUT_ID);
+		ranges.thickness = axis(inputs, ARMATURE_JOINT_SWEEP_THICKNESS_INPUT_ID);
+		ranges.ballDiameter = axis(inputs, ARMATURE_JOINT_SWEEP_BALL_DIAMETER_INPUT_ID);
+		ranges.holeDiameter = axis(inputs, ARMATURE_JOINT_SWEEP_HOLE_DIAMETER_INPUT_ID);
+		ranges.minRows = integerValue(inputs, std::string(ARMATURE_JOINT_SWEEP_ROWS_INPUT_ID) + ARMATURE_JOINT_SWEEP_MIN_SUFFIX);
+		ranges.maxRows = integerValue(inputs, std::string(ARMATURE_JOINT_SWEEP_ROWS_INPUT_ID) + ARMATURE_JOINT_SWEEP_MAX_SUFFIX);
+		ranges.minCols = integerValue(inputs, std::string(ARMATURE_JOINT_SWEEP_COLS_INPUT_ID) + ARMATURE_JOINT_SWEEP_MIN_SUFFIX);
+		ranges.maxCols = integerValue(inputs, std::string(ARMATURE_JOINT_SWEEP_COLS_INPUT_ID) + ARMATURE_JOINT_SWEEP_MAX_SUFFIX);
+		ranges.boltHoleDiameter = distanceValue(inputs, ARMATURE_JOINT_SWEEP_BOLT_HOLE_DIAMETER_INPUT_ID);
+		ranges.clamping = ClampingSpec::defaults();
+		ranges.clamping.boltTorque = realValue(inputs, ARMATURE_JOINT_SWEEP_BOLT_TORQUE_INPUT_ID);
+		ranges.clamping.friction = realValue(inputs, ARMATURE_JOINT_SWEEP_FRICTION_INPUT_ID);
+
+		if (ranges.count() == 0) {
+			ui->messageBox("The ranges are empty.", "Sweep Joint Sizes");
+			return;
+		}
+
+		auto fileDialog = ui->createFileDialog();
+		if (!fileDialog)
+			return;
+
+		fileDialog->title("Save Pareto Front");
+		fileDialog->filter(ARMATURE_JOINT_SWEEP_FILE_FILTER);
+
+		if (fileDialog->showSave() != DialogResults::DialogOK)
+			return;
+
+		auto start = std::chrono::steady_clock::now();
+		auto result = Sweep::run(ranges);
+		auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+		// The envelope goes next to the front, as name.envelope.csv.
+		auto frontPath = fileDialog->filename();
+		auto envelopePath = frontPath;
+		auto extension = envelopePath.rfind(".csv");
+		if (extension != std::string::npos && extension == envelopePath.size() - 4)
+			envelopePath.erase(extension);
+		envelopePath += ".envelope.csv";
+
+		if (!write(frontPath, Sweep::frontCsv(result, ranges.boltHoleDiameter)) || !write(envelopePath, Sweep::envelopeCsv(result))) {
+			ui->messageBox("Could not write " + frontPath, "Sweep Joint Sizes");
+			return;
+		}
+
+		char elapsed[32];
+		snprintf(elapsed, sizeof(elapsed), "%.2f", seconds);
+
+		ui->messageBox(
+			std::to_string(result.feasible) + " of " + std::to_string(result.evaluated) + " combinations are feasible (" + elapsed + " s).\n" +
+			std::to_string(result.front.size()) + " joints are on the Pareto front of plate material against clamping contact area.\n" +
+			std::to_string(result.envelope.size()) + " ball diameter and grid combinations have a feasible plate.",
+			"Sweep Joint Sizes"
+		);
+	}
+}
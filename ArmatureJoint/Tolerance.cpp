@@ -0,0 +1,186 @@
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include <algorithm>
+#include <memory>
+
+#include "Tolerance.h"
+#include "Parallel.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		const size_t batchSize = 1024;
+
+		uint64_t splitmix(uint64_t& state) {
+			auto z = (state += 0x9e3779b97f4a7c15ull);
+			z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+			z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+			return z ^ (z >> 31);
+		}
+
+		// Standard normal deviates by Box-Muller, from a stream seeded by batch so results do not depend on the thread count.
+		void normals(uint64_t& state, double* out, size_t n) {
+			for (size_t i = 0; i < n; i += 2) {
+				auto u = ((splitmix(state) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+				auto v = ((splitmix(state) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+				auto r = sqrt(-2 * log(u));
+				out[i] = r * cos(2 * M_PI * v);
+				if (i + 1 < n)
+					out[i + 1] = r * sin(2 * M_PI * v);
+			}
+		}
+
+		struct Seat {
+			double height[batchSize]; // ball centre above the plate face
+			double radius[batchSize]; // contact circle radius
+			double edge[batchSize]; // 1 or 0, a double so the seat loop keeps one vector width
+		};
+
+		// A ball in a 45 degree chamfer touches it where the ball's surface is at 45 degrees, radius/sqrt(2) from its axis.
+		// Bores too wide for that leave it on the bore edge, and too narrow on the face edge.
+		void seat(const double* ballRadius, const double* boreRadius, const double* chamfer, size_t n, Seat& out) {
+			for (size_t i = 0; i < n; i++) {
+				auto r = ballRadius[i];
+				auto c = boreRadius[i];
+				auto ch = chamfer[i];
+				auto k = r * M_SQRT1_2;
+				auto outer = c + ch;
+
+				auto onBore = k < c;
+				auto onFace = k > outer;
+
+				auto boreHeight = -ch + sqrt(std::max((r * r) - (c * c), 0.0));
+				auto faceHeight = sqrt(std::max((r * r) - (outer * outer), 0.0));
+				auto chamferHeight = -ch + (k - c) + k;
+
+				auto height = onFace ? faceHeight : chamferHeight;
+				auto radius = onFace ? outer : k;
+				out.height[i] = onBore ? boreHeight : height;
+				out.radius[i] = onBore ? c : radius;
+				out.edge[i] = (onBore | onFace) ? 1.0 : 0.0;
+			}
+		}
+
+		Distribution distribution(std::vector<double>& values) {
+			Distribution d = { 0, 0, 0, 0, 0, 0, 0 };
+			if (values.empty())
+				return d;
+
+			double sum = 0;
+			for (auto value : values)
+				sum += value;
+			d.mean = sum / values.size();
+
+			double squares = 0;
+			for (auto value : values)
+				squares += (value - d.mean) * (value - d.mean);
+			d.stddev = sqrt(squares / values.size());
+
+			auto at = [&](double fraction) {
+				auto index = (size_t)(fraction * (values.size() - 1));
+				std::nth_element(values.begin(), values.begin() + index, values.end());
+				return values[index];
+			};
+
+			d.min = *std::min_element(values.begin(), values.end());
+			d.max = *std::max_element(values.begin(), values.end());
+			d.p01 = at(0.01);
+			d.p50 = at(0.5);
+			d.p99 = at(0.99);
+			return d;
+		}
+	}
+
+	ToleranceReport Tolerance::analyse(const Layout& layout, const ToleranceSpec& spec, int workers) {
+		ToleranceReport report = {};
+		report.samples = std::max(spec.samples, 0);
+
+		auto ballCount = (size_t)layout.numJointTypes(ARMATURE_JOINT_OPTION_BALL);
+		if (ballCount == 0 || report.samples == 0)
+			return report;
+
+		auto samples = (size_t)report.samples;
+
+		std::vector<double> contact(samples), gap(samples), interference(samples);
+		std::vector<double> edge(samples);
+
+		auto batches = (samples + batchSize - 1) / batchSize;
+		Parallel::forEach(batches, [&](size_t batch, int) {
+			auto first = batch * batchSize;
+			auto n = std::min(batchSize, samples - first);
+			uint64_t state = spec.seed + (batch * 0x632be59bd9b4e019ull);
+
+			// Per sample: the plate thicknesses, then per ball its diameter and for each plate its bore, chamfer and x, y position.
+			std::vector<double> deviates(n);
+			auto sample = [&](double nominal, double tolerance, double* out) {
+				normals(state, deviates.data(), n);
+				for (size_t i = 0; i < n; i++)
+					out[i] = nominal + (deviates[i] * tolerance / 3);
+			};
+
+			std::vector<double> bottomThickness(n), topThickness(n);
+			sample(layout.thickness(), spec.thickness, bottomThickness.data());
+			sample(layout.thickness(), spec.thickness, topThickness.data());
+
+			std::vector<double> ballRadius(n), bore(n), chamfer(n), x(n), y(n), bottomX(n), bottomY(n);
+			std::vector<double> tallest(n, -HUGE_VAL), shortest(n, HUGE_VAL), smallest(n, HUGE_VAL);
+			std::vector<double> edges(n, 0);
+			std::unique_ptr<Seat> bottom(new Seat()), top(new Seat());
+
+			for (size_t b = 0; b < ballCount; b++) {
+				sample(layout.ballDiameter(), spec.ballDiameter, ballRadius.data());
+				for (size_t i = 0; i < n; i++)
+					ballRadius[i] /= 2;
+
+				// The ball centres itself in the bottom seat, so only the top seat's offset from it matters.
+				sample(layout.circleRadius() * 2, spec.seatDiameter, bore.data());
+				sample(layout.chamferLength(), spec.chamferLength, chamfer.data());
+				sample(0, spec.position, bottomX.data());
+				sample(0, spec.position, bottomY.data());
+				for (size_t i = 0; i < n; i++) {
+					bore[i] = std::max(bore[i] / 2, 0.0);
+					chamfer[i] = std::min(std::max(chamfer[i], 0.0), bottomThickness[i]);
+				}
+				seat(ballRadius.data(), bore.data(), chamfer.data(), n, *bottom);
+
+				sample(layout.circleRadius() * 2, spec.seatDiameter, bore.data());
+				sample(layout.chamferLength(), spec.chamferLength, chamfer.data());
+				sample(0, spec.position, x.data());
+				sample(0, spec.position, y.data());
+				// A seat offset sideways from the ball by e bears on its near side, which is the same as a bore e narrower.
+				for (size_t i = 0; i < n; i++) {
+					auto offset = sqrt(((x[i] - bottomX[i]) * (x[i] - bottomX[i])) + ((y[i] - bottomY[i]) * (y[i] - bottomY[i])));
+					bore[i] = std::max((bore[i] / 2) - offset, 0.0);
+					chamfer[i] = std::min(std::max(chamfer[i], 0.0), topThickness[i]);
+				}
+				seat(ballRadius.data(), bore.data(), chamfer.data(), n, *top);
+
+				for (size_t i = 0; i < n; i++) {
+					auto height = bottom->height[i] + top->height[i];
+					tallest[i] = std::max(tallest[i], height);
+					shortest[i] = std::min(shortest[i], height);
+					smallest[i] = std::min(smallest[i], std::min(bottom->radius[i], top->radius[i]));
+					edges[i] = std::max(edges[i], std::max(bottom->edge[i], top->edge[i]));
+				}
+			}
+
+			for (size_t i = 0; i < n; i++) {
+				contact[first + i] = smallest[i];
+				gap[first + i] = tallest[i];
+				interference[first + i] = tallest[i] - shortest[i];
+				edge[first + i] = edges[i];
+			}
+		}, workers);
+
+		double edgeCount = 0;
+		for (auto flag : edge)
+			edgeCount += flag;
+
+		report.contactRadius = distribution(contact);
+		report.gap = distribution(gap);
+		report.interference = distribution(interference);
+		report.edgeContact = edgeCount / samples;
+		return report;
+	}
+}
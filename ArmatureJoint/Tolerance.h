@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "Layout.h"
+
+namespace ArmatureJoint {
+	// Manufacturing tolerances, each a symmetric limit taken as three standard deviations of a normal distribution.
+	// Position is per axis, between the seat in each plate and its nominal place.
+	struct ToleranceSpec {
+		double ballDiameter;
+		double thickness;
+		double seatDiameter;
+		double chamferLength;
+		double position;
+		int samples;
+		uint64_t seed;
+	};
+
+	struct Distribution {
+		double mean;
+		double stddev;
+		double min;
+		double p01;
+		double p50;
+		double p99;
+		double max;
+	};
+
+	// How one joint's seats come out across the samples. The plates rest on whichever balls stand tallest:
+	// gap is the distance between the plate faces then, and interference how much the tallest ball must be
+	// squeezed before the shortest is clamped too. Contact radius is the smallest seat contact circle of a sample.
+	struct ToleranceReport {
+		int samples;
+		Distribution contactRadius;
+		Distribution gap;
+		Distribution interference;
+		double edgeContact; // fraction of samples where a ball bears on a seat edge instead of its chamfer
+	};
+
+	class Tolerance {
+	public:
+		static ToleranceReport analyse(const Layout& layout, const ToleranceSpec& spec, int workers = 0);
+	};
+}
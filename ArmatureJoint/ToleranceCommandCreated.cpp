@@ -0,0 +1,66 @@
+#include "ToleranceCommandCreated.h"
+
+#include "UI.h"
+#include "Units.h"
+
+namespace ArmatureJoint {
+	namespace {
+		bool addTolerance(Ptr<CommandInputs> inputs, const std::string& id, const std::string& name, const std::string& tooltip) {
+			auto input = inputs->addDistanceValueCommandInput(
+				id,
+				name,
+				ValueInput::createByReal((0.02_mm).centimetres())
+			);
+			if (!input)
+				return false;
+
+			input->tooltip(tooltip + ", plus or minus. Taken as three standard deviations.");
+			return true;
+		}
+	}
+
+	void ToleranceCommandCreated::notify(const Ptr<CommandCreatedEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto cmd = eventArgs->command();
+		if (!cmd)
+			return;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto inputs = cmd->commandInputs();
+		if (!inputs)
+			return;
+
+		if (!addTolerance(inputs, ARMATURE_JOINT_TOLERANCE_BALL_DIAMETER_INPUT_ID, "Ball Diameter Tolerance", "Tolerance on the ball diameter"))
+			return;
+
+		if (!addTolerance(inputs, ARMATURE_JOINT_TOLERANCE_THICKNESS_INPUT_ID, "Plate Thickness Tolerance", "Tolerance on the plate stock thickness"))
+			return;
+
+		if (!addTolerance(inputs, ARMATURE_JOINT_TOLERANCE_SEAT_DIAMETER_INPUT_ID, "Seat Diameter Tolerance", "Tolerance on the seat hole diameter"))
+			return;
+
+		if (!addTolerance(inputs, ARMATURE_JOINT_TOLERANCE_CHAMFER_INPUT_ID, "Chamfer Length Tolerance", "Tolerance on the seat chamfer length"))
+			return;
+
+		if (!addTolerance(inputs, ARMATURE_JOINT_TOLERANCE_POSITION_INPUT_ID, "Seat Position Tolerance", "Tolerance on each seat's position, per axis"))
+			return;
+
+		auto samplesInput = inputs->addIntegerSpinnerCommandInput(ARMATURE_JOINT_TOLERANCE_SAMPLES_INPUT_ID, "Samples", 1000, 10000000, 1000, 100000);
+		if (!samplesInput)
+			return;
+
+		auto onExec = cmd->execute();
+		if (!onExec)
+			return;
+		onExec->add(_onExecute.get());
+	}
+}
@@ -0,0 +1,19 @@
+#pragma once
+
+#include "ToleranceCommandExecuted.h"
+
+namespace ArmatureJoint {
+	class ToleranceCommandCreated : public CommandCreatedEventHandler {
+	private:
+		Ptr<Application> app;
+		unique_ptr<ToleranceCommandExecuted> _onExecute;
+
+	public:
+		ToleranceCommandCreated(Ptr<Application> _app) {
+			app = _app;
+			_onExecute = unique_ptr<ToleranceCommandExecuted>(new ToleranceCommandExecuted(app));
+		}
+
+		void notify(const Ptr<CommandCreatedEventArgs>& eventArgs) override;
+	};
+}
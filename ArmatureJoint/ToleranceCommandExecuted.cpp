@@ -0,0 +1,97 @@
+#include "ToleranceCommandExecuted.h"
+
+#include "JointAttributes.h"
+#include "Tolerance.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		const size_t maxReported = 25;
+
+		double distanceValue(Ptr<CommandInputs> inputs, const char* id) {
+			auto input = static_cast<Ptr<DistanceValueCommandInput>>(inputs->itemById(id));
+			return input ? input->value() : 0;
+		}
+
+		std::string range(Ptr<UnitsManager> unitsManager, const Distribution& distribution) {
+			return unitsManager->formatInternalValue(distribution.p01) + " to " + unitsManager->formatInternalValue(distribution.p99);
+		}
+	}
+
+	void ToleranceCommandExecuted::notify(const Ptr<CommandEventArgs>& eventArgs) {
+		if (!eventArgs)
+			return;
+
+		auto command = eventArgs->command();
+		if (!command)
+			return;
+
+		auto inputs = command->commandInputs();
+		if (!inputs)
+			return;
+
+		auto samplesInput = static_cast<Ptr<IntegerSpinnerCommandInput>>(inputs->itemById(ARMATURE_JOINT_TOLERANCE_SAMPLES_INPUT_ID));
+		if (!samplesInput)
+			return;
+
+		ToleranceSpec spec;
+		spec.ballDiameter = distanceValue(inputs, ARMATURE_JOINT_TOLERANCE_BALL_DIAMETER_INPUT_ID);
+		spec.thickness = distanceValue(inputs, ARMATURE_JOINT_TOLERANCE_THICKNESS_INPUT_ID);
+		spec.seatDiameter = distanceValue(inputs, ARMATURE_JOINT_TOLERANCE_SEAT_DIAMETER_INPUT_ID);
+		spec.chamferLength = distanceValue(inputs, ARMATURE_JOINT_TOLERANCE_CHAMFER_INPUT_ID);
+		spec.position = distanceValue(inputs, ARMATURE_JOINT_TOLERANCE_POSITION_INPUT_ID);
+		spec.samples = samplesInput->value();
+		spec.seed = 1;
+
+		auto prod = app->activeProduct();
+		if (!prod)
+			return;
+
+		auto design = static_cast<Ptr<Design>>(prod);
+		if (!design)
+			return;
+
+		auto unitsManager = design->unitsManager();
+		if (!unitsManager)
+			return;
+
+		auto ui = app->userInterface();
+		if (!ui)
+			return;
+
+		auto joints = JointAttributes::joints(design);
+		if (joints.empty()) {
+			ui->messageBox("There are no armature joints in the design.", "Joint Tolerances");
+			return;
+		}
+
+		// Every joint gets the same seed, so identical joints report identical distributions.
+		std::string report;
+		size_t reported = 0;
+		for (auto& component : joints) {
+			JointSpec jointSpec;
+			if (!JointAttributes::readSpec(component, jointSpec))
+				continue;
+
+			if (reported++ == maxReported) {
+				report += "\n\n... and more joints";
+				break;
+			}
+
+			Layout layout(jointSpec);
+			auto result = Tolerance::analyse(layout, spec);
+			if (result.samples == 0 || layout.numJointTypes(ARMATURE_JOINT_OPTION_BALL) == 0) {
+				report += "\n\n" + jointSpec.name + ": no balls";
+				continue;
+			}
+
+			report += "\n\n" + jointSpec.name + " (1st to 99th percentile)";
+			report += "\nContact radius: " + range(unitsManager, result.contactRadius);
+			report += "\nPlate gap: " + range(unitsManager, result.gap);
+			report += "\nInterference: " + range(unitsManager, result.interference);
+			report += "\nBearing on a seat edge: " + std::to_string((int)((result.edgeContact * 100) + 0.5)) + "%";
+		}
+
+		ui->messageBox(std::to_string(spec.samples) + " samples per joint." + report, "Joint Tolerances");
+	}
+}
@@ -1,15 +1,103 @@
-#pragma once
-
-#define ARMATURE_JOINT_COMMAND_LENGTH_INPUT_ID "armatureJointLengthInputID"
-#define ARMATURE_JOINT_COMMAND_WIDTH_INPUT_ID "armatureJointWidthInputID"
-#define ARMATURE_JOINT_COMMAND_PLATE_THICKNESS_INPUT_ID "armatureJointPlateThicknesshInputID"
-#define ARMATURE_JOINT_COMMAND_BALL_DIAMETER_INPUT_ID "armatureJointBallDiameterInputID"
-#define ARMATURE_JOINT_COMMAND_BOLT_HOLE_DIAMETER_INPUT_ID "armatureJointBoltHoleDiameterInputID"
-#define ARMATURE_JOINT_COMMAND_ROWS_INPUT_ID "armatureJointRowsInputID"
-#define ARMATURE_JOINT_COMMAND_COLS_INPUT_ID "armatureJointColsInputID"
-#define ARMATURE_JOINT_COMMAND_TABLE_INPUT_ID "armatureJointTableInputID"
-#define ARMATURE_JOINT_COMMAND_NAME_INPUT_ID "armatureJointNameInputID"
-
-#define ARMATURE_JOINT_OPTION_BALL "Ball"
-#define ARMATURE_JOINT_OPTION_NUT "Nut"
-#define ARMATURE_JOINT_OPTION_NONE "None"
\ No newline at end of file
+#pragma once
+
+#define ARMATURE_JOINT_COMMAND_LENGTH_INPUT_ID "armatureJointLengthInputID"
+#define ARMATURE_JOINT_COMMAND_WIDTH_INPUT_ID "armatureJointWidthInputID"
+#define ARMATURE_JOINT_COMMAND_PLATE_THICKNESS_INPUT_ID "armatureJointPlateThicknesshInputID"
+#define ARMATURE_JOINT_COMMAND_BALL_DIAMETER_INPUT_ID "armatureJointBallDiameterInputID"
+#define ARMATURE_JOINT_COMMAND_BOLT_HOLE_DIAMETER_INPUT_ID "armatureJointBoltHoleDiameterInputID"
+#define ARMATURE_JOINT_COMMAND_ROWS_INPUT_ID "armatureJointRowsInputID"
+#define ARMATURE_JOINT_COMMAND_COLS_INPUT_ID "armatureJointColsInputID"
+#define ARMATURE_JOINT_COMMAND_TABLE_INPUT_ID "armatureJointTableInputID"
+#define ARMATURE_JOINT_COMMAND_NAME_INPUT_ID "armatureJointNameInputID"
+#define ARMATURE_JOINT_COMMAND_ERROR_INPUT_ID "armatureJointErrorInputID"
+#define ARMATURE_JOINT_COMMAND_PRESET_GROUP_INPUT_ID "armatureJointPresetGroupInputID"
+#define ARMATURE_JOINT_COMMAND_PRESET_INPUT_ID "armatureJointPresetInputID"
+#define ARMATURE_JOINT_COMMAND_PARAMETERS_INPUT_ID "armatureJointParametersInputID"
+#define ARMATURE_JOINT_COMMAND_LEAN_INPUT_ID "armatureJointLeanInputID"
+
+#define ARMATURE_JOINT_OPTION_BALL "Ball"
+#define ARMATURE_JOINT_OPTION_NUT "Nut"
+#define ARMATURE_JOINT_OPTION_NONE "None"
+
+#define ARMATURE_JOINT_PARAMETERS_OPTION_NONE "None"
+#define ARMATURE_JOINT_PARAMETERS_OPTION_JOINT "Per Joint"
+#define ARMATURE_JOINT_PARAMETERS_OPTION_SHARED "Shared"
+
+#define ARMATURE_JOINT_BATCH_FILE_FILTER "Joint Specifications (*.armature *.json *.csv);;Armature (*.armature);;JSON (*.json);;CSV (*.csv)"
+
+#define ARMATURE_JOINT_EDIT_SELECTION_INPUT_ID "armatureJointEditSelectionInputID"
+
+#define ARMATURE_JOINT_BULK_SUMMARY_INPUT_ID "armatureJointBulkSummaryInputID"
+#define ARMATURE_JOINT_BULK_MATCH_BALL_INPUT_ID "armatureJointBulkMatchBallInputID"
+#define ARMATURE_JOINT_BULK_MATCH_BALL_DIAMETER_INPUT_ID "armatureJointBulkMatchBallDiameterInputID"
+#define ARMATURE_JOINT_BULK_CHANGE_BALL_INPUT_ID "armatureJointBulkChangeBallInputID"
+#define ARMATURE_JOINT_BULK_BALL_DIAMETER_INPUT_ID "armatureJointBulkBallDiameterInputID"
+#define ARMATURE_JOINT_BULK_CHANGE_THICKNESS_INPUT_ID "armatureJointBulkChangeThicknessInputID"
+#define ARMATURE_JOINT_BULK_THICKNESS_INPUT_ID "armatureJointBulkThicknessInputID"
+#define ARMATURE_JOINT_BULK_CHANGE_BOLT_HOLE_INPUT_ID "armatureJointBulkChangeBoltHoleInputID"
+#define ARMATURE_JOINT_BULK_BOLT_HOLE_DIAMETER_INPUT_ID "armatureJointBulkBoltHoleDiameterInputID"
+#define ARMATURE_JOINT_BULK_CHANGE_HOLE_INPUT_ID "armatureJointBulkChangeHoleInputID"
+#define ARMATURE_JOINT_BULK_HOLE_DIAMETER_INPUT_ID "armatureJointBulkHoleDiameterInputID"
+
+#define ARMATURE_JOINT_INTERFERENCE_MARGIN_INPUT_ID "armatureJointInterferenceMarginInputID"
+#define ARMATURE_JOINT_INTERFERENCE_RANGE_INPUT_ID "armatureJointInterferenceRangeInputID"
+
+#define ARMATURE_JOINT_SWEEP_LENGTH_INPUT_ID "armatureJointSweepLength"
+#define ARMATURE_JOINT_SWEEP_WIDTH_INPUT_ID "armatureJointSweepWidth"
+#define ARMATURE_JOINT_SWEEP_THICKNESS_INPUT_ID "armatureJointSweepThickness"
+#define ARMATURE_JOINT_SWEEP_BALL_DIAMETER_INPUT_ID "armatureJointSweepBallDiameter"
+#define ARMATURE_JOINT_SWEEP_HOLE_DIAMETER_INPUT_ID "armatureJointSweepHoleDiameter"
+#define ARMATURE_JOINT_SWEEP_ROWS_INPUT_ID "armatureJointSweepRows"
+#define ARMATURE_JOINT_SWEEP_COLS_INPUT_ID "armatureJointSweepCols"
+#define ARMATURE_JOINT_SWEEP_MIN_SUFFIX "MinInputID"
+#define ARMATURE_JOINT_SWEEP_MAX_SUFFIX "MaxInputID"
+#define ARMATURE_JOINT_SWEEP_STEPS_SUFFIX "StepsInputID"
+#define ARMATURE_JOINT_SWEEP_BOLT_HOLE_DIAMETER_INPUT_ID "armatureJointSweepBoltHoleDiameterInputID"
+#define ARMATURE_JOINT_SWEEP_BOLT_TORQUE_INPUT_ID "armatureJointSweepBoltTorqueInputID"
+#define ARMATURE_JOINT_SWEEP_FRICTION_INPUT_ID "armatureJointSweepFrictionInputID"
+#define ARMATURE_JOINT_SWEEP_FILE_FILTER "CSV (*.csv)"
+
+#define ARMATURE_JOINT_TOLERANCE_BALL_DIAMETER_INPUT_ID "armatureJointToleranceBallDiameterInputID"
+#define ARMATURE_JOINT_TOLERANCE_THICKNESS_INPUT_ID "armatureJointToleranceThicknessInputID"
+#define ARMATURE_JOINT_TOLERANCE_SEAT_DIAMETER_INPUT_ID "armatureJointToleranceSeatDiameterInputID"
+#define ARMATURE_JOINT_TOLERANCE_CHAMFER_INPUT_ID "armatureJointToleranceChamferInputID"
+#define ARMATURE_JOINT_TOLERANCE_POSITION_INPUT_ID "armatureJointTolerancePositionInputID"
+#define ARMATURE_JOINT_TOLERANCE_SAMPLES_INPUT_ID "armatureJointToleranceSamplesInputID"
+
+#define ARMATURE_JOINT_MASS_PLATE_DENSITY_INPUT_ID "armatureJointMassPlateDensityInputID"
+#define ARMATURE_JOINT_MASS_BALL_DENSITY_INPUT_ID "armatureJointMassBallDensityInputID"
+#define ARMATURE_JOINT_MASS_NUT_DENSITY_INPUT_ID "armatureJointMassNutDensityInputID"
+
+#define ARMATURE_JOINT_HOLDING_BOLT_TORQUE_INPUT_ID "armatureJointHoldingBoltTorqueInputID"
+#define ARMATURE_JOINT_HOLDING_FRICTION_INPUT_ID "armatureJointHoldingFrictionInputID"
+#define ARMATURE_JOINT_HOLDING_PUPPET_MASS_INPUT_ID "armatureJointHoldingPuppetMassInputID"
+
+#define ARMATURE_JOINT_MOTION_MIN_CONE_INPUT_ID "armatureJointMotionMinConeInputID"
+
+#define ARMATURE_JOINT_EXPORT_TOLERANCE_INPUT_ID "armatureJointExportToleranceInputID"
+#define ARMATURE_JOINT_EXPORT_FILE_FILTER "STL (*.stl);;3MF (*.3mf)"
+
+#define ARMATURE_JOINT_DXF_SHEET_WIDTH_INPUT_ID "armatureJointDxfSheetWidthInputID"
+#define ARMATURE_JOINT_DXF_SHEET_HEIGHT_INPUT_ID "armatureJointDxfSheetHeightInputID"
+#define ARMATURE_JOINT_DXF_SPACING_INPUT_ID "armatureJointDxfSpacingInputID"
+#define ARMATURE_JOINT_DXF_ROTATE_INPUT_ID "armatureJointDxfRotateInputID"
+#define ARMATURE_JOINT_DXF_FILE_FILTER "DXF (*.dxf)"
+
+#define ARMATURE_JOINT_MACHINE_SHEET_WIDTH_INPUT_ID "armatureJointMachineSheetWidthInputID"
+#define ARMATURE_JOINT_MACHINE_SHEET_HEIGHT_INPUT_ID "armatureJointMachineSheetHeightInputID"
+#define ARMATURE_JOINT_MACHINE_SPACING_INPUT_ID "armatureJointMachineSpacingInputID"
+#define ARMATURE_JOINT_MACHINE_ROTATE_INPUT_ID "armatureJointMachineRotateInputID"
+#define ARMATURE_JOINT_MACHINE_GENERATE_INPUT_ID "armatureJointMachineGenerateInputID"
+#define ARMATURE_JOINT_MACHINE_FILE_FILTER "CAM Templates (*.f3dhsm-template)"
+
+#define ARMATURE_JOINT_SAVE_FILE_FILTER "Armature (*.armature);;JSON (*.json);;CSV (*.csv)"
+
+#define ARMATURE_JOINT_SKELETON_BONES_INPUT_ID "armatureJointSkeletonBonesInputID"
+#define ARMATURE_JOINT_SKELETON_BVH_INPUT_ID "armatureJointSkeletonBvhInputID"
+#define ARMATURE_JOINT_SKELETON_BVH_UNIT_INPUT_ID "armatureJointSkeletonBvhUnitInputID"
+#define ARMATURE_JOINT_SKELETON_TOLERANCE_INPUT_ID "armatureJointSkeletonToleranceInputID"
+#define ARMATURE_JOINT_SKELETON_BALL_DIAMETER_INPUT_ID "armatureJointSkeletonBallDiameterInputID"
+#define ARMATURE_JOINT_SKELETON_THICKNESS_INPUT_ID "armatureJointSkeletonThicknessInputID"
+#define ARMATURE_JOINT_SKELETON_PARAMETERS_INPUT_ID "armatureJointSkeletonParametersInputID"
+#define ARMATURE_JOINT_SKELETON_LEAN_INPUT_ID "armatureJointSkeletonLeanInputID"
+#define ARMATURE_JOINT_SKELETON_FILE_FILTER "BVH (*.bvh)"
@@ -0,0 +1,78 @@
+#pragma once
+
+namespace ArmatureJoint {
+	// A length whose unit is part of its type. It is held in centimetres, the API's internal length unit, so values
+	// pass to and from Fusion unchanged and literals such as 15_mm fold at compile time.
+	class Length {
+	public:
+		constexpr Length() : cm(0) {}
+
+		static constexpr Length fromCentimetres(double value) { return Length(value); }
+		static constexpr Length fromMillimetres(double value) { return Length(value / 10); }
+		static constexpr Length fromInches(double value) { return Length(value * 2.54); }
+
+		constexpr double centimetres() const { return cm; }
+		constexpr double millimetres() const { return cm * 10; }
+		constexpr double inches() const { return cm / 2.54; }
+		constexpr double metres() const { return cm / 100; }
+
+		constexpr Length operator+(Length l) const { return Length(cm + l.cm); }
+		constexpr Length operator-(Length l) const { return Length(cm - l.cm); }
+		constexpr Length operator-() const { return Length(-cm); }
+		constexpr Length operator*(double s) const { return Length(cm * s); }
+		constexpr Length operator/(double s) const { return Length(cm / s); }
+		constexpr double operator/(Length l) const { return cm / l.cm; }
+
+		constexpr bool operator<(Length l) const { return cm < l.cm; }
+		constexpr bool operator>(Length l) const { return cm > l.cm; }
+		constexpr bool operator<=(Length l) const { return cm <= l.cm; }
+		constexpr bool operator>=(Length l) const { return cm >= l.cm; }
+		constexpr bool operator==(Length l) const { return cm == l.cm; }
+		constexpr bool operator!=(Length l) const { return cm != l.cm; }
+
+	private:
+		constexpr explicit Length(double centimetres) : cm(centimetres) {}
+
+		double cm;
+	};
+
+	constexpr Length operator*(double s, Length l) { return l * s; }
+
+	// An angle held in radians, the API's internal angle unit.
+	class Angle {
+	public:
+		constexpr Angle() : rad(0) {}
+
+		static constexpr Angle fromRadians(double value) { return Angle(value); }
+		static constexpr Angle fromDegrees(double value) { return Angle(value * pi / 180); }
+
+		constexpr double radians() const { return rad; }
+		constexpr double degrees() const { return rad * 180 / pi; }
+
+		constexpr Angle operator+(Angle a) const { return Angle(rad + a.rad); }
+		constexpr Angle operator-(Angle a) const { return Angle(rad - a.rad); }
+		constexpr Angle operator*(double s) const { return Angle(rad * s); }
+		constexpr Angle operator/(double s) const { return Angle(rad / s); }
+
+		constexpr bool operator<(Angle a) const { return rad < a.rad; }
+		constexpr bool operator>(Angle a) const { return rad > a.rad; }
+		constexpr bool operator==(Angle a) const { return rad == a.rad; }
+		constexpr bool operator!=(Angle a) const { return rad != a.rad; }
+
+	private:
+		static constexpr double pi = 3.14159265358979323846;
+
+		constexpr explicit Angle(double radians) : rad(radians) {}
+
+		double rad;
+	};
+
+	constexpr Length operator"" _cm(long double value) { return Length::fromCentimetres((double)value); }
+	constexpr Length operator"" _cm(unsigned long long value) { return Length::fromCentimetres((double)value); }
+	constexpr Length operator"" _mm(long double value) { return Length::fromMillimetres((double)value); }
+	constexpr Length operator"" _mm(unsigned long long value) { return Length::fromMillimetres((double)value); }
+	constexpr Length operator"" _in(long double value) { return Length::fromInches((double)value); }
+	constexpr Length operator"" _in(unsigned long long value) { return Length::fromInches((double)value); }
+	constexpr Angle operator"" _deg(long double value) { return Angle::fromDegrees((double)value); }
+	constexpr Angle operator"" _deg(unsigned long long value) { return Angle::fromDegrees((double)value); }
+}
@@ -0,0 +1,211 @@
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <algorithm>
+
+#include "Validator.h"
+#include "UI.h"
+
+namespace ArmatureJoint {
+	namespace {
+		const double clearance = 1e-4;
+
+		std::string cellName(int row, int col) {
+			return "row " + std::to_string(row) + ", column " + std::to_string(col);
+		}
+
+		// False for NaN and infinity as well as for zero and below.
+		bool positive(double value) {
+			return value > 0 && isfinite(value);
+		}
+
+		double distance(double x1, double y1, double x2, double y2) {
+			return sqrt(pow(x2 - x1, 2) + pow(y2 - y1, 2));
+		}
+
+		// Half the across-corners size of the hex nut, along the nut row.
+		double nutHalfSpan(const Layout& layout) {
+			return 2 * layout.ballOffset() * tan(M_PI / 6);
+		}
+	}
+
+	bool Validator::validate(const Layout& layout, std::string& error) {
+		return
+			validateSizes(layout, error) &&
+			validateSeats(layout, error) &&
+			validateHoles(layout, error) &&
+			validateNuts(layout, error) &&
+			validateShafts(layout, error);
+	}
+
+	bool Validator::validateSizes(const Layout& layout, std::string& error) {
+		if (layout.rows() < 1 || layout.cols() < 1) {
+			error = "The joint needs at least one row and one column.";
+			return false;
+		}
+
+		if (!positive(layout.length()) || !positive(layout.width()) || !positive(layout.thickness()) || !positive(layout.ballDiameter()) || !positive(layout.boltHoleDiameter())) {
+			error = "Lengths, widths, thicknesses and diameters must be positive.";
+			return false;
+		}
+
+		if (layout.chamferLength() >= layout.thickness()) {
+			error = "The ball seat chamfer is deeper than the plate is thick. Use a thicker plate or a smaller ball.";
+			return false;
+		}
+
+		if (!positive(layout.expectedArea())) {
+			error = "The holes take up the whole plate.";
+			return false;
+		}
+
+		return true;
+	}
+
+	// Ball seats must stay inside the plate, clear of each other and of the bolt hole.
+	bool Validator::validateSeats(const Layout& layout, std::string& error) {
+		auto seat = layout.circleRadius();
+		auto boltX = layout.length() / 2;
+		auto boltY = -layout.width() / 2;
+		auto bolt = layout.boltHoleRadius();
+
+		for (auto row = 1; row <= layout.rows(); row++) {
+			for (auto col = 1; col <= layout.cols(); col++) {
+				if (layout.jointType(row, col) != ARMATURE_JOINT_OPTION_BALL)
+					continue;
+
+				auto x = layout.ballX(col);
+				auto y = layout.ballY(row);
+
+				if (x - seat < 0 || x + seat > layout.length() || y + seat > 0 || y - seat < -layout.width()) {
+					error = "The ball seat at " + cellName(row, col) + " runs off the edge of the plate.";
+					return false;
+				}
+
+				if (distance(x, y, boltX, boltY) < seat + bolt + clearance) {
+					error = "The ball seat at " + cellName(row, col) + " overlaps the bolt hole.";
+					return false;
+				}
+
+				// Only the neighbours below and to the right need checking, the others were checked from their side.
+				if (row < layout.rows() && layout.jointType(row + 1, col) == ARMATURE_JOINT_OPTION_BALL &&
+					distance(x, y, x, layout.ballY(row + 1)) < (2 * seat) + clearance) {
+					error = "The ball seats at " + cellName(row, col) + " and " + cellName(row + 1, col) + " overlap.";
+					return false;
+				}
+
+				if (col < layout.cols() && layout.jointType(row, col + 1) == ARMATURE_JOINT_OPTION_BALL &&
+					distance(x, y, layout.ballX(col + 1), y) < (2 * seat) + clearance) {
+					error = "The ball seats at " + cellName(row, col) + " and " + cellName(row, col + 1) + " overlap.";
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool Validator::validateHoles(const Layout& layout, std::string& error) {
+		for (auto row = 1; row <= layout.rows(); row++) {
+			for (auto col = 1; col <= layout.cols(); col++) {
+				if (layout.jointType(row, col) != ARMATURE_JOINT_OPTION_BALL)
+					continue;
+
+				auto hole = layout.holeDiameter(row, col);
+				if (!positive(hole)) {
+					error = "The ball at " + cellName(row, col) + " needs a screw hole diameter.";
+					return false;
+				}
+
+				if (hole >= layout.ballDiameter()) {
+					error = "The screw hole at " + cellName(row, col) + " is wider than the ball.";
+					return false;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	// Nuts in one column share a sketch, so neighbouring hexes must not touch and the bolt must fit inside them.
+	bool Validator::validateNuts(const Layout& layout, std::string& error) {
+		if (layout.numJointTypes(ARMATURE_JOINT_OPTION_NUT) == 0)
+			return true;
+
+		if (layout.boltHoleDiameter() >= 2 * layout.ballOffset()) {
+			error = "The bolt hole is wider than the nuts.";
+			return false;
+		}
+
+		auto span = nutHalfSpan(layout);
+
+		for (auto col = 1; col <= layout.cols(); col++) {
+			auto previous = 0;
+			for (auto row = 1; row <= layout.rows(); row++) {
+				if (layout.jointType(row, col) != ARMATURE_JOINT_OPTION_NUT)
+					continue;
+
+				if (previous != 0 && fabs(layout.ballY(previous) - layout.ballY(row)) < (2 * span) + clearance) {
+					error = "The nuts at " + cellName(previous, col) + " and " + cellName(row, col) + " overlap.";
+					return false;
+				}
+
+				previous = row;
+			}
+		}
+
+		return true;
+	}
+
+	// A screw leaves its ball between the plates, so at rest nothing may reach the shaft where it is outside the
+	// ball, from the rim of the hole outwards. Seats are at least 2.2 ball radii apart and shafts thinner than the
+	// ball, so only the shaft's own line of cells and the two beside it can reach it.
+	bool Validator::validateShafts(const Layout& layout, std::string& error) {
+		auto r = layout.ballRadius();
+		auto span = nutHalfSpan(layout);
+
+		for (auto row = 1; row <= layout.rows(); row++) {
+			for (auto col = 1; col <= layout.cols(); col++) {
+				if (layout.jointType(row, col) != ARMATURE_JOINT_OPTION_BALL)
+					continue;
+
+				auto direction = layout.ballHoleDirection(row, col);
+				auto downRows = direction.z != 0;
+				auto shaft = std::min(layout.holeRadius(row, col), r);
+				auto rim = sqrt((r * r) - (shaft * shaft));
+				auto x = layout.ballX(col);
+				auto z = -layout.ballY(row);
+
+				// Nuts reach half a ball radius along x and their half span along z.
+				auto nutAlong = downRows ? span : r / 2;
+				auto nutAcross = downRows ? r / 2 : span;
+
+				for (auto side = -1; side <= 1; side++) {
+					for (auto step = side == 0 ? 1 : 0; ; step++) {
+						auto other = downRows ? row + (step * (int)direction.z) : row + side;
+						auto otherCol = downRows ? col + side : col + (step * (int)direction.x);
+						if (other < 1 || other > layout.rows() || otherCol < 1 || otherCol > layout.cols())
+							break;
+
+						auto type = layout.jointType(other, otherCol);
+						auto dx = layout.ballX(otherCol) - x;
+						auto dz = -layout.ballY(other) - z;
+						auto along = (dx * direction.x) + (dz * direction.z);
+						auto across = fabs((dx * direction.z) + (dz * direction.x));
+
+						// The nearest point of the exposed shaft to a ball, and the overlap of a nut's box with it.
+						auto gapAlong = std::max(rim - along, 0.0);
+						auto gapAcross = std::max(across - shaft, 0.0);
+						auto ball = type == ARMATURE_JOINT_OPTION_BALL && (gapAlong * gapAlong) + (gapAcross * gapAcross) < r * r;
+						auto nut = type == ARMATURE_JOINT_OPTION_NUT && along + nutAlong > rim && across - nutAcross < shaft;
+						if (ball || nut) {
+							error = "The screw hole at " + cellName(row, col) + " runs into the " + (ball ? "ball" : "nut") + " at " + cellName(other, otherCol) + ".";
+							return false;
+						}
+					}
+				}
+			}
+		}
+
+		return true;
+	}
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <string>
+
+#include "Layout.h"
+
+namespace ArmatureJoint {
+	// Checks a joint layout for geometry that cannot be generated, using only the layout's math, so bad inputs are
+	// rejected before any sketch or feature is created.
+	class Validator {
+	public:
+		static bool validate(const Layout& layout, std::string& error);
+
+	private:
+		static bool validateSizes(const Layout& layout, std::string& error);
+		static bool validateSeats(const Layout& layout, std::string& error);
+		static bool validateHoles(const Layout& layout, std::string& error);
+		static bool validateNuts(const Layout& layout, std::string& error);
+		static bool validateShafts(const Layout& layout, std::string& error);
+	};
+}
@@ -1,326 +1,518 @@
-#include <Core/CoreAll.h>
-#include <Fusion/FusionAll.h>
-#include <CAM/CAMAll.h>
-#define _USE_MATH_DEFINES
-#include <math.h>
-#include <string>
-#include <algorithm>
-
-#include "Values.h"
-#include "UI.h"
-
-namespace ArmatureJoint {
-	Ptr<UnitsManager> Values::unitsManager;
-
-	double Values::circleRadiusOfSphere(double sphereRadius, double offset) {
-		return sqrt(pow(sphereRadius, 2) - pow(offset, 2));
-	}
-
-	double Values::diameterForCircleRadiusOfSphere(double circleRadius, double offset) {
-		return sqrt(pow(circleRadius, 2) + pow(offset, 2)) * 2;
-	}
-
-	double Values::defaultLength() {
-		return unitsManager->convert(15, "mm", unitsManager->internalUnits());
-	}
-
-	double Values::defaultWidth() {
-		return unitsManager->convert(6, "mm", unitsManager->internalUnits());
-	}
-
-	double Values::defaultThickness() {
-		return unitsManager->convert((double)1 / (double)16, "in", unitsManager->internalUnits());
-	}
-
-	double Values::defaultBallDiameter() {
-		return unitsManager->convert(5, "mm", unitsManager->internalUnits());
-	}
-
-	double Values::defaultRows() {
-		return 2;
-	}
-
-	double Values::defaultCols() {
-		return 1;
-	}
-
-	double Values::defaultHoleDiameter() {
-		return unitsManager->convert(3, "mm", unitsManager->internalUnits());
-	}
-
-	double Values::defaultBoltHoleDiameter() {
-		return unitsManager->convert(3, "mm", unitsManager->internalUnits());
-	}
-
-	shared_ptr<Values> Values::create(Ptr<CommandInputs> inputs) {
-		shared_ptr<Values> values(new Values());
-
-		if (!inputs)
-			return nullptr;
-
-		values->nameInput = inputs->itemById(ARMATURE_JOINT_COMMAND_NAME_INPUT_ID);
-		if (!values->nameInput)
-			return nullptr;
-
-		values->lengthInput = inputs->itemById(ARMATURE_JOINT_COMMAND_LENGTH_INPUT_ID);
-		if (!values->lengthInput)
-			return nullptr;
-
-		values->widthInput = inputs->itemById(ARMATURE_JOINT_COMMAND_WIDTH_INPUT_ID);
-		if (!values->widthInput)
-			return nullptr;
-
-		values->thicknessInput = inputs->itemById(ARMATURE_JOINT_COMMAND_PLATE_THICKNESS_INPUT_ID);
-		if (!values->thicknessInput)
-			return nullptr;
-
-		values->ballDiameterInput = inputs->itemById(ARMATURE_JOINT_COMMAND_BALL_DIAMETER_INPUT_ID);
-		if (!values->ballDiameterInput)
-			return nullptr;
-
-		values->rowsInput = inputs->itemById(ARMATURE_JOINT_COMMAND_ROWS_INPUT_ID);
-		if (!values->rowsInput)
-			return nullptr;
-
-		values->colsInput = inputs->itemById(ARMATURE_JOINT_COMMAND_COLS_INPUT_ID);
-		if (!values->colsInput)
-			return nullptr;
-
-		values->boltHoleInput = inputs->itemById(ARMATURE_JOINT_COMMAND_BOLT_HOLE_DIAMETER_INPUT_ID);
-		if (!values->boltHoleInput)
-			return nullptr;
-
-		values->tableInput = inputs->itemById(ARMATURE_JOINT_COMMAND_TABLE_INPUT_ID);
-		if (!values->tableInput)
-			return nullptr;
-
-		values->tableInput->numberOfColumns(values->cols() * 2);
-
-		for (auto i = values->tableInput->rowCount(); i >= values->rows() * 2; i--)
-		{
-			values->tableInput->deleteRow(i);
-		}
-
-		auto tableInputs = values->tableInput->commandInputs();
-
-		for (auto col = 0; col < values->cols(); col++) {
-			for (auto row = 0; row < values->rows(); row++) {
-
-				auto typeID = "tableInputType_" + std::to_string(col) + "_" + std::to_string(row);
-
-				auto tableInputType = static_cast<Ptr<RadioButtonGroupCommandInput>>(tableInputs->itemById(typeID));
-				if (!tableInputType) {
-					auto radio = tableInputs->addRadioButtonGroupCommandInput(typeID, "Type");
-					if (!radio)
-						return nullptr;
-
-					auto items = radio->listItems();
-					if (!items)
-						return nullptr;
-
-					auto ball = items->add(ARMATURE_JOINT_OPTION_BALL, true);
-					auto nut = items->add(ARMATURE_JOINT_OPTION_NUT, false);
-					auto none = items->add(ARMATURE_JOINT_OPTION_NONE, false);
-
-					values->tableInput->addCommandInput(radio, row * 2, col);
-				}
-
-
-				auto holeDiameterID = "tableInputHoleDiameter_" + std::to_string(col) + "_" + std::to_string(row);
-				auto tableInputHoleDiameter = static_cast<Ptr<DistanceValueCommandInput>>(tableInputs->itemById(holeDiameterID));
-				if (!tableInputHoleDiameter) {
-					auto holeDiameter = tableInputs->addDistanceValueCommandInput(
-						holeDiameterID,
-						"Hole Diameter",
-						ValueInput::createByReal(values->defaultHoleDiameter())
-					);
-					if (!holeDiameter)
-						return false;
-
-					auto cmdInput = values->tableInput->addCommandInput(holeDiameter, (row * 2) + 1, col);
-					if (!cmdInput)
-						return false;
-				}
-			}
-		}
-
-		return values;
-	}
-
-	std::string Values::jointType(int row, int col) {
-		row--;
-		col--;
-
-		auto input = static_cast<Ptr<RadioButtonGroupCommandInput>>(tableInput->getInputAtPosition((row * 2), col));
-		if (!input)
-			return ARMATURE_JOINT_OPTION_NONE;
-
-		auto selection = input->selectedItem();
-		if (!selection)
-			return ARMATURE_JOINT_OPTION_NONE;
-
-		return selection->name();
-	}
-
-	double Values::ballDiameter() {
-		if (!ballDiameterInput)
-			return 0;
-
-		return ballDiameterInput->value();
-	}
-
-	double Values::width() {
-		if (!widthInput)
-			return 0;
-
-		return widthInput->value();
-	}
-
-	double Values::length() {
-		if (!lengthInput)
-			return 0;
-		return lengthInput->value();
-	}
-
-	double Values::thickness() {
-		if (!thicknessInput)
-			return 0;
-
-		return thicknessInput->value();
-	}
-
-	double Values::chamferLength() {
-		return ballRadius() / 6;
-	}
-	double Values::chamferAngle() {
-		return M_PI_4; // 45 degrees in radians
-	}
-
-	void Values::setExtents() {
-		lengthInput->setManipulator(Point3D::create(0, 0, 0), Vector3D::create(1, 0, 0));
-		widthInput->setManipulator(Point3D::create(0, 0, 0), Vector3D::create(0, 0, 1));
-		thicknessInput->setManipulator(Point3D::create(0, 0, 0), Vector3D::create(0, 1, 0));
-		ballDiameterInput->setManipulator(Point3D::create(ballX(1), ballZ(), -ballY(1)), Vector3D::create(0, 1, 0));
-
-		if (width() < minWidth()) {
-			widthInput->value(minWidth());
-		}
-
-		lengthInput->minimumValue(minWidth());
-		widthInput->minimumValue(minWidth());
-		ballDiameterInput->maximumValue(maxBallDiameter());
-	}
-
-	double Values::ballOffset() {
-		return ballRadius() / 1.2;
-	}
-
-	double Values::ballRadius() {
-		return ballDiameter() / 2;
-	}
-
-	double Values::ballX(int col) {
-		if (col == 1)
-			return ballRadius() / 1.25;
-
-		return length() - (ballRadius() / 1.25);
-	}
-
-	double Values::ballY(int row) {
-		auto rowSize = width() / (double)rows();
-
-		return -((rowSize * row) - (rowSize / 2));
-	}
-
-	double Values::plateOffset() {
-		return ballOffset() - (chamferLength() / 1.25);
-	}
-
-	double Values::ballZ() {
-		return thickness() + plateOffset();
-	}
-
-	double Values::circleRadius() {
-		return circleRadiusOfSphere(ballRadius(), ballOffset());
-	}
-
-	double Values::circleArea() {
-		return M_PI * pow(circleRadius(), 2);
-	}
-
-	double Values::circleCircumference() {
-		return 2 * M_PI * circleRadius();
-	}
-
-	double Values::minWidth() {
-		return ((circleRadius() * 2) + 0.05) * rows();
-	}
-
-	double Values::maxBallDiameter() {
-		return diameterForCircleRadiusOfSphere((width() / rows()) + 0.05, ballOffset());
-	}
-
-	double Values::expectedArea() {
-		return (length() * width()) - (boltCircleArea() + (circleArea() * (double)numJointTypes(ARMATURE_JOINT_OPTION_BALL)));
-	}
-
-	int Values::numJointTypes(std::string expectedJointType) {
-		int num = 0;
-		for (auto row = 1; row <= rows(); row++) {
-			for (auto col = 1; col <= cols(); col++) {
-				auto t = jointType(row, col);
-				if (t == expectedJointType)
-					num++;
-			}
-		}
-		return num;
-	}
-
-	int Values::rows() {
-		if (!rowsInput)
-			return 1;
-
-		return rowsInput->value();
-	}
-
-	int Values::cols() {
-		if (!colsInput)
-			return 1;
-		return colsInput->value();
-	}
-
-	std::string Values::name() {
-		if (!nameInput)
-			return "";
-
-		return nameInput->value();
-	}
-	double Values::holeDiameter(int row, int col) {
-		row--;
-		col--;
-
-		auto input = static_cast<Ptr<DistanceValueCommandInput>>(tableInput->getInputAtPosition((row * 2) + 1, col));
-		if (!input)
-			return 0;
-		return input->value();
-	}
-
-	double Values::holeRadius(int row, int col) {
-		return holeDiameter(row, col) / 2;
-	}
-
-	double Values::boltHoleDiameter() {
-		if (!boltHoleInput)
-			return 0;
-
-		return boltHoleInput->value();
-	}
-
-	double Values::boltHoleRadius() {
-		return boltHoleDiameter() / 2;
-	}
-
-	double Values::boltCircleArea() {
-		return  M_PI * pow(boltHoleRadius(), 2);
-	}
-}
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+#include <CAM/CAMAll.h>
+#define _USE_MATH_DEFINES
+#include <math.h>
+#include <string>
+#include <algorithm>
+
+#include "Values.h"
+#include "UI.h"
+#include "Validator.h"
+
+namespace ArmatureJoint {
+	double Values::defaultLength() {
+		return Defaults::length.centimetres();
+	}
+
+	double Values::defaultWidth() {
+		return Defaults::width.centimetres();
+	}
+
+	double Values::defaultThickness() {
+		return Defaults::thickness.centimetres();
+	}
+
+	double Values::defaultBallDiameter() {
+		return Defaults::ballDiameter.centimetres();
+	}
+
+	double Values::defaultRows() {
+		return Defaults::rows;
+	}
+
+	double Values::defaultCols() {
+		return Defaults::cols;
+	}
+
+	double Values::defaultHoleDiameter() {
+		return Defaults::holeDiameter.centimetres();
+	}
+
+	double Values::defaultBoltHoleDiameter() {
+		return Defaults::boltHoleDiameter.centimetres();
+	}
+
+	Values::Values() : tableRows(0), tableCols(0), validated(false) {
+	}
+
+	shared_ptr<Values> Values::create(Ptr<CommandInputs> inputs) {
+		shared_ptr<Values> values(new Values());
+
+		if (!inputs)
+			return nullptr;
+
+		values->nameInput = inputs->itemById(ARMATURE_JOINT_COMMAND_NAME_INPUT_ID);
+		if (!values->nameInput)
+			return nullptr;
+
+		values->lengthInput = inputs->itemById(ARMATURE_JOINT_COMMAND_LENGTH_INPUT_ID);
+		if (!values->lengthInput)
+			return nullptr;
+
+		values->widthInput = inputs->itemById(ARMATURE_JOINT_COMMAND_WIDTH_INPUT_ID);
+		if (!values->widthInput)
+			return nullptr;
+
+		values->thicknessInput = inputs->itemById(ARMATURE_JOINT_COMMAND_PLATE_THICKNESS_INPUT_ID);
+		if (!values->thicknessInput)
+			return nullptr;
+
+		values->ballDiameterInput = inputs->itemById(ARMATURE_JOINT_COMMAND_BALL_DIAMETER_INPUT_ID);
+		if (!values->ballDiameterInput)
+			return nullptr;
+
+		values->rowsInput = inputs->itemById(ARMATURE_JOINT_COMMAND_ROWS_INPUT_ID);
+		if (!values->rowsInput)
+			return nullptr;
+
+		values->colsInput = inputs->itemById(ARMATURE_JOINT_COMMAND_COLS_INPUT_ID);
+		if (!values->colsInput)
+			return nullptr;
+
+		values->boltHoleInput = inputs->itemById(ARMATURE_JOINT_COMMAND_BOLT_HOLE_DIAMETER_INPUT_ID);
+		if (!values->boltHoleInput)
+			return nullptr;
+
+		values->tableInput = inputs->itemById(ARMATURE_JOINT_COMMAND_TABLE_INPUT_ID);
+		if (!values->tableInput)
+			return nullptr;
+
+		values->errorInput = inputs->itemById(ARMATURE_JOINT_COMMAND_ERROR_INPUT_ID);
+		if (!values->errorInput)
+			return nullptr;
+
+		if (!values->syncTable())
+			return nullptr;
+
+		if (!values->read())
+			return nullptr;
+
+		return values;
+	}
+
+	// Applies a single input change. Only the table cells that were added or removed are touched.
+	bool Values::update(Ptr<CommandInput> input) {
+		validated = false;
+
+		if (!input)
+			return read();
+
+		auto id = input->id();
+		if (id == ARMATURE_JOINT_COMMAND_NAME_INPUT_ID) {
+			name(nameInput->value());
+		}
+		else if (id == ARMATURE_JOINT_COMMAND_LENGTH_INPUT_ID) {
+			length(lengthInput->value());
+		}
+		else if (id == ARMATURE_JOINT_COMMAND_WIDTH_INPUT_ID) {
+			width(widthInput->value());
+		}
+		else if (id == ARMATURE_JOINT_COMMAND_PLATE_THICKNESS_INPUT_ID) {
+			thickness(thicknessInput->value());
+		}
+		else if (id == ARMATURE_JOINT_COMMAND_BALL_DIAMETER_INPUT_ID) {
+			ballDiameter(ballDiameterInput->value());
+		}
+		else if (id == ARMATURE_JOINT_COMMAND_BOLT_HOLE_DIAMETER_INPUT_ID) {
+			boltHoleDiameter(boltHoleInput->value());
+		}
+		else if (id == ARMATURE_JOINT_COMMAND_ROWS_INPUT_ID || id == ARMATURE_JOINT_COMMAND_COLS_INPUT_ID) {
+			auto oldRows = rows();
+			auto oldCols = cols();
+
+			if (!syncTable())
+				return false;
+
+			resize(rowsInput->value(), colsInput->value(), defaultCell());
+
+			for (auto row = 1; row <= rows(); row++) {
+				for (auto col = 1; col <= cols(); col++) {
+					if ((row > oldRows || col > oldCols) && !readCell(row, col))
+						return false;
+				}
+			}
+		}
+		else if (id == ARMATURE_JOINT_COMMAND_TABLE_INPUT_ID) {
+			// Selecting a table row changes nothing.
+		}
+		else {
+			auto cell = cellIDs.find(id);
+			if (cell == cellIDs.end())
+				return read();
+
+			return readCell(cell->second.first, cell->second.second);
+		}
+
+		return true;
+	}
+
+	bool Values::read() {
+		name(nameInput->value());
+		length(lengthInput->value());
+		width(widthInput->value());
+		thickness(thicknessInput->value());
+		ballDiameter(ballDiameterInput->value());
+		boltHoleDiameter(boltHoleInput->value());
+		resize(rowsInput->value(), colsInput->value(), defaultCell());
+
+		for (auto row = 1; row <= rows(); row++) {
+			for (auto col = 1; col <= cols(); col++) {
+				if (!readCell(row, col))
+					return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool Values::readCell(int row, int col) {
+		auto inputs = cellInputs.find(make_pair(row, col));
+		if (inputs == cellInputs.end())
+			return false;
+
+		JointCell cell;
+
+		auto selection = inputs->second.type->selectedItem();
+		cell.type = selection ? selection->name() : ARMATURE_JOINT_OPTION_NONE;
+		cell.holeDiameter = inputs->second.holeDiameter->value();
+
+		Layout::cell(row, col, cell);
+		return true;
+	}
+
+	// Brings the table to the rows and columns of the spinners, adding and removing only the cells that differ.
+	// Each joint row is one table row, with a type and a hole diameter column per joint column.
+	bool Values::syncTable() {
+		auto newRows = rowsInput->value();
+		auto newCols = colsInput->value();
+		if (newRows == tableRows && newCols == tableCols)
+			return true;
+
+		if (newCols != tableCols) {
+			tableInput->numberOfColumns(newCols * 2);
+			tableInput->columnRatio(""); // equal widths for any number of columns
+		}
+
+		for (auto i = tableInput->rowCount() - 1; i >= newRows; i--)
+		{
+			tableInput->deleteRow(i);
+		}
+
+		for (auto cell = cellInputs.begin(); cell != cellInputs.end();) {
+			auto row = cell->first.first;
+			auto col = cell->first.second;
+			if (row <= newRows && col <= newCols) {
+				cell++;
+				continue;
+			}
+
+			if (row <= newRows) {
+				tableInput->removeInput(row - 1, (col - 1) * 2);
+				tableInput->removeInput(row - 1, ((col - 1) * 2) + 1);
+			}
+
+			cellIDs.erase(cell->second.type->id());
+			cellIDs.erase(cell->second.holeDiameter->id());
+			cell = cellInputs.erase(cell);
+		}
+
+		auto tableInputs = tableInput->commandInputs();
+		if (!tableInputs)
+			return false;
+
+		for (auto row = 1; row <= newRows; row++) {
+			for (auto col = 1; col <= newCols; col++) {
+				if (row > tableRows || col > tableCols) {
+					if (!addCell(tableInputs, row, col))
+						return false;
+				}
+			}
+		}
+
+		tableRows = newRows;
+		tableCols = newCols;
+		return true;
+	}
+
+	bool Values::addCell(Ptr<CommandInputs> tableInputs, int row, int col) {
+		CellInputs inputs;
+
+		auto typeID = "tableInputType_" + std::to_string(col - 1) + "_" + std::to_string(row - 1);
+
+		// Inputs can outlive a Values instance or their table position, so reuse one that is still there.
+		inputs.type = tableInputs->itemById(typeID);
+		if (!inputs.type) {
+			auto dropDown = tableInputs->addDropDownCommandInput(typeID, "Type", DropDownStyles::TextListDropDownStyle);
+			if (!dropDown)
+				return false;
+
+			auto items = dropDown->listItems();
+			if (!items)
+				return false;
+
+			auto ball = items->add(ARMATURE_JOINT_OPTION_BALL, true);
+			auto nut = items->add(ARMATURE_JOINT_OPTION_NUT, false);
+			auto none = items->add(ARMATURE_JOINT_OPTION_NONE, false);
+
+			inputs.type = dropDown;
+		}
+
+		if (!tableInput->getInputAtPosition(row - 1, (col - 1) * 2) && !tableInput->addCommandInput(inputs.type, row - 1, (col - 1) * 2))
+			return false;
+
+		auto holeDiameterID = "tableInputHoleDiameter_" + std::to_string(col - 1) + "_" + std::to_string(row - 1);
+
+		inputs.holeDiameter = tableInputs->itemById(holeDiameterID);
+		if (!inputs.holeDiameter) {
+			inputs.holeDiameter = tableInputs->addDistanceValueCommandInput(
+				holeDiameterID,
+				"Hole Diameter",
+				ValueInput::createByReal(defaultHoleDiameter())
+			);
+			if (!inputs.holeDiameter)
+				return false;
+		}
+
+		if (!tableInput->getInputAtPosition(row - 1, ((col - 1) * 2) + 1) && !tableInput->addCommandInput(inputs.holeDiameter, row - 1, ((col - 1) * 2) + 1))
+			return false;
+
+		cellInputs[make_pair(row, col)] = inputs;
+		cellIDs[typeID] = make_pair(row, col);
+		cellIDs[holeDiameterID] = make_pair(row, col);
+		return true;
+	}
+
+	shared_ptr<Values> Values::addInputs(Ptr<CommandInputs> inputs, const JointSpec& spec) {
+		if (!inputs)
+			return nullptr;
+
+		auto nameInput = inputs->addStringValueInput(
+			ARMATURE_JOINT_COMMAND_NAME_INPUT_ID,
+			"Name",
+			spec.name
+		);
+		if (!nameInput)
+			return nullptr;
+
+		auto lengthInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_COMMAND_LENGTH_INPUT_ID,
+			"Joint Length",
+			ValueInput::createByReal(spec.length)
+		);
+		if (!lengthInput)
+			return nullptr;
+
+		auto widthInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_COMMAND_WIDTH_INPUT_ID,
+			"Joint Width",
+			ValueInput::createByReal(spec.width)
+		);
+		if (!widthInput)
+			return nullptr;
+
+		auto plateThicknessInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_COMMAND_PLATE_THICKNESS_INPUT_ID,
+			"Plate Thickness",
+			ValueInput::createByReal(spec.thickness)
+		);
+		if (!plateThicknessInput)
+			return nullptr;
+
+		auto boltHoleDiameterInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_COMMAND_BOLT_HOLE_DIAMETER_INPUT_ID,
+			"Bolt Hole Diameter",
+			ValueInput::createByReal(spec.boltHoleDiameter)
+		);
+		if (!boltHoleDiameterInput)
+			return nullptr;
+
+		auto ballDiameterInput = inputs->addDistanceValueCommandInput(
+			ARMATURE_JOINT_COMMAND_BALL_DIAMETER_INPUT_ID,
+			"Ball Diameter",
+			ValueInput::createByReal(spec.ballDiameter)
+		);
+		if (!ballDiameterInput)
+			return nullptr;
+
+		auto ballRowsInput = inputs->addIntegerSpinnerCommandInput(
+			ARMATURE_JOINT_COMMAND_ROWS_INPUT_ID,
+			"Rows",
+			1,
+			Defaults::maxRows,
+			1,
+			ValueInput::createByReal(spec.rows)
+		);
+		if (!ballRowsInput)
+			return nullptr;
+		
+		auto ballColsInput = inputs->addIntegerSpinnerCommandInput(
+			ARMATURE_JOINT_COMMAND_COLS_INPUT_ID,
+			"Cols",
+			1,
+			Defaults::maxCols,
+			1,
+			ValueInput::createByReal(spec.cols)
+		);
+		if (!ballColsInput)
+			return nullptr;
+
+		auto tableInput = inputs->addTableCommandInput(
+			ARMATURE_JOINT_COMMAND_TABLE_INPUT_ID,
+			"Specifications",
+			2,
+			"1:1"
+		);
+		if (!tableInput)
+			return nullptr;
+
+		tableInput->maximumVisibleRows(10);
+
+		auto errorInput = inputs->addTextBoxCommandInput(
+			ARMATURE_JOINT_COMMAND_ERROR_INPUT_ID,
+			"Problem",
+			"",
+			2,
+			true
+		);
+		if (!errorInput)
+			return nullptr;
+
+		errorInput->isVisible(false);
+
+		auto values = create(inputs);
+		if (!values || !values->load(spec))
+			return nullptr;
+
+		return values;
+	}
+
+	bool Values::load(const JointSpec& spec) {
+		nameInput->value(spec.name);
+		lengthInput->value(spec.length);
+		widthInput->value(spec.width);
+		thicknessInput->value(spec.thickness);
+		ballDiameterInput->value(spec.ballDiameter);
+		boltHoleInput->value(spec.boltHoleDiameter);
+		rowsInput->value(spec.rows);
+		colsInput->value(spec.cols);
+
+		// The table needs the spec's rows and columns before the cells are filled in.
+		if (!syncTable())
+			return false;
+
+		for (auto row = 1; row <= spec.rows; row++) {
+			for (auto col = 1; col <= spec.cols; col++) {
+				auto& cell = spec.cell(row, col);
+
+				auto inputs = cellInputs.find(make_pair(row, col));
+				if (inputs == cellInputs.end())
+					return false;
+
+				auto items = inputs->second.type->listItems();
+				for (size_t i = 0; items && i < items->count(); i++) {
+					auto item = items->item(i);
+					if (item && item->name() == cell.type)
+						item->isSelected(true);
+				}
+
+				inputs->second.holeDiameter->value(cell.holeDiameter);
+			}
+		}
+
+		return read();
+	}
+
+	// Loads a preset along with its precomputed layout, so neither the layout nor its validation is worked out again.
+	bool Values::load(const JointSpec& spec, const double* layout) {
+		if (!load(spec))
+			return false;
+
+		restore(layout);
+		validated = true;
+
+		return true;
+	}
+
+	shared_ptr<Values> Values::create(const JointSpec& spec) {
+		shared_ptr<Values> values(new Values());
+
+		if (spec.rows < 1 || spec.cols < 1 || (int)spec.cells.size() != spec.rows * spec.cols)
+			return nullptr;
+
+		values->spec(spec);
+
+		return values;
+	}
+
+	JointSpec Values::defaultSpec() {
+		return JointSpec::defaults();
+	}
+
+	JointCell Values::defaultCell() {
+		return JointCell::defaults();
+	}
+
+	void Values::setExtents() {
+		lengthInput->setManipulator(Point3D::create(0, 0, 0), Vector3D::create(1, 0, 0));
+		widthInput->setManipulator(Point3D::create(0, 0, 0), Vector3D::create(0, 0, 1));
+		thicknessInput->setManipulator(Point3D::create(0, 0, 0), Vector3D::create(0, 1, 0));
+		ballDiameterInput->setManipulator(Point3D::create(ballX(1), ballZ(), -ballY(1)), Vector3D::create(0, 1, 0));
+
+		if (width() < minWidth()) {
+			width(minWidth());
+			widthInput->value(width());
+		}
+
+		if (length() < minLength()) {
+			length(minLength());
+			lengthInput->value(length());
+		}
+
+		lengthInput->minimumValue(minLength());
+		widthInput->minimumValue(minWidth());
+		ballDiameterInput->maximumValue(maxBallDiameter());
+	}
+
+	// Shows why the current inputs cannot be generated, if they cannot.
+	bool Values::validate() {
+		std::string error;
+		auto valid = validated || Validator::validate(*this, error);
+
+		errorInput->text(valid ? "" : error);
+		errorInput->isVisible(!valid);
+
+		return valid;
+	}
+
+	// Corners of the hex nut around the bolt, in the plane of the nut sketch.
+	Ptr<Point3D> Values::nutPoint(int row, int index) {
+		auto thirty = (30.0 / 180.0) * M_PI; // half of the hex angle
+
+		auto x = ballY(row);
+		auto y = ballZ();
+		auto off = ballOffset();
+
+		// opp = adj / tan(theta)
+		auto opp = ballOffset() * tan(thirty);
+
+		switch (index % 6) {
+		case 0: return Point3D::create(x - opp, y + off, 0);
+		case 1: return Point3D::create(x + opp, y + off, 0);
+		case 2: return Point3D::create(x + (2 * opp), y, 0);
+		case 3: return Point3D::create(x + opp, y - off, 0);
+		case 4: return Point3D::create(x - opp, y - off, 0);
+		default: return Point3D::create(x - (2 * opp), y, 0);
+		}
+	}
+}
\ No newline at end of file
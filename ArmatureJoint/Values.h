@@ -1,67 +1,69 @@
-#pragma once
-
-#include <Core/CoreAll.h>
-#include <list>
-
-using namespace std;
-using namespace adsk::core;
-
-namespace ArmatureJoint {
-	class Values {
-	public:
-		static double circleRadiusOfSphere(double sphereDiameter, double offset);
-		static double diameterForCircleRadiusOfSphere(double circleRadius, double offset);
-		static double defaultLength();
-		static double defaultWidth();
-		static double defaultThickness();
-		static double defaultBallDiameter();
-		static double defaultBoltHoleDiameter();
-		static double defaultRows();
-		static double defaultCols();
-		static double defaultHoleDiameter();
-		static shared_ptr<Values> create(Ptr<CommandInputs> inputs);
-		double ballDiameter();
-		double width();
-		double length();
-		double thickness();
-		void setExtents();
-		double ballOffset();
-		double plateOffset();
-		double ballRadius();
-		double ballX(int col);
-		double ballY(int row);
-		double ballZ();
-		double circleRadius();
-		double circleArea();
-		double circleCircumference();
-		double minWidth();
-		double maxBallDiameter();
-		double holeDiameter(int row, int col);
-		double boltHoleDiameter();
-		double boltHoleRadius();
-		double boltCircleArea();
-		double holeRadius(int row, int col);
-		double chamferLength();
-		double chamferAngle();
-		double expectedArea();
-		
-		int numJointTypes(std::string jointType);
-		int rows();
-		int cols();
-		std::string jointType(int row, int col);
-		std::string name();
-
-		static Ptr<UnitsManager> unitsManager;
-
-	private:
-		Ptr<StringValueCommandInput> nameInput;
-		Ptr<DistanceValueCommandInput> lengthInput;
-		Ptr<DistanceValueCommandInput> widthInput;
-		Ptr<DistanceValueCommandInput> thicknessInput;
-		Ptr<DistanceValueCommandInput> ballDiameterInput;
-		Ptr<IntegerSpinnerCommandInput> rowsInput;
-		Ptr<IntegerSpinnerCommandInput> colsInput;
-		Ptr<TableCommandInput> tableInput;
-		Ptr<DistanceValueCommandInput> boltHoleInput;
-	};
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <list>
+#include <map>
+
+#include "JointSpec.h"
+#include "Layout.h"
+
+using namespace std;
+using namespace adsk::core;
+
+namespace ArmatureJoint {
+	class Values : public Layout {
+	public:
+		Values();
+
+		static double defaultLength();
+		static double defaultWidth();
+		static double defaultThickness();
+		static double defaultBallDiameter();
+		static double defaultBoltHoleDiameter();
+		static double defaultRows();
+		static double defaultCols();
+		static double defaultHoleDiameter();
+		static JointSpec defaultSpec();
+		static JointCell defaultCell();
+		static shared_ptr<Values> create(Ptr<CommandInputs> inputs);
+		static shared_ptr<Values> create(const JointSpec& spec);
+		static shared_ptr<Values> addInputs(Ptr<CommandInputs> inputs, const JointSpec& spec);
+		bool load(const JointSpec& spec);
+		bool load(const JointSpec& spec, const double* layout);
+		bool update(Ptr<CommandInput> input);
+		void setExtents();
+		bool validate();
+		Ptr<Point3D> nutPoint(int row, int index);
+
+	private:
+		struct CellInputs {
+			Ptr<DropDownCommandInput> type;
+			Ptr<DistanceValueCommandInput> holeDiameter;
+		};
+
+		bool read();
+		bool readCell(int row, int col);
+		bool syncTable();
+		bool addCell(Ptr<CommandInputs> tableInputs, int row, int col);
+
+		Ptr<StringValueCommandInput> nameInput;
+		Ptr<DistanceValueCommandInput> lengthInput;
+		Ptr<DistanceValueCommandInput> widthInput;
+		Ptr<DistanceValueCommandInput> thicknessInput;
+		Ptr<DistanceValueCommandInput> ballDiameterInput;
+		Ptr<IntegerSpinnerCommandInput> rowsInput;
+		Ptr<IntegerSpinnerCommandInput> colsInput;
+		Ptr<TableCommandInput> tableInput;
+		Ptr<DistanceValueCommandInput> boltHoleInput;
+		Ptr<TextBoxCommandInput> errorInput;
+
+		// Table inputs by (row, col), and cell input IDs back to their (row, col), so changes never search the table.
+		map<pair<int, int>, CellInputs> cellInputs;
+		map<std::string, pair<int, int>> cellIDs;
+		int tableRows;
+		int tableCols;
+
+		// Set while the inputs hold a preset that was validated when its library was built.
+		bool validated;
+	};
 }
\ No newline at end of file
@@ -1,62 +1,245 @@
-#include "ArmatureJointApp.h"
-
-#define ARMATURE_JOINT_COMMAND_ID "createArmatureJoint"
-
-ArmatureJointApp::ArmatureJointApp() {
-	auto app = Application::get();
-	assert(app);
-	
-	auto ui = app->userInterface();
-	assert(ui);
-
-	auto definitions = ui->commandDefinitions();
-	assert(definitions);
-
-	button = definitions->addButtonDefinition(
-		ARMATURE_JOINT_COMMAND_ID,
-		"Create Armature Joint",
-		"Creates a stop motion animation armature",
-		""
-	);
-	if (!button) {
-		return;
-	}
-
-	auto commandCreated = button->commandCreated();
-	assert(commandCreated);
-
-	commandCreatedEvent = new ArmatureJoint::CommandCreated(app);
-	commandCreated->add(commandCreatedEvent);
-
-	auto panels = ui->allToolbarPanels();
-	assert(panels);
-
-	auto panel = panels->itemById("SolidScriptsAddinsPanel");
-	assert(panel);
-
-	auto controls = panel->controls();
-	assert(controls);
-
-	control = controls->addCommand(button);
-}
-
-ArmatureJointApp::~ArmatureJointApp() {
-	if (commandCreatedEvent) {
-		delete commandCreatedEvent;
-		commandCreatedEvent = nullptr;
-	}
-
-	if (control) {
-		control->deleteMe();
-		control = nullptr;
-	}
-
-	if (button) {
-		button->deleteMe();
-		button = nullptr;
-	}
-
-	if (ui)
-		ui = nullptr;
-
-}
\ No newline at end of file
+#include "ArmatureJointApp.h"
+
+#ifdef XI_WIN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+#define ARMATURE_JOINT_COMMAND_ID "createArmatureJoint"
+#define ARMATURE_JOINT_BATCH_COMMAND_ID "createArmatureJointsFromFile"
+#define ARMATURE_JOINT_EDIT_COMMAND_ID "editArmatureJoint"
+#define ARMATURE_JOINT_BULK_COMMAND_ID "resizeArmatureJoints"
+#define ARMATURE_JOINT_INTERFERENCE_COMMAND_ID "checkArmatureInterference"
+#define ARMATURE_JOINT_SWEEP_COMMAND_ID "sweepArmatureJointSizes"
+#define ARMATURE_JOINT_TOLERANCE_COMMAND_ID "analyseArmatureJointTolerances"
+#define ARMATURE_JOINT_MASS_COMMAND_ID "armatureMassProperties"
+#define ARMATURE_JOINT_HOLDING_COMMAND_ID "predictArmatureJointHoldingTorque"
+#define ARMATURE_JOINT_MOTION_COMMAND_ID "checkArmatureRangeOfMotion"
+#define ARMATURE_JOINT_EXPORT_COMMAND_ID "exportArmatureMeshes"
+#define ARMATURE_JOINT_DXF_COMMAND_ID "exportArmaturePlateProfiles"
+#define ARMATURE_JOINT_SAVE_COMMAND_ID "saveArmatureJoints"
+#define ARMATURE_JOINT_SKELETON_COMMAND_ID "createArmatureFromSkeleton"
+#define ARMATURE_JOINT_MACHINE_COMMAND_ID "machineArmaturePlates"
+#define ARMATURE_JOINT_COLLAPSE_COMMAND_ID "collapseArmatureJointHistory"
+
+#define ARMATURE_JOINT_PRESETS_FILE "Resources/presets.bin"
+
+namespace {
+	// The folder the add-in library was loaded from.
+	string moduleDirectory() {
+		string path;
+#ifdef XI_WIN
+		HMODULE module = nullptr;
+		if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT, (LPCSTR)&moduleDirectory, &module))
+			return "";
+
+		char name[MAX_PATH];
+		auto length = GetModuleFileNameA(module, name, MAX_PATH);
+		if (length == 0 || length == MAX_PATH)
+			return "";
+
+		path.assign(name, length);
+#else
+		Dl_info info;
+		if (!dladdr((void*)&moduleDirectory, &info) || !info.dli_fname)
+			return "";
+
+		path = info.dli_fname;
+#endif
+		auto slash = path.find_last_of("\\/");
+		return slash == string::npos ? "." : path.substr(0, slash);
+	}
+
+	// The preset library ships in the add-in folder, which is the library's folder or its parent when built per configuration.
+	shared_ptr<ArmatureJoint::PresetLibrary> openPresets() {
+		auto directory = moduleDirectory();
+		if (directory.empty())
+			return nullptr;
+
+		auto presets = ArmatureJoint::PresetLibrary::open(directory + "/" + ARMATURE_JOINT_PRESETS_FILE);
+		if (!presets)
+			presets = ArmatureJoint::PresetLibrary::open(directory + "/../" + ARMATURE_JOINT_PRESETS_FILE);
+
+		return presets;
+	}
+}
+
+ArmatureJointApp::ArmatureJointApp() {
+	app = Application::get();
+	assert(app);
+	
+	ui = app->userInterface();
+	assert(ui);
+
+	auto panels = ui->allToolbarPanels();
+	assert(panels);
+
+	auto panel = panels->itemById("SolidScriptsAddinsPanel");
+	assert(panel);
+
+	controls = panel->controls();
+	assert(controls);
+
+	// Without the library the create command simply has no preset list.
+	presets = openPresets();
+
+	addCommand(
+		ARMATURE_JOINT_COMMAND_ID,
+		"Create Armature Joint",
+		"Creates a stop motion animation armature",
+		new ArmatureJoint::CommandCreated(app, presets)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_BATCH_COMMAND_ID,
+		"Create Armature Joints From File",
+		"Creates every armature joint listed in an armature, JSON or CSV joint specification file",
+		new ArmatureJoint::BatchCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_EDIT_COMMAND_ID,
+		"Edit Armature Joint",
+		"Changes a generated armature joint in place, keeping its bodies and features",
+		new ArmatureJoint::EditCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_BULK_COMMAND_ID,
+		"Resize Armature Joints",
+		"Changes ball, plate and hole sizes on every matching armature joint in the design",
+		new ArmatureJoint::BulkCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_INTERFERENCE_COMMAND_ID,
+		"Check Armature Interference",
+		"Finds armature joints whose balls, plates, nuts or bolts collide or come too close",
+		new ArmatureJoint::InterferenceCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_SWEEP_COMMAND_ID,
+		"Sweep Joint Sizes",
+		"Finds every feasible joint size in a range, and the joints with the least plate material for their clamping area",
+		new ArmatureJoint::SweepCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_TOLERANCE_COMMAND_ID,
+		"Analyse Joint Tolerances",
+		"Samples machining tolerances to show how the ball seats, plate gap and clamping vary on each armature joint",
+		new ArmatureJoint::ToleranceCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_MASS_COMMAND_ID,
+		"Armature Mass Properties",
+		"Mass, centre of mass and inertia of every armature joint in the design, computed from their layouts",
+		new ArmatureJoint::MassCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_HOLDING_COMMAND_ID,
+		"Joint Holding Torque",
+		"Predicts how much torque each armature joint's balls hold from its bolt preload and chamfered seats, against the puppet's weight",
+		new ArmatureJoint::HoldingCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_MOTION_COMMAND_ID,
+		"Check Range of Motion",
+		"Works out how far every ball's shaft can swing before it hits a plate end, a neighbouring ball or nut, or the bolt",
+		new ArmatureJoint::MotionCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_EXPORT_COMMAND_ID,
+		"Export Armature Meshes",
+		"Writes every armature joint in the design to an STL or 3MF file for printing, meshed straight from the joint layouts",
+		new ArmatureJoint::ExportCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_DXF_COMMAND_ID,
+		"Export Plate Profiles",
+		"Writes the plates of every armature joint in the design to a DXF for laser or waterjet cutting, nested on stock sheets",
+		new ArmatureJoint::DxfCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_SAVE_COMMAND_ID,
+		"Save Armature",
+		"Writes every armature joint in the design, with its placement, to an armature, JSON or CSV joint specification file",
+		new ArmatureJoint::SaveCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_SKELETON_COMMAND_ID,
+		"Armature From Skeleton",
+		"Places and sizes a joint along every bone of a sketched skeleton or BVH rest pose, with balls and nuts where the bones meet",
+		new ArmatureJoint::SkeletonCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_MACHINE_COMMAND_ID,
+		"Machine Plates",
+		"Lays the plates of every armature joint flat on nested stock sheets and makes a milling setup for each sheet from an operation template",
+		new ArmatureJoint::MachineCommandCreated(app)
+	);
+
+	addCommand(
+		ARMATURE_JOINT_COLLAPSE_COMMAND_ID,
+		"Collapse Joint History",
+		"Replaces the planes, sketches and features of every armature joint with its final bodies, so large designs open and recompute faster",
+		new ArmatureJoint::CollapseCommandCreated(app)
+	);
+}
+
+bool ArmatureJointApp::addCommand(const string& id, const string& name, const string& tooltip, CommandCreatedEventHandler* commandCreatedEvent) {
+	commandCreatedEvents.push_back(unique_ptr<CommandCreatedEventHandler>(commandCreatedEvent));
+
+	auto definitions = ui->commandDefinitions();
+	assert(definitions);
+
+	auto button = definitions->addButtonDefinition(id, name, tooltip, "");
+	if (!button)
+		return false;
+
+	buttons.push_back(button);
+
+	auto commandCreated = button->commandCreated();
+	assert(commandCreated);
+
+	commandCreated->add(commandCreatedEvent);
+
+	auto control = controls->addCommand(button);
+	if (!control)
+		return false;
+
+	commandControls.push_back(control);
+
+	return true;
+}
+
+ArmatureJointApp::~ArmatureJointApp() {
+	for (auto& control : commandControls) {
+		if (control)
+			control->deleteMe();
+	}
+	commandControls.clear();
+
+	for (auto& button : buttons) {
+		if (button)
+			button->deleteMe();
+	}
+	buttons.clear();
+
+	commandCreatedEvents.clear();
+
+	if (ui)
+		ui = nullptr;
+
+}
@@ -1,27 +1,50 @@
-#pragma once
-
-#include <Core/CoreAll.h>
-#include <Fusion/FusionAll.h>
-#include <CAM/CAMAll.h>
-#define _USE_MATH_DEFINES
-#include <math.h>
-
-#include "ArmatureJoint/CommandCreated.h"
-
-using namespace std;
-using namespace adsk::core;
-using namespace adsk::fusion;
-using namespace adsk::cam;
-
-class ArmatureJointApp {
-public:
-	ArmatureJointApp();
-	~ArmatureJointApp();
-
-private:
-	Ptr<Application> app;
-	Ptr<UserInterface> ui;
-	Ptr<CommandDefinition> button;
-	Ptr<CommandControl> control;
-	ArmatureJoint::CommandCreated* commandCreatedEvent;
-};
\ No newline at end of file
+#pragma once
+
+#include <Core/CoreAll.h>
+#include <Fusion/FusionAll.h>
+#include <CAM/CAMAll.h>
+#define _USE_MATH_DEFINES
+#include <math.h>
+
+#include <vector>
+
+#include "ArmatureJoint/Presets.h"
+
+#include "ArmatureJoint/CommandCreated.h"
+#include "ArmatureJoint/BatchCommandCreated.h"
+#include "ArmatureJoint/EditCommandCreated.h"
+#include "ArmatureJoint/BulkCommandCreated.h"
+#include "ArmatureJoint/InterferenceCommandCreated.h"
+#include "ArmatureJoint/SweepCommandCreated.h"
+#include "ArmatureJoint/ToleranceCommandCreated.h"
+#include "ArmatureJoint/MassCommandCreated.h"
+#include "ArmatureJoint/HoldingCommandCreated.h"
+#include "ArmatureJoint/MotionCommandCreated.h"
+#include "ArmatureJoint/ExportCommandCreated.h"
+#include "ArmatureJoint/DxfCommandCreated.h"
+#include "ArmatureJoint/SaveCommandCreated.h"
+#include "ArmatureJoint/SkeletonCommandCreated.h"
+#include "ArmatureJoint/MachineCommandCreated.h"
+#include "ArmatureJoint/CollapseCommandCreated.h"
+
+using namespace std;
+using namespace adsk::core;
+using namespace adsk::fusion;
+using namespace adsk::cam;
+
+class ArmatureJointApp {
+public:
+	ArmatureJointApp();
+	~ArmatureJointApp();
+
+private:
+	Ptr<Application> app;
+	Ptr<UserInterface> ui;
+	Ptr<ToolbarControls> controls;
+	shared_ptr<ArmatureJoint::PresetLibrary> presets;
+	vector<Ptr<CommandDefinition>> buttons;
+	vector<Ptr<CommandControl>> commandControls;
+	vector<unique_ptr<CommandCreatedEventHandler>> commandCreatedEvents;
+
+	bool addCommand(const string& id, const string& name, const string& tooltip, CommandCreatedEventHandler* commandCreatedEvent);
+};
@@ -0,0 +1,384 @@
+// Headless batch generator: reads joint spec files and writes each joint's layout and validation report, mesh and
+// plate DXF without Fusion, spreading the joints over all cores.
+
+#include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#ifdef _WIN32
+#include <direct.h>
+#endif
+
+#include "ArmatureJoint/ArmatureFile.h"
+#include "ArmatureJoint/Clamping.h"
+#include "ArmatureJoint/JointSpec.h"
+#include "ArmatureJoint/Layout.h"
+#include "ArmatureJoint/Mesh.h"
+#include "ArmatureJoint/Motion.h"
+#include "ArmatureJoint/MeshWriter.h"
+#include "ArmatureJoint/Parallel.h"
+#include "ArmatureJoint/PlateDxf.h"
+#include "ArmatureJoint/Presets.h"
+#include "ArmatureJoint/Validator.h"
+
+using namespace ArmatureJoint;
+
+namespace {
+	struct Options {
+		std::vector<std::string> specFiles;
+		std::string out;
+		std::string presets;
+		std::vector<std::string> convert;
+		std::vector<std::string> diff;
+		std::string mesh;
+		bool dxf;
+		double tolerance;
+		ClampingSpec clamping;
+		int jobs;
+
+		Options() : out("."), mesh("stl"), dxf(true), tolerance((0.01_mm).centimetres()), clamping(ClampingSpec::defaults()), jobs(0) {}
+	};
+
+	struct Job {
+		JointSpec spec;
+		std::string file;
+		bool valid;
+		std::string error;
+		size_t triangles;
+	};
+
+	double mm(double centimetres) {
+		return Length::fromCentimetres(centimetres).millimetres();
+	}
+
+	void usage() {
+		fprintf(stderr,
+			"usage: armature-joint [options] SPEC...\n"
+			"       armature-joint --presets FILE\n"
+			"       armature-joint --convert IN OUT\n"
+			"       armature-joint --diff OLD NEW\n"
+			"\n"
+			"Generates every joint in the given armature, JSON or CSV joint spec files, or\n"
+			"writes the preset library the add-in loads from Resources/presets.bin.\n"
+			"\n"
+			"  -o, --out DIR        write into DIR (default .)\n"
+			"  -m, --mesh FORMAT    stl, 3mf or none (default stl)\n"
+			"      --no-dxf         skip the plate DXFs\n"
+			"  -t, --tolerance MM   chord tolerance for meshes (default 0.01)\n"
+			"  -j, --jobs N         worker threads (default all cores)\n"
+			"      --bolt-torque NM bolt tightening torque for the holding torques in the\n"
+			"                       report (default 0.5)\n"
+			"      --friction MU    ball to seat friction coefficient (default 0.3)\n"
+			"      --presets FILE   write the standard preset library to FILE\n"
+			"      --convert IN OUT convert between .armature, .json and .csv spec files\n"
+			"      --diff OLD NEW   list joints added, removed, resized or moved between\n"
+			"                       two .armature files; exits 1 when they differ\n"
+		);
+	}
+
+	bool parse(int argc, char** argv, Options& options) {
+		for (auto i = 1; i < argc; i++) {
+			std::string arg = argv[i];
+			auto value = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+
+			if (arg == "-h" || arg == "--help") {
+				return false;
+			}
+			else if (arg == "-o" || arg == "--out") {
+				auto v = value();
+				if (!v)
+					return false;
+				options.out = v;
+			}
+			else if (arg == "-m" || arg == "--mesh") {
+				auto v = value();
+				if (!v)
+					return false;
+				options.mesh = v;
+				if (options.mesh != "stl" && options.mesh != "3mf" && options.mesh != "none")
+					return false;
+			}
+			else if (arg == "--presets") {
+				auto v = value();
+				if (!v)
+					return false;
+				options.presets = v;
+			}
+			else if (arg == "--convert" || arg == "--diff") {
+				auto& files = arg == "--convert" ? options.convert : options.diff;
+				auto from = value();
+				auto to = value();
+				if (!from || !to)
+					return false;
+				files = { from, to };
+			}
+			else if (arg == "--no-dxf") {
+				options.dxf = false;
+			}
+			else if (arg == "-t" || arg == "--tolerance") {
+				auto v = value();
+				if (!v || atof(v) <= 0)
+					return false;
+				options.tolerance = Length::fromMillimetres(atof(v)).centimetres();
+			}
+			else if (arg == "--bolt-torque" || arg == "--friction") {
+				auto v = value();
+				if (!v || atof(v) <= 0)
+					return false;
+				(arg == "--bolt-torque" ? options.clamping.boltTorque : options.clamping.friction) = atof(v);
+			}
+			else if (arg == "-j" || arg == "--jobs") {
+				auto v = value();
+				if (!v || atoi(v) < 1)
+					return false;
+				options.jobs = atoi(v);
+			}
+			else if (!arg.empty() && arg[0] == '-') {
+				return false;
+			}
+			else {
+				options.specFiles.push_back(arg);
+			}
+		}
+
+		return !options.specFiles.empty() || !options.presets.empty() || !options.convert.empty() || !options.diff.empty();
+	}
+
+	bool makeDirectory(const std::string& path) {
+#ifdef _WIN32
+		auto result = _mkdir(path.c_str());
+#else
+		auto result = mkdir(path.c_str(), 0777);
+#endif
+		return result == 0 || errno == EEXIST;
+	}
+
+	// Joint names made safe for file names, numbered when several joints share one.
+	std::vector<std::string> fileNames(const std::vector<Job>& jobs) {
+		std::vector<std::string> names;
+		std::map<std::string, int> seen;
+
+		for (auto& job : jobs) {
+			auto name = job.spec.name.empty() ? std::string("Joint") : job.spec.name;
+			for (auto& c : name) {
+				if (!isalnum((unsigned char)c) && c != '-' && c != '_' && c != '.')
+					c = '_';
+			}
+
+			auto count = ++seen[name];
+			names.push_back(count == 1 ? name : name + "-" + std::to_string(count));
+		}
+
+		return names;
+	}
+
+	void generate(Job& job, const std::string& base, const Options& options) {
+		Layout layout(job.spec);
+
+		job.triangles = 0;
+		job.valid = Validator::validate(layout, job.error);
+		if (!job.valid)
+			return;
+
+		if (options.mesh != "none") {
+			auto writer = MeshWriter::create(base + "." + options.mesh);
+			if (!writer) {
+				job.error = "could not write " + base + "." + options.mesh;
+				return;
+			}
+
+			auto written = true;
+			for (auto& mesh : Mesher::joint(layout, options.tolerance))
+				written = written && writer->add(mesh, Transform());
+
+			if (!written || !writer->close()) {
+				job.error = "could not write " + base + "." + options.mesh;
+				return;
+			}
+
+			job.triangles = (size_t)writer->triangles();
+		}
+
+		if (options.dxf) {
+			auto dxf = PlateDxf::create(base + ".dxf");
+			if (!dxf || !dxf->add(layout, false, 0, 0) || !dxf->add(layout, true, PlateDxf::width(layout) + 5, 0) || !dxf->close())
+				job.error = "could not write " + base + ".dxf";
+		}
+	}
+
+	std::string csvField(const std::string& value) {
+		if (value.find_first_of(",\"\n") == std::string::npos)
+			return value;
+
+		std::string quoted = "\"";
+		for (auto c : value) {
+			if (c == '"')
+				quoted += '"';
+			quoted += c;
+		}
+		return quoted + "\"";
+	}
+
+	// Holding torques are per ball, in newton millimetres, and the swing is the smallest cone any ball's shaft has, in degrees.
+	bool writeReport(const std::string& path, const std::vector<Job>& jobs, const Options& options) {
+		auto file = fopen(path.c_str(), "w");
+		if (!file)
+			return false;
+
+		std::vector<JointSpec> specs;
+		for (auto& job : jobs)
+			specs.push_back(job.spec);
+
+		auto clamping = Clamping::evaluate(specs, options.clamping, options.jobs);
+		auto motions = Motion::analyse(specs, options.jobs);
+
+		fprintf(file, "name,file,valid,error,length,width,thickness,ballDiameter,boltHoleDiameter,rows,cols,ballOffset,plateOffset,circleRadius,chamferLength,triangles,preload,tiltTorque,twistTorque,boltStiffness,swing\n");
+		for (size_t i = 0; i < jobs.size(); i++) {
+			auto& job = jobs[i];
+			auto& holding = clamping[i];
+			Layout layout(job.spec);
+			fprintf(file, "%s,%s,%s,%s,%.4f,%.4f,%.4f,%.4f,%.4f,%d,%d,%.4f,%.4f,%.4f,%.4f,%zu,%.4g,%.4g,%.4g,%.4g,%.1f\n",
+				csvField(job.spec.name).c_str(),
+				csvField(job.file).c_str(),
+				job.valid ? "yes" : "no",
+				csvField(job.error).c_str(),
+				mm(layout.length()),
+				mm(layout.width()),
+				mm(layout.thickness()),
+				mm(layout.ballDiameter()),
+				mm(layout.boltHoleDiameter()),
+				layout.rows(),
+				layout.cols(),
+				job.valid ? mm(layout.ballOffset()) : 0,
+				job.valid ? mm(layout.plateOffset()) : 0,
+				job.valid ? mm(layout.circleRadius()) : 0,
+				job.valid ? mm(layout.chamferLength()) : 0,
+				job.triangles,
+				job.valid ? holding.preload : 0,
+				job.valid ? holding.tiltTorque * 1000 : 0,
+				job.valid ? holding.twistTorque * 1000 : 0,
+				job.valid ? holding.boltStiffness : 0,
+				job.valid ? Angle::fromRadians(Motion::smallestCone(motions[i])).degrees() : 0
+			);
+		}
+
+		return fclose(file) == 0;
+	}
+}
+
+int main(int argc, char** argv) {
+	Options options;
+	if (!parse(argc, argv, options)) {
+		usage();
+		return 2;
+	}
+
+	if (!options.convert.empty()) {
+		std::vector<JointSpec> specs;
+		std::string error;
+		if (!JointSpecFile::read(options.convert[0], JointSpec::defaults(), JointCell::defaults(), specs, error)) {
+			fprintf(stderr, "%s: %s\n", options.convert[0].c_str(), error.c_str());
+			return 2;
+		}
+
+		if (!JointSpecFile::write(options.convert[1], specs, error)) {
+			fprintf(stderr, "%s: %s\n", options.convert[1].c_str(), error.c_str());
+			return 2;
+		}
+
+		printf("Wrote %zu joints to %s.\n", specs.size(), options.convert[1].c_str());
+		return 0;
+	}
+
+	if (!options.diff.empty()) {
+		std::shared_ptr<ArmatureFile> files[2];
+		for (auto i = 0; i < 2; i++) {
+			files[i] = ArmatureFile::open(options.diff[i]);
+			if (!files[i]) {
+				fprintf(stderr, "%s: not an armature file\n", options.diff[i].c_str());
+				return 2;
+			}
+		}
+
+		static const char* const kinds[] = { "added", "removed", "resized", "moved" };
+		auto changes = ArmatureFile::diff(*files[0], *files[1]);
+		for (auto& change : changes)
+			printf("%-8s %s\n", kinds[change.kind], change.name.c_str());
+
+		return changes.empty() ? 0 : 1;
+	}
+
+	if (!options.presets.empty()) {
+		auto start = std::chrono::steady_clock::now();
+		auto specs = PresetLibrary::catalogue(options.jobs);
+
+		std::string error;
+		if (!PresetLibrary::write(options.presets, specs, error, options.jobs)) {
+			fprintf(stderr, "%s\n", error.c_str());
+			return 2;
+		}
+
+		auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		printf("Wrote %zu presets to %s in %.2f s.\n", specs.size(), options.presets.c_str(), seconds);
+
+		if (options.specFiles.empty())
+			return 0;
+	}
+
+	std::vector<Job> jobs;
+	for (auto& path : options.specFiles) {
+		std::vector<JointSpec> specs;
+		std::string error;
+		if (!JointSpecFile::read(path, JointSpec::defaults(), JointCell::defaults(), specs, error)) {
+			fprintf(stderr, "%s: %s\n", path.c_str(), error.c_str());
+			return 2;
+		}
+
+		for (auto& spec : specs) {
+			Job job;
+			job.spec = spec;
+			job.valid = false;
+			job.triangles = 0;
+			jobs.push_back(job);
+		}
+	}
+
+	if (!makeDirectory(options.out)) {
+		fprintf(stderr, "%s: %s\n", options.out.c_str(), strerror(errno));
+		return 2;
+	}
+
+	auto names = fileNames(jobs);
+	for (size_t i = 0; i < jobs.size(); i++)
+		jobs[i].file = names[i];
+
+	auto start = std::chrono::steady_clock::now();
+	Parallel::forEach(jobs.size(), [&](size_t item, int) {
+		generate(jobs[item], options.out + "/" + jobs[item].file, options);
+	}, options.jobs);
+	auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	size_t failed = 0;
+	for (auto& job : jobs) {
+		if (!job.error.empty()) {
+			fprintf(stderr, "%s: %s\n", job.spec.name.c_str(), job.error.c_str());
+			failed++;
+		}
+	}
+
+	if (!writeReport(options.out + "/report.csv", jobs, options)) {
+		fprintf(stderr, "%s/report.csv: %s\n", options.out.c_str(), strerror(errno));
+		return 2;
+	}
+
+	printf("Generated %zu of %zu joints in %.2f s on %d workers.\n", jobs.size() - failed, jobs.size(), seconds, Parallel::workers(options.jobs));
+
+	return failed > 0 ? 1 : 0;
+}